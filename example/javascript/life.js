@@ -128,16 +128,21 @@ const DemoApp = new Lang.Class({
 
     draw: function() {
         this.update_state();
+        // the changed cells are drawn with one call instead of one per pixel
+        let points = [];
+        let colors = [];
         for (let x = 0; x < this.width; x++) {
             let new_row = this.new_state[x];
             let old_row = this.old_state[x];
             for (let y = 0; y < this.height; y++) {
                 let new_state = new_row[y];
                 if (old_row[y] != new_state) {
-                    Grx.fast_draw_pixel(x, y, this.color[new_state]);
+                    points.push(new Grx.Point({ x: x, y: y }));
+                    colors.push(this.color[new_state]);
                 }
             }
         }
+        Grx.draw_pixels(points, colors);
 
         [this.old_state, this.new_state] = [this.new_state, this.old_state];
 
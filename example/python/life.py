@@ -24,6 +24,7 @@ from gi.repository import GLib
 gi.require_version('Grx', '3.0')
 from gi.repository import Grx
 
+from array import array
 from random import random
 
 #
@@ -43,6 +44,7 @@ class Life(Grx.Application):
         self.old_state = [[0 for y in range(self.height)] for x in range(self.width)]
         self.new_state = [[0 for y in range(self.height)] for x in range(self.width)]
         self.color = (Grx.color_get_black(), Grx.color_get_white())
+        self.display_list = Grx.DisplayList.new()
         self.connect("notify::is-active", self.on_notify_is_active)
 
     def on_notify_is_active(self, obj, gparamstring):
@@ -112,12 +114,21 @@ class Life(Grx.Application):
 
     def _draw(self):
         self._update_state()
+
+        # the changed cells are drawn with one call instead of one per pixel
+        points = array('i')
+        colors = array('I')
         for x in range(self.width):
             new_row = self.new_state[x]
             old_row = self.old_state[x]
             for y in range(self.height):
                 if old_row[y] != new_row[y]:
-                    Grx.fast_draw_pixel(x, y, self.color[new_row[y]])
+                    points.extend((x, y))
+                    colors.append(self.color[new_row[y]])
+        self.display_list.add_pixels(GLib.Bytes.new(points.tobytes()),
+                                     GLib.Bytes.new(colors.tobytes()), 0)
+        self.display_list.replay(None)
+        self.display_list.clear()
 
         self.old_state, self.new_state = self.new_state, self.old_state
 
@@ -68,6 +68,7 @@ _GrFrameDriverRAM24,                    /* 16M color */
 _GrFrameDriverRAM32L,                   /* 16M color padded #1 */
 _GrFrameDriverRAM32H,                   /* 16M color padded #2 */
 _GrFrameDriverRAM3x8,                   /* 16M color planar (image mode) */
+_GrFrameDriverRAM32A,                   /* 16M color with alpha, premultiplied */
 /*
  * This is a NULL-terminated table of frame driver descriptor pointers. Users
  * can provide their own table with only the desired (or additional) drivers.
@@ -88,6 +89,8 @@ typedef GrxColor *(*_GR_getIndexedScanline)(GrxFrame *c,int x,int y,
                                                int w, int *indx);
 typedef void     (*_GR_putScanline)(int x,int y,int w,
                                     const GrxColor *scl,GrxColor op);
+typedef void     (*_GR_blendSpan)(int x,int y,int w,
+                                  const unsigned char *alpha,GrxColor c);
 
 /*
  * Frame driver utility functions
@@ -105,11 +108,48 @@ G_GNUC_INTERNAL void _GrFrDrvGenericPutScanline(int x,int y,int w,const GrxColor
 G_GNUC_INTERNAL GrxColor *_GrFrDrvGenericGetIndexedScanline(GrxFrame *c,
                                            int x,int y,int w,
                                            int *indx         );
+G_GNUC_INTERNAL void _GrFrDrvGenericBlendSpan(int x,int y,int w,
+                                              const unsigned char *alpha,
+                                              GrxColor c);
+
+G_GNUC_INTERNAL void _GrFrDrvBlendBitBlt(GrxFrame *dst,int dx,int dy,GrxFrame *src,int x,int y,int w,int h,GrxColor op);
 
 G_GNUC_INTERNAL void _GrFrDrvGenericStretchBlt(GrxFrame *dst,int dx,int dy,int dw,int dh,
                                GrxFrame *src,int sx,int sy,int sw,int sh,
                                GrxColor op);
 
+/*
+ * Screen damage tracking, for video drivers that have to copy the frame
+ * buffer somewhere to show it. The library collects the areas drawn to and
+ * calls the 'damaged' function of the video mode when the screen goes from
+ * clean to dirty. The driver then calls _GrDamageTake() (usually later, from
+ * its main loop) to get the areas to update. Overlapping areas are merged
+ * and when there are too many, the ones that grow the least are combined.
+ */
+#define GRX_DAMAGE_MAX_RECTS    8
+
+typedef struct {
+    int x1, y1, x2, y2;                 /* inclusive, in screen coordinates */
+} _GR_damageRect;
+
+int _GrDamageTake(_GR_damageRect *rects);
+
+/*
+ * Video drivers call this when the display shows what was drawn so far, for
+ * the input to display latency measurements (see grx_latency_set_enabled()).
+ */
+void _GrLatencyPresented(void);
+
+/*
+ * With a composited mouse cursor (see grx_mouse_set_cursor_composited()), the
+ * cursor is not kept in the screen frame. Video drivers that track damage
+ * call _GrMouseCompositeBegin() before copying the frame to the display and
+ * _GrMouseCompositeEnd() right after, which draw the cursor into the frame
+ * and take it out again. Both do nothing if the cursor is not composited.
+ */
+void _GrMouseCompositeBegin(void);
+void _GrMouseCompositeEnd(void);
+
 /*
  * Commonly used video driver data structures
  */
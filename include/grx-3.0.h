@@ -25,6 +25,7 @@
 #include <grx/context.h>
 #include <grx/device.h>
 #include <grx/device_manager.h>
+#include <grx/display_list.h>
 #include <grx/draw.h>
 #include <grx/draw_nc.h>
 #include <grx/error.h>
@@ -37,6 +38,7 @@
 #include <grx/mouse.h>
 #include <grx/pixmap.h>
 #include <grx/text.h>
+#include <grx/tiles.h>
 #include <grx/user.h>
 #include <grx/utils.h>
 #include <grx/wideline.h>
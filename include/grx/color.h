@@ -62,6 +62,10 @@ typedef guint32 GrxColor;
  * @GRX_COLOR_MODE_AND: AND this color with the existing color
  * @GRX_COLOR_MODE_IMAGE: Overwrite existing color unless this color is #GRX_COLOR_NONE.
  *                        Only works with bitblt operations.
+ * @GRX_COLOR_MODE_BLEND: Composite the source over the existing colors using
+ *                        the alpha channel of a #GRX_FRAME_MODE_RAM_32BPP_ARGB
+ *                        source. Only works with bitblt operations and pixmap
+ *                        fills, other sources have no alpha and are written.
  *
  * Values added to a #GrxColor to affect how the color is used in drawing
  * operations.
@@ -72,6 +76,7 @@ typedef enum {
     GRX_COLOR_MODE_OR    = 0x02000000UL,
     GRX_COLOR_MODE_AND   = 0x03000000UL,
     GRX_COLOR_MODE_IMAGE = 0x04000000UL,
+    GRX_COLOR_MODE_BLEND = 0x08000000UL,
 } GrxColorMode;
 
 /**
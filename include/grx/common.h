@@ -7,6 +7,8 @@ typedef struct _GrxContext          GrxContext;
 /* draw.h */
 typedef struct _GrxFramedBoxColors  GrxFramedBoxColors;
 typedef struct _GrxPoint            GrxPoint;
+/* display_list.h */
+typedef struct _GrxDisplayList      GrxDisplayList;
 /* device_manager.h */
 typedef struct _GrxDeviceManager    GrxDeviceManager;
 /* events.h */
@@ -18,6 +20,8 @@ typedef struct _GrxVideoMode        GrxVideoMode;
 typedef struct _GrxVideoModeExt     GrxVideoModeExt;
 /* pixmap.h */
 typedef struct _GrxPixmap           GrxPixmap;
+/* tiles.h */
+typedef struct _GrxTileBatch        GrxTileBatch;
 /* wideline.h */
 typedef struct _GrxLineOptions      GrxLineOptions;
 
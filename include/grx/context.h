@@ -137,6 +137,7 @@ GrxColor grx_context_get_pixel_at(GrxContext *context, gint x, gint y);
 void grx_context_bit_blt(GrxContext *context, gint x, gint y, GrxContext *src, gint x1, gint y1, gint x2, gint y2, GrxColor op);
 void grx_context_bit_blt_1bpp(GrxContext *context, gint x, gint y, GrxContext *src, gint x1, gint y1, gint x2, gint y2, GrxColor fg, GrxColor bg);
 const GrxColor *grx_context_get_scanline(GrxContext *context, gint x1, gint x2, gint y, guint *n);
+void grx_context_mark_dirty(GrxContext *context, gint x1, gint y1, gint x2, gint y2);
 
 void grx_context_set_clip_box(GrxContext *context, gint x1, gint y1, gint x2, gint y2);
 void grx_context_get_clip_box(const GrxContext *context, gint *x1, gint *y1, gint *x2, gint *y2);
@@ -0,0 +1,70 @@
+/*
+ * display_list.h
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef __GRX_DISPLAY_LIST_H__
+#define __GRX_DISPLAY_LIST_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <grx/color.h>
+#include <grx/common.h>
+#include <grx/text.h>
+
+/**
+ * SECTION:display_list
+ * @short_description: Recording drawing commands and replaying them
+ * @title: Display Lists
+ * @section_id: display_list
+ * @include: grx-3.0.h
+ *
+ * A #GrxDisplayList keeps drawing commands in a compact buffer, so that a
+ * scene can be built once and drawn with a single call as often as needed.
+ *
+ * Besides single commands, pixels, lines and filled boxes can be added many
+ * at a time from packed arrays of coordinates and colors. This is the fast
+ * way to draw lots of small things from language bindings, where calling a
+ * function for every pixel costs much more than drawing it.
+ */
+
+GType grx_display_list_get_type(void);
+
+GrxDisplayList *grx_display_list_new(void);
+GrxDisplayList *grx_display_list_ref(GrxDisplayList *list);
+void grx_display_list_unref(GrxDisplayList *list);
+void grx_display_list_clear(GrxDisplayList *list);
+guint grx_display_list_get_length(GrxDisplayList *list);
+
+void grx_display_list_draw_pixel(GrxDisplayList *list, gint x, gint y, GrxColor c);
+void grx_display_list_draw_line(GrxDisplayList *list, gint x1, gint y1, gint x2, gint y2, GrxColor c);
+void grx_display_list_draw_box(GrxDisplayList *list, gint x1, gint y1, gint x2, gint y2, GrxColor c);
+void grx_display_list_draw_filled_box(GrxDisplayList *list, gint x1, gint y1, gint x2, gint y2, GrxColor c);
+void grx_display_list_draw_polyline(GrxDisplayList *list, gint n_points, GrxPoint *points, GrxColor c);
+void grx_display_list_draw_polygon(GrxDisplayList *list, gint n_points, GrxPoint *points, GrxColor c);
+void grx_display_list_draw_filled_polygon(GrxDisplayList *list, gint n_points, GrxPoint *points, GrxColor c);
+void grx_display_list_draw_ellipse(GrxDisplayList *list, gint xc, gint yc, gint rx, gint ry, GrxColor c);
+void grx_display_list_draw_filled_ellipse(GrxDisplayList *list, gint xc, gint yc, gint rx, gint ry, GrxColor c);
+void grx_display_list_draw_text(GrxDisplayList *list, const gchar *text, gint x, gint y, GrxTextOptions *options);
+void grx_display_list_bit_blt(GrxDisplayList *list, gint x, gint y, GrxContext *src,
+                              gint x1, gint y1, gint x2, gint y2, GrxColor op);
+
+void grx_display_list_add_pixels(GrxDisplayList *list, GBytes *points, GBytes *colors, GrxColor c);
+void grx_display_list_add_lines(GrxDisplayList *list, GBytes *points, GBytes *colors, GrxColor c);
+void grx_display_list_add_filled_boxes(GrxDisplayList *list, GBytes *points, GBytes *colors, GrxColor c);
+
+void grx_display_list_replay(GrxDisplayList *list, GrxContext *context);
+
+#endif /* __GRX_DISPLAY_LIST_H__ */
@@ -32,7 +32,9 @@
  * @section_id: draw
  * @include: grx-3.0.h
  *
- * These functions operate on the current context.
+ * These functions operate on the current context. The grx_context_draw_*()
+ * functions take the context to draw on instead and can also be used from
+ * other threads, e.g. to draw to off-screen contexts in parallel.
  */
 
 /**
@@ -122,6 +124,10 @@ void grx_draw_filled_ellipse_arc(gint xc, gint yc, gint rx, gint ry, gint start,
 void grx_draw_filled_polygon(gint n_points, GrxPoint *points, GrxColor c);
 void grx_draw_filled_convex_polygon(gint n_points, GrxPoint *points, GrxColor c);
 
+void grx_draw_pixels(gint n_points, const GrxPoint *points, gint n_colors, const GrxColor *colors);
+void grx_draw_lines(gint n_points, const GrxPoint *points, gint n_colors, const GrxColor *colors);
+void grx_draw_filled_boxes(gint n_points, const GrxPoint *points, gint n_colors, const GrxColor *colors);
+
 void grx_flood_fill(gint x, gint y, GrxColor border, GrxColor c);
 void grx_flood_spill(gint x1, gint y1, gint x2, gint y2, GrxColor old_c, GrxColor new_c);
 void grx_flood_spill2(gint x1, gint y1, gint x2, gint y2, GrxColor old_c1, GrxColor new_c1, GrxColor old_c2, GrxColor new_c2);
@@ -134,6 +140,17 @@ void grx_bit_blt_1bpp(gint x, gint y, GrxContext *src, gint x1, gint y1, gint x2
 const GrxColor *grx_get_scanline(gint x1, gint x2, gint y, guint *n);
 void grx_put_scanline(gint x1, gint x2, gint y, const GrxColor *scan_line, GrxColor op);
 
+void grx_context_draw_pixel(GrxContext *context, gint x, gint y, GrxColor c);
+void grx_context_draw_line(GrxContext *context, gint x1, gint y1, gint x2, gint y2, GrxColor c);
+void grx_context_draw_box(GrxContext *context, gint x1, gint y1, gint x2, gint y2, GrxColor c);
+void grx_context_draw_filled_box(GrxContext *context, gint x1, gint y1, gint x2, gint y2, GrxColor c);
+void grx_context_draw_polyline(GrxContext *context, gint n_points, GrxPoint *points, GrxColor c);
+void grx_context_draw_polygon(GrxContext *context, gint n_points, GrxPoint *points, GrxColor c);
+void grx_context_draw_filled_polygon(GrxContext *context, gint n_points, GrxPoint *points, GrxColor c);
+void grx_context_draw_ellipse(GrxContext *context, gint xc, gint yc, gint rx, gint ry, GrxColor c);
+void grx_context_draw_filled_ellipse(GrxContext *context, gint xc, gint yc, gint rx, gint ry, GrxColor c);
+void grx_context_put_scanline(GrxContext *context, gint x1, gint x2, gint y, const GrxColor *scan_line, GrxColor op);
+
 #ifndef GRX_SKIP_INLINES
 #define grx_bit_blt(x,y,s,x1,x2,y1,y2,o) \
     grx_context_bit_blt(NULL,(x),(y),(s),(x1),(x2),(y1),(y2),(o))
@@ -103,6 +103,7 @@ typedef enum {
  * @code: the platform dependent raw key code
  * @modifiers: modifier key flags
  * @device: the originating device
+ * @time: when the event happened, see grx_event_get_time()
  *
  * Structure that holds information about a keyboard key event.
  */
@@ -113,6 +114,7 @@ typedef struct {
     guint32 code;
     GrxModifierFlags modifiers;
     GrxDevice *device;
+    gint64 time;
 } GrxKeyEvent;
 
 /**
@@ -122,6 +124,7 @@ typedef struct {
  * @y: the pointer position along the y axis
  * @modifiers: modifier key flags
  * @device: the originating device
+ * @time: when the event happened, see grx_event_get_time()
  *
  * Structure that holds information about a pointer motion event.
  */
@@ -131,6 +134,7 @@ typedef struct {
     gint32 y;
     GrxModifierFlags modifiers;
     GrxDevice *device;
+    gint64 time;
 } GrxMotionEvent;
 
 /**
@@ -142,6 +146,7 @@ typedef struct {
  * @y: the pointer position along the y axis
  * @modifiers: modifier key flags
  * @device: the originating device
+ * @time: when the event happened, see grx_event_get_time()
  *
  * Structure that holds information about a pointer button press event.
  */
@@ -152,6 +157,7 @@ typedef struct {
     gint32 y;
     GrxModifierFlags modifiers;
     GrxDevice *device;
+    gint64 time;
 } GrxButtonEvent;
 
 /**
@@ -163,6 +169,7 @@ typedef struct {
  * @y: the Y coordinate of the touch event
  * @modifiers: modifier key flags
  * @device: the originating device
+ * @time: when the event happened, see grx_event_get_time()
  *
  * Structure that holds information about a touch event.
  */
@@ -173,6 +180,7 @@ typedef struct {
     gint32 y;
     GrxModifierFlags modifiers;
     GrxDevice *device;
+    gint64 time;
 } GrxTouchEvent;
 
 /**
@@ -213,6 +221,7 @@ gunichar grx_event_get_keychar (GrxEvent *event);
 guint32 grx_event_get_keycode (GrxEvent *event);
 void grx_event_get_coords (GrxEvent *event, gint *x, gint *y);
 guint32 grx_event_get_button (GrxEvent *event);
+gint64 grx_event_get_time (GrxEvent *event);
 
 /**
  * GrxEventHandlerFunc:
@@ -227,4 +236,69 @@ GSource *grx_event_handler_source_new (void);
 guint grx_event_handler_add (GrxEventHandlerFunc callback, gpointer user_data,
                              GDestroyNotify notify);
 
+/**
+ * GrxEventBatchHandlerFunc:
+ * @events: (array length=n_events): the events, oldest first
+ * @n_events: the number of events
+ * @user_data: data passed to the function, set when the source was created
+ *
+ * Specifies the type of function passed to grx_event_batch_handler_add().
+ * The events are only valid until the function returns.
+ */
+typedef void (*GrxEventBatchHandlerFunc)(GrxEvent *events, guint n_events,
+                                         gpointer user_data);
+
+GSource *grx_event_batch_handler_source_new (void);
+guint grx_event_batch_handler_add (GrxEventBatchHandlerFunc callback,
+                                   gpointer user_data, GDestroyNotify notify);
+
+void grx_event_set_dispatch_budget (guint max_events);
+guint grx_event_get_dispatch_budget (void);
+
+/**
+ * GrxLatencyType:
+ * @GRX_LATENCY_TYPE_QUEUE: time from adding an event to the queue until it
+ * is taken from the queue
+ * @GRX_LATENCY_TYPE_PRESENT: time from the oldest input event handled since
+ * the last update of the display until the display is updated
+ *
+ * The latencies that are measured when grx_latency_set_enabled() is on.
+ */
+typedef enum {
+    GRX_LATENCY_TYPE_QUEUE,
+    GRX_LATENCY_TYPE_PRESENT,
+} GrxLatencyType;
+
+/**
+ * GRX_LATENCY_N_BUCKETS:
+ *
+ * The number of buckets in a #GrxLatencyStats histogram.
+ */
+#define GRX_LATENCY_N_BUCKETS 16
+
+/**
+ * GrxLatencyStats:
+ * @count: the number of samples
+ * @min: the shortest latency in microseconds
+ * @max: the longest latency in microseconds
+ * @total: the sum of all latencies in microseconds
+ * @buckets: histogram of the samples, bucket i counts the latencies shorter
+ * than 2^(i + 6) microseconds (64 us, 128 us, ...) that did not fit in a
+ * lower bucket and the last bucket counts all the rest
+ *
+ * Latency measurements, see grx_latency_get_stats().
+ */
+typedef struct {
+    guint64 count;
+    gint64 min;
+    gint64 max;
+    gint64 total;
+    guint64 buckets[GRX_LATENCY_N_BUCKETS];
+} GrxLatencyStats;
+
+void grx_latency_set_enabled (gboolean enabled);
+gboolean grx_latency_get_enabled (void);
+void grx_latency_get_stats (GrxLatencyType type, GrxLatencyStats *stats);
+void grx_latency_reset (void);
+
 #endif /* __GRX_EVENT_H__ */
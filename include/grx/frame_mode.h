@@ -51,6 +51,8 @@
  * @GRX_FRAME_MODE_RAM_32BPP_LOW: RAM frame buffer, 32bpp, 16M color using lower 24 bits
  * @GRX_FRAME_MODE_RAM_32BPP_HIGH: RAM frame buffer, 32bpp, 16M color using upper 24 bits
  * @GRX_FRAME_MODE_RAM_3X8BPP: RAM frame buffer, 3x8bpp, 16M color in 3 planes
+ * @GRX_FRAME_MODE_RAM_32BPP_ARGB: RAM frame buffer, 32bpp, 16M color with an
+ *     8 bit alpha channel in the upper bits, premultiplied
  * @GRX_FRAME_MODE_FIRST_TEXT: The first text mode
  * @GRX_FRAME_MODE_LAST_TEXT: The last text mode
  * @GRX_FRAME_MODE_FIRST_GRAPHICS: The first graphics mode
@@ -82,13 +84,14 @@ typedef enum {
     GRX_FRAME_MODE_RAM_32BPP_LOW,       /* 16M color padded #1 */
     GRX_FRAME_MODE_RAM_32BPP_HIGH,      /* 16M color padded #2 */
     GRX_FRAME_MODE_RAM_3X8BPP,          /* 16M color planar (image mode) */
+    GRX_FRAME_MODE_RAM_32BPP_ARGB,      /* 16M color with alpha, premultiplied */
     /* ====== markers for scanning modes ====== */
     GRX_FRAME_MODE_FIRST_TEXT     = GRX_FRAME_MODE_TEXT,
     GRX_FRAME_MODE_LAST_TEXT      = GRX_FRAME_MODE_TEXT,
     GRX_FRAME_MODE_FIRST_GRAPHICS = GRX_FRAME_MODE_LFB_MONO01,
     GRX_FRAME_MODE_LAST_GRAPHICS  = GRX_FRAME_MODE_LFB_32BPP_HIGH,
     GRX_FRAME_MODE_FIRST_RAM      = GRX_FRAME_MODE_RAM_1BPP,
-    GRX_FRAME_MODE_LAST_RAM       = GRX_FRAME_MODE_RAM_3X8BPP
+    GRX_FRAME_MODE_LAST_RAM       = GRX_FRAME_MODE_RAM_32BPP_ARGB
 } GrxFrameMode;
 
 GrxFrameMode grx_frame_mode_get_current(void);
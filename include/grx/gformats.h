@@ -57,6 +57,23 @@ typedef enum {
     GRX_PNM_FORMAT_BINARY_PPM = 6,
 } GrxPnmFormat;
 
+/**
+ * GrxImageDither:
+ * @GRX_IMAGE_DITHER_NONE: each pixel gets the nearest color
+ * @GRX_IMAGE_DITHER_ORDERED: ordered dithering with an 8x8 Bayer matrix
+ * @GRX_IMAGE_DITHER_FLOYD_STEINBERG: Floyd-Steinberg error diffusion
+ *
+ * How images are loaded into contexts with 256 colors or less.
+ */
+typedef enum {
+    GRX_IMAGE_DITHER_NONE,
+    GRX_IMAGE_DITHER_ORDERED,
+    GRX_IMAGE_DITHER_FLOYD_STEINBERG,
+} GrxImageDither;
+
+void grx_set_image_dither(GrxImageDither dither);
+GrxImageDither grx_get_image_dither(void);
+
 /* The PNM functions */
 
 gboolean grx_context_save_to_pbm(GrxContext *context, const gchar *filename, const gchar *comment, GError **error);
@@ -69,6 +86,8 @@ gboolean grx_query_pnm_data(GByteArray *data, GrxPnmFormat *format, gint *width,
 
 gboolean grx_context_save_to_png(GrxContext *context, const gchar *filename, GError **error);
 gboolean grx_context_load_from_png(GrxContext *context, const gchar *filename, gboolean use_alpha, GError **error);
+gboolean grx_context_load_from_png_at(GrxContext *context, const gchar *filename, gint x, gint y,
+                                      gboolean use_alpha, GError **error);
 gboolean grx_query_png_file(const gchar *filename, gint *width, gint *height);
 
 gboolean grx_context_load_from_jpeg(GrxContext *context, const gchar *filename, gint scale, GError **error);
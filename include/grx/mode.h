@@ -234,6 +234,8 @@ struct _GrxVideoModeExt {
     void  (*set_rw_banks)(gint read_bank, gint write_bank);
     void  (*load_color)(GrxColor c, GrxColor r, GrxColor g, GrxColor b);
     gint    lfb_selector;
+    void  (*damaged)(void);             /* optional, enables damage tracking */
+    void  (*present)(void);             /* optional, show pending damage now */
 };
 
 /**
@@ -273,6 +275,11 @@ struct _GrxFrameDriver {
     void     (*putscanline)(gint x, gint y, gint w, const GrxColor *scl, GrxColor op);
       /* will draw scl[i=0..w-1] to frame:                           */
       /*    if (scl[i] != skipcolor) drawpixel(x+i,y,(scl[i] | op))  */
+    void     (*blendspan)(gint x, gint y, gint w, const guint8 *alpha, GrxColor c);
+      /* will blend color c into frame pixels x..x+w-1 by coverage:  */
+      /*    alpha[i] == 0:   leave pixel                             */
+      /*    alpha[i] == 255: drawpixel(x+i,y,c)                      */
+      /*    else mix c and the pixel in proportion to alpha[i]       */
 };
 
 #ifndef __GI_SCANNER__
@@ -312,6 +319,7 @@ extern const struct _GR_driverInfo {
 gboolean grx_set_driver(const gchar *driver_spec, GError **error);
 gboolean grx_set_mode(GrxGraphicsMode mode, GError **error, ...);
 gboolean grx_set_mode_default_graphics(gboolean clear, GError **error);
+void grx_present_screen(void);
 
 /*
  * inquiry stuff ---- many of these are actually macros (see below)
@@ -98,6 +98,7 @@ extern const struct _GR_mouseInfo {
     gulong device_added_handler;
     gulong device_removed_handler;
     guint  pointer_device_count;
+    gboolean composited;           /* cursor only drawn when presenting */
 } * const GrMouseInfo;
 
 #endif /* __GTK_DOC_IGNORE__ */
@@ -109,6 +110,7 @@ void grx_mouse_set_cursor_default(GrxColor fill_color, GrxColor border_color);
 void grx_mouse_set_cursor_mode(int mode, ...);
 void _grx_mouse_update_cursor(void);
 gboolean grx_mouse_is_cursor_shown(void);
+gboolean grx_mouse_set_cursor_composited(gboolean composited);
 
 guint grx_mouse_block(GrxContext *context, gint x1, gint y1, gint x2, gint y2);
 void grx_mouse_unblock(guint flags);
@@ -33,8 +33,9 @@
  * @section_id: text
  * @include: grx-3.0.h
  *
- * The library supports loadable fonts. When in memory they are bitmapped (i.e.
- * not scalable!) fonts.
+ * The library supports loadable fonts. Bitmap fonts are drawn as is. Scalable
+ * fonts (e.g. TrueType) are rendered by freetype at the requested size and are
+ * drawn anti-aliased, by blending the text color into the frame.
  *
  * Under the hood, it uses fontconfig and freetype2. This means than fontconfig
  * must be configured to allow using bitmap fonts, otherwise grx_font_load()
@@ -42,7 +43,8 @@
  * line tools to help find availble fonts. For example, `fc-list ":scalable=False"`
  * will list all bitmap fonts.
  *
- * To bypass fontconfig, use grx_font_load_from_file() instead.
+ * To bypass fontconfig, use grx_font_load_from_file() instead. Scalable fonts
+ * can be loaded this way using grx_font_load_from_file_full().
  */
 
 /**
@@ -123,6 +125,8 @@ typedef struct _GrxFont GrxFont;
 GType grx_font_get_type(void);
 
 GrxFont *grx_font_load_from_file(const gchar *filename, GError **err);
+GrxFont *grx_font_load_from_file_full(const gchar *filename, gint size, gint dpi,
+                                      GError **err);
 GrxFont *grx_font_load_full(const gchar *family, gint size, gint dpi, GrxFontWeight weight,
     GrxFontSlant slant, GrxFontWidth width, gboolean monospace, const gchar *lang,
     const gchar *script, GError **err);
@@ -152,6 +156,8 @@ gint grx_font_get_text_height(GrxFont *font, const gchar *text);
 typedef struct _GrxTextOptions GrxTextOptions;
 
 void grx_draw_text(const gchar *text, gint x, gint y, GrxTextOptions *options);
+void grx_context_draw_text(GrxContext *context, const gchar *text, gint x, gint y,
+                           GrxTextOptions *options);
 
 GType grx_text_options_get_type(void);
 GrxTextOptions *grx_text_options_new(GrxFont *font, GrxColor fg);
@@ -0,0 +1,59 @@
+/*
+ * tiles.h
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef __GRX_TILES_H__
+#define __GRX_TILES_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <grx/color.h>
+#include <grx/common.h>
+#include <grx/text.h>
+
+/**
+ * SECTION:tiles
+ * @short_description: Drawing large contexts on several threads
+ * @title: Tiled Rendering
+ * @section_id: tiles
+ * @include: grx-3.0.h
+ *
+ * A #GrxTileBatch records drawing commands for one context. When it is
+ * rendered, the context is cut into tiles and the tiles are drawn at the
+ * same time on worker threads, each one with only the commands that touch
+ * it. The result is the same as drawing the commands one after another.
+ */
+
+GType grx_tile_batch_get_type(void);
+
+GrxTileBatch *grx_tile_batch_new(GrxContext *context, gint tile_width);
+GrxTileBatch *grx_tile_batch_ref(GrxTileBatch *batch);
+void grx_tile_batch_unref(GrxTileBatch *batch);
+
+void grx_tile_batch_draw_pixel(GrxTileBatch *batch, gint x, gint y, GrxColor c);
+void grx_tile_batch_draw_line(GrxTileBatch *batch, gint x1, gint y1, gint x2, gint y2, GrxColor c);
+void grx_tile_batch_draw_box(GrxTileBatch *batch, gint x1, gint y1, gint x2, gint y2, GrxColor c);
+void grx_tile_batch_draw_filled_box(GrxTileBatch *batch, gint x1, gint y1, gint x2, gint y2, GrxColor c);
+void grx_tile_batch_draw_polyline(GrxTileBatch *batch, gint n_points, GrxPoint *points, GrxColor c);
+void grx_tile_batch_draw_polygon(GrxTileBatch *batch, gint n_points, GrxPoint *points, GrxColor c);
+void grx_tile_batch_draw_filled_polygon(GrxTileBatch *batch, gint n_points, GrxPoint *points, GrxColor c);
+void grx_tile_batch_draw_ellipse(GrxTileBatch *batch, gint xc, gint yc, gint rx, gint ry, GrxColor c);
+void grx_tile_batch_draw_filled_ellipse(GrxTileBatch *batch, gint xc, gint yc, gint rx, gint ry, GrxColor c);
+void grx_tile_batch_draw_text(GrxTileBatch *batch, const gchar *text, gint x, gint y, GrxTextOptions *options);
+
+void grx_tile_batch_render(GrxTileBatch *batch);
+
+#endif /* __GRX_TILES_H__ */
@@ -34,7 +34,9 @@
 #define ROWSTRIDE(w) (((w) * 3 + 3) & ~3)
 
 static gboolean gtk_init_ok = FALSE;
-static GtkWidget *image;
+static GtkWidget *drawing_area;
+static GdkPixbuf *frame_pixbuf;
+static guint flush_source_id;
 
 static gboolean detect(void)
 {
@@ -68,23 +70,83 @@ static gboolean setup_text_mode (GrxVideoMode *mode, gboolean noclear)
     return TRUE;
 }
 
+static gboolean flush_damage (gpointer user_data)
+{
+    _GR_damageRect rects[GRX_DAMAGE_MAX_RECTS];
+    gint i, n;
+
+    flush_source_id = 0;
+
+    n = _GrDamageTake (rects);
+    for (i = 0; i < n; i++) {
+        gtk_widget_queue_draw_area (drawing_area, rects[i].x1, rects[i].y1,
+                                    rects[i].x2 - rects[i].x1 + 1,
+                                    rects[i].y2 - rects[i].y1 + 1);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
+/*
+ * Called by the library when something is drawn on a clean screen. The
+ * damaged areas are collected until the main loop is idle, so that a whole
+ * batch of drawing operations results in one redraw.
+ */
+static void damaged (void)
+{
+    if (!flush_source_id) {
+        flush_source_id = g_idle_add (flush_damage, NULL);
+    }
+}
+
+static gboolean on_draw (GtkWidget *widget, cairo_t *cr, gpointer user_data)
+{
+    GdkRectangle clip, frame;
+    GdkPixbuf *pixbuf;
+
+    if (!frame_pixbuf || !gdk_cairo_get_clip_rectangle (cr, &clip)) {
+        return FALSE;
+    }
+
+    frame.x = 0;
+    frame.y = 0;
+    frame.width = gdk_pixbuf_get_width (frame_pixbuf);
+    frame.height = gdk_pixbuf_get_height (frame_pixbuf);
+    if (!gdk_rectangle_intersect (&clip, &frame, &clip)) {
+        return FALSE;
+    }
+
+    // only the part being redrawn is converted to a cairo surface
+    _GrMouseCompositeBegin ();
+    pixbuf = gdk_pixbuf_new_subpixbuf (frame_pixbuf, clip.x, clip.y,
+                                       clip.width, clip.height);
+    gdk_cairo_set_source_pixbuf (cr, pixbuf, clip.x, clip.y);
+    cairo_paint (cr);
+    g_object_unref (pixbuf);
+    _GrMouseCompositeEnd ();
+    _GrLatencyPresented ();
+
+    return TRUE;
+}
+
 static gboolean setup_grapics_mode (GrxVideoMode *mode, gboolean noclear)
 {
     GdkPixbuf *pixbuf;
-    GdkPixbufSimpleAnim *animation;
 
     if (!detect ()) {
         return FALSE;
     }
 
-    g_return_val_if_fail (image != NULL, FALSE);
+    g_return_val_if_fail (drawing_area != NULL, FALSE);
 
     pixbuf = gdk_pixbuf_new (GDK_COLORSPACE_RGB, FALSE, 8, mode->width,
                              mode->height);
 
     g_return_val_if_fail (pixbuf != NULL, FALSE);
-    g_return_val_if_fail (gdk_pixbuf_get_rowstride (pixbuf) == mode->line_offset,
-                          FALSE);
+    if (gdk_pixbuf_get_rowstride (pixbuf) != mode->line_offset) {
+        g_object_unref (pixbuf);
+        g_return_val_if_reached (FALSE);
+    }
 
     if (!noclear) {
         gdk_pixbuf_fill (pixbuf, 0);
@@ -92,13 +154,13 @@ static gboolean setup_grapics_mode (GrxVideoMode *mode, gboolean noclear)
 
     mode->extended_info->frame = gdk_pixbuf_get_pixels (pixbuf);
 
-    // Using an animation get the pixbuf to automatically refresh on the screen.
-    // GRX does not have a way of notifying that a context is "dirty".
-    animation = gdk_pixbuf_simple_anim_new (mode->width, mode->height, 25);
-    gdk_pixbuf_simple_anim_add_frame (animation, pixbuf);
-    gdk_pixbuf_simple_anim_set_loop (animation, TRUE);
-    gtk_image_set_from_animation (GTK_IMAGE (image),
-                                  GDK_PIXBUF_ANIMATION (animation));
+    // The screen is only redrawn where GRX reports damage (see damaged()).
+    if (frame_pixbuf) {
+        g_object_unref (frame_pixbuf);
+    }
+    frame_pixbuf = pixbuf;
+    gtk_widget_set_size_request (drawing_area, mode->width, mode->height);
+    gtk_widget_queue_draw (drawing_area);
 
     return TRUE;
 }
@@ -131,6 +193,7 @@ static GrxVideoModeExt graphics_mode_ext = {
     .set_bank           = NULL,
     .set_rw_banks       = NULL,
     .load_color         = NULL,
+    .damaged            = damaged,
 };
 
 static GrxVideoMode video_modes[] = {
@@ -326,7 +389,7 @@ static gboolean init (const gchar *options)
 
     detect ();
     g_return_val_if_fail (gtk_init_ok, FALSE);
-    g_return_val_if_fail (image == NULL, FALSE);
+    g_return_val_if_fail (drawing_area == NULL, FALSE);
 
     device_manager = g_initable_new (GRX_TYPE_GTK3_DEVICE_MANAGER, NULL, &err, NULL);
     if (!device_manager) {
@@ -343,8 +406,8 @@ static gboolean init (const gchar *options)
                       (GCallback)on_window_notify_is_active, NULL);
     g_signal_connect (window, "delete-event", (GCallback)on_window_delete_event, NULL);
 
-    // Have to have a GtkEventBox to handle events since GtkImage doesn't have
-    // a GdkWindow.
+    // Events are handled by a GtkEventBox, so that the drawing area does not
+    // need its own event masks.
     event_box = gtk_event_box_new ();
     gtk_widget_set_can_focus (event_box, TRUE); // for keyboard input
     gtk_widget_set_events (event_box, GDK_POINTER_MOTION_MASK | GDK_BUTTON_PRESS_MASK |
@@ -356,10 +419,11 @@ static gboolean init (const gchar *options)
     g_signal_connect (G_OBJECT (event_box), "leave-notify-event",
                       (GCallback)set_cursor, "default");
 
-    image = gtk_image_new ();
+    drawing_area = gtk_drawing_area_new ();
+    g_signal_connect (G_OBJECT (drawing_area), "draw", (GCallback)on_draw, NULL);
 
     gtk_container_add (GTK_CONTAINER (window), event_box);
-    gtk_container_add (GTK_CONTAINER (event_box), image);
+    gtk_container_add (GTK_CONTAINER (event_box), drawing_area);
     gtk_widget_show_all (window);
 
     DRVINFO->device_manager = GRX_DEVICE_MANAGER (device_manager);
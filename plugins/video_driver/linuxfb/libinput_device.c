@@ -68,6 +68,7 @@ get_property (GObject *object, guint property_id, GValue *value,
 {
     GrxLibinputDevice *self = GRX_LIBINPUT_DEVICE (object);
 
+    grx_libinput_lock ();
     switch (property_id) {
     case PROP_NAME:
         g_value_set_string (value, libinput_device_get_name (self->device));
@@ -94,6 +95,7 @@ get_property (GObject *object, guint property_id, GValue *value,
         G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
         break;
     }
+    grx_libinput_unlock ();
 }
 
 /* class implementation */
@@ -104,7 +106,9 @@ static gboolean reset_calibration (GrxDevice *device)
     float identity_matrix[6] = { 1, 0, 0, 0, 1, 0 };
     enum libinput_config_status ret;
 
+    grx_libinput_lock ();
     ret = libinput_device_config_calibration_set_matrix (self->device, identity_matrix);
+    grx_libinput_unlock ();
 
     return ret == LIBINPUT_CONFIG_STATUS_SUCCESS;
 }
@@ -116,8 +120,10 @@ static void finalize (GObject *object)
     G_OBJECT_CLASS (grx_libinput_device_parent_class)->finalize (object);
 
     xkb_state_unref (self->state);
+    grx_libinput_lock ();
     libinput_device_set_user_data (self->device, NULL);
     self->device = libinput_device_unref (self->device);
+    grx_libinput_unlock ();
 }
 
 static void
@@ -247,3 +253,22 @@ GrxModifierFlags grx_libinput_device_get_modifier_flags (GrxLibinputDevice *devi
 
     return flags;
 }
+
+/*
+ * libinput is not thread safe. When input is read on its own thread (see
+ * grx_libinput_device_manager_start_thread()), devices may still be used or
+ * freed on the main thread, so all libinput calls are made with this lock
+ * held. It is recursive because freeing a device can happen while the input
+ * source is handling an event.
+ */
+static GRecMutex libinput_lock;
+
+void grx_libinput_lock (void)
+{
+    g_rec_mutex_lock (&libinput_lock);
+}
+
+void grx_libinput_unlock (void)
+{
+    g_rec_mutex_unlock (&libinput_lock);
+}
@@ -38,4 +38,7 @@ void grx_libinput_device_update_state (GrxLibinputDevice *device,
                                        gunichar *unichar);
 GrxModifierFlags grx_libinput_device_get_modifier_flags (GrxLibinputDevice *device);
 
+void grx_libinput_lock (void);
+void grx_libinput_unlock (void);
+
 #endif /* __GRX_LIBINPUT_DEVICE_H__ */
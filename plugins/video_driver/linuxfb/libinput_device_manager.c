@@ -43,6 +43,11 @@ struct _GrxLibinputDeviceManager
     struct xkb_context *xkb;
     struct xkb_keymap *keymap;
     GList *devices;
+    /* only used when input is read on its own thread */
+    GMainContext *main_context;
+    gboolean threaded;
+    gint cursor_x, cursor_y;
+    gint cursor_pending;
 };
 
 static void initable_interface_init (GInitableIface *iface);
@@ -59,6 +64,9 @@ static void finalize (GObject *object)
 
     G_OBJECT_CLASS (grx_libinput_device_manager_parent_class)->finalize (object);
 
+    if (self->main_context) {
+        g_main_context_unref (self->main_context);
+    }
     xkb_keymap_unref (self->keymap);
     xkb_context_unref (self->xkb);
     self->libinput = libinput_unref (self->libinput);
@@ -158,7 +166,9 @@ static gboolean source_prepare (GSource *source, gint *timeout)
         ((GrxLibinputDeviceManagerSource *)source)->instance;
     enum libinput_event_type type;
 
+    grx_libinput_lock ();
     type = libinput_next_event_type (instance->libinput);
+    grx_libinput_unlock ();
     *timeout = -1;
 
     return type != LIBINPUT_EVENT_NONE;
@@ -170,8 +180,10 @@ static gboolean source_check (GSource *source)
         ((GrxLibinputDeviceManagerSource *)source)->instance;
     enum libinput_event_type type;
 
+    grx_libinput_lock ();
     libinput_dispatch (instance->libinput);
     type = libinput_next_event_type (instance->libinput);
+    grx_libinput_unlock ();
 
     return type != LIBINPUT_EVENT_NONE;
 }
@@ -181,22 +193,85 @@ extern void grx_linuxfb_chvt (int vt_num);
 extern void grx_linuxfb_update_pointer (gint32 dx, gint32 dy, gint32 *x, gint32 *y);
 extern void grx_linuxfb_get_pointer (gint32 *x, gint32 *y);
 
-static gboolean
-source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
+typedef struct {
+    GrxLibinputDeviceManager *instance;
+    GrxLibinputDevice *device;
+    const gchar *signal;
+} DeviceSignal;
+
+static gboolean emit_device_signal_cb (gpointer user_data)
+{
+    DeviceSignal *data = user_data;
+
+    g_signal_emit_by_name (data->instance, data->signal, data->device);
+    g_object_unref (data->device);
+    g_object_unref (data->instance);
+    g_slice_free (DeviceSignal, data);
+
+    return G_SOURCE_REMOVE;
+}
+
+/* signal handlers always run on the main thread */
+static void emit_device_signal (GrxLibinputDeviceManager *instance,
+                                const gchar *signal, GrxLibinputDevice *device)
+{
+    DeviceSignal *data;
+
+    if (!instance->threaded) {
+        g_signal_emit_by_name (instance, signal, device);
+        return;
+    }
+
+    data = g_slice_new (DeviceSignal);
+    data->instance = g_object_ref (instance);
+    data->device = g_object_ref (device);
+    data->signal = signal;
+    g_main_context_invoke (instance->main_context, emit_device_signal_cb, data);
+}
+
+static gboolean update_cursor_cb (gpointer user_data)
+{
+    GrxLibinputDeviceManager *instance = user_data;
+
+    g_atomic_int_set (&instance->cursor_pending, FALSE);
+    MOUINFO->xpos = g_atomic_int_get (&instance->cursor_x);
+    MOUINFO->ypos = g_atomic_int_get (&instance->cursor_y);
+    _grx_mouse_update_cursor ();
+    g_object_unref (instance);
+
+    return G_SOURCE_REMOVE;
+}
+
+/*
+ * The cursor is drawn on the main thread. When the input thread is faster,
+ * only the latest position is drawn.
+ */
+static void update_cursor (GrxLibinputDeviceManager *instance, gint x, gint y)
+{
+    if (!instance->threaded) {
+        MOUINFO->xpos = x;
+        MOUINFO->ypos = y;
+        _grx_mouse_update_cursor ();
+        return;
+    }
+
+    g_atomic_int_set (&instance->cursor_x, x);
+    g_atomic_int_set (&instance->cursor_y, y);
+    if (g_atomic_int_compare_and_exchange (&instance->cursor_pending, FALSE, TRUE)) {
+        g_main_context_invoke (instance->main_context, update_cursor_cb,
+                               g_object_ref (instance));
+    }
+}
+
+static void handle_event (GSource *source, struct libinput_event *event)
 {
     GrxLibinputDeviceManager *instance =
         ((GrxLibinputDeviceManagerSource *)source)->instance;
-    struct libinput_event *event;
     struct libinput_device *device;
     GrxLibinputDevice *grx_device;
     enum libinput_event_type type;
     GrxEvent grx_event = { 0 };
 
-    event = libinput_get_event (instance->libinput);
-    if (!event) {
-        return G_SOURCE_CONTINUE;
-    }
-
     type = libinput_event_get_type (event);
 
     device = libinput_event_get_device (event);
@@ -218,13 +293,11 @@ source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
     switch (type) {
     case LIBINPUT_EVENT_DEVICE_ADDED:
         instance->devices = g_list_append (instance->devices, grx_device);
-        g_signal_emit_by_name (instance, "device-added",
-                               grx_device);
+        emit_device_signal (instance, "device-added", grx_device);
         break;
     case LIBINPUT_EVENT_DEVICE_REMOVED:
         instance->devices = g_list_remove (instance->devices, grx_device);
-        g_signal_emit_by_name (instance, "device-removed",
-                               grx_device);
+        emit_device_signal (instance, "device-removed", grx_device);
         g_object_unref (grx_device);
         break;
     case LIBINPUT_EVENT_KEYBOARD_KEY:
@@ -234,6 +307,7 @@ source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
             xkb_keycode_t keycode;
 
             keyboard = libinput_event_get_keyboard_event (event);
+            grx_event.key.time = libinput_event_keyboard_get_time_usec (keyboard);
             key = libinput_event_keyboard_get_key (keyboard);
             keycode = key + 8; // xkb keymaps are usually offset by 8
             switch (libinput_event_keyboard_get_key_state (keyboard)) {
@@ -281,6 +355,7 @@ source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
             gint32 x, y;
 
             pointer = libinput_event_get_pointer_event (event);
+            grx_event.motion.time = libinput_event_pointer_get_time_usec (pointer);
             if (type == LIBINPUT_EVENT_POINTER_MOTION) {
                 dx = libinput_event_pointer_get_dx (pointer);
                 dy = libinput_event_pointer_get_dy (pointer);
@@ -298,9 +373,7 @@ source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
             grx_event.motion.modifiers = grx_libinput_device_get_modifier_flags (grx_device);
             grx_event.motion.device = GRX_DEVICE (grx_device);
 
-            MOUINFO->xpos = grx_event.motion.x;
-            MOUINFO->ypos = grx_event.motion.y;
-            _grx_mouse_update_cursor();
+            update_cursor (instance, grx_event.motion.x, grx_event.motion.y);
         }
         break;
     case LIBINPUT_EVENT_POINTER_BUTTON:
@@ -309,6 +382,7 @@ source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
             uint32_t button, time;
 
             pointer = libinput_event_get_pointer_event (event);
+            grx_event.button.time = libinput_event_pointer_get_time_usec (pointer);
             button = libinput_event_pointer_get_button (pointer);
             switch (libinput_event_pointer_get_button_state (pointer)) {
             case LIBINPUT_BUTTON_STATE_PRESSED:
@@ -351,6 +425,7 @@ source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
             double y = 0.0;
 
             touch = libinput_event_get_touch_event (event);
+            grx_event.touch.time = libinput_event_touch_get_time_usec (touch);
             slot = libinput_event_touch_get_slot (touch);
             if (type == LIBINPUT_EVENT_TOUCH_DOWN
                 || type == LIBINPUT_EVENT_TOUCH_MOTION)
@@ -390,6 +465,25 @@ source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
     }
 
     libinput_event_destroy (event);
+}
+
+/*
+ * Converts the events that libinput has read so far, up to the dispatch
+ * budget, so that a burst of input is handled in one main loop iteration.
+ */
+static gboolean
+source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
+{
+    GrxLibinputDeviceManager *instance =
+        ((GrxLibinputDeviceManagerSource *)source)->instance;
+    struct libinput_event *event;
+    guint budget = grx_event_get_dispatch_budget ();
+
+    grx_libinput_lock ();
+    while (budget-- && (event = libinput_get_event (instance->libinput))) {
+        handle_event (source, event);
+    }
+    grx_libinput_unlock ();
 
     return G_SOURCE_CONTINUE;
 }
@@ -446,3 +540,63 @@ guint grx_libinput_device_manager_event_add (GrxLibinputDeviceManager *context)
 
     return id;
 }
+
+static gpointer input_thread_func (gpointer user_data)
+{
+    GrxLibinputDeviceManager *self = user_data;
+    GMainContext *context;
+    GSource *source;
+
+    context = g_main_context_new ();
+    g_main_context_push_thread_default (context);
+
+    source = grx_libinput_device_manager_source_new (self);
+    g_source_attach (source, context);
+    g_source_unref (source);
+    g_object_unref (self);
+
+    // like the source on the main context, this runs until the program exits
+    for (;;) {
+        g_main_context_iteration (context, TRUE);
+    }
+
+    return NULL;
+}
+
+/**
+ * grx_libinput_device_manager_start_thread:
+ * @context: #GrxLibinputDeviceManager instance
+ * @error: (nullable): error pointer
+ *
+ * Reads input on a new thread instead of using a source on the main context
+ * (see grx_libinput_device_manager_event_add()), so that input is not lost
+ * when the main loop is busy for a long time. Keyboard state and the pointer
+ * position are tracked on the input thread and the events are added to the
+ * GRX event queue, which wakes up the thread default main context of the
+ * caller. The device signals and the mouse cursor still run on that context.
+ *
+ * Returns: %TRUE if the thread was started
+ */
+gboolean grx_libinput_device_manager_start_thread (GrxLibinputDeviceManager *context,
+                                                   GError **error)
+{
+    GThread *thread;
+
+    g_return_val_if_fail (!context->threaded, FALSE);
+
+    context->main_context = g_main_context_ref_thread_default ();
+    context->threaded = TRUE;
+
+    thread = g_thread_try_new ("grx-input", input_thread_func,
+                               g_object_ref (context), error);
+    if (!thread) {
+        context->threaded = FALSE;
+        g_main_context_unref (context->main_context);
+        context->main_context = NULL;
+        g_object_unref (context);
+        return FALSE;
+    }
+    g_thread_unref (thread);
+
+    return TRUE;
+}
@@ -43,5 +43,7 @@ typedef struct {
 
 GSource *grx_libinput_device_manager_source_new (GrxLibinputDeviceManager *context);
 guint grx_libinput_device_manager_event_add (GrxLibinputDeviceManager *context);
+gboolean grx_libinput_device_manager_start_thread (GrxLibinputDeviceManager *context,
+                                                   GError **error);
 
 #endif /* __GRX_LIBINPUT_DEVICE_MANAGER_H__ */
@@ -60,6 +60,27 @@ static int original_keyboard_mode;
 static GrxContext *save;
 static gint32 pointer_x, pointer_y;
 
+/*
+ * With the "db" flag, GRX draws to a back buffer in system memory (which is
+ * cached, unlike most frame buffers) and the damaged areas are copied to the
+ * frame buffer when the main loop is idle or grx_present_screen() is called.
+ * If the virtual frame buffer is tall enough for two pages, the copy goes to
+ * the hidden page, which is then shown with FBIOPAN_DISPLAY.
+ */
+static gboolean use_back_buffer;
+static unsigned char *back_buffer = NULL;
+static gboolean page_flip;
+static int front_page;
+static _GR_damageRect prev_rects[GRX_DAMAGE_MAX_RECTS];
+static int n_prev_rects;
+static guint present_source_id;
+
+/*
+ * With the "it" flag, input is read on its own thread, so that touches and
+ * key presses are not lost while the program is busy drawing.
+ */
+static gboolean use_input_thread;
+
 static int detect(void)
 {
     struct vt_stat vtstat;
@@ -204,12 +225,120 @@ static int detect(void)
     return (initted > 0);
 }
 
+static void free_back_buffer(void)
+{
+    if (present_source_id) {
+        g_source_remove(present_source_id);
+        present_source_id = 0;
+    }
+    g_free(back_buffer);
+    back_buffer = NULL;
+}
+
+static void copy_rect(unsigned char *page, const _GR_damageRect *r)
+{
+    int bpp = (fbvar.bits_per_pixel == 15) ? 16 : fbvar.bits_per_pixel;
+    int bx1 = (r->x1 * bpp) >> 3;
+    int bx2 = ((r->x2 + 1) * bpp + 7) >> 3;
+    long ofs = (long)r->y1 * fbfix.line_length + bx1;
+    int y;
+
+    for (y = r->y1; y <= r->y2; y++, ofs += fbfix.line_length) {
+        memcpy(&page[ofs], &back_buffer[ofs], bx2 - bx1);
+    }
+}
+
+static gboolean pan_to_page(int page)
+{
+    struct fb_var_screeninfo var = fbvar;
+
+    var.xoffset = 0;
+    var.yoffset = page * fbvar.yres;
+    var.activate = FB_ACTIVATE_VBL;
+
+    return ioctl(fbfd, FBIOPAN_DISPLAY, &var) == 0;
+}
+
+static void present(void)
+{
+    _GR_damageRect rects[GRX_DAMAGE_MAX_RECTS];
+    unsigned char *page;
+    int i, n;
+
+    if (present_source_id) {
+        g_source_remove(present_source_id);
+        present_source_id = 0;
+    }
+
+    n = _GrDamageTake(rects);
+    if (!n || !back_buffer || !in_graphics_mode) {
+        // anything lost while switched away is redrawn when switching back
+        return;
+    }
+
+    _GrMouseCompositeBegin();
+    if (!page_flip) {
+        for (i = 0; i < n; i++) {
+            copy_rect(fbuffer, &rects[i]);
+        }
+        _GrMouseCompositeEnd();
+        _GrLatencyPresented();
+        return;
+    }
+
+    // The hidden page was last updated two frames ago, so it also needs the
+    // areas that changed in the previous frame.
+    page = fbuffer + (long)(1 - front_page) * fbvar.yres * fbfix.line_length;
+    for (i = 0; i < n_prev_rects; i++) {
+        copy_rect(page, &prev_rects[i]);
+    }
+    for (i = 0; i < n; i++) {
+        copy_rect(page, &rects[i]);
+    }
+    if (pan_to_page(1 - front_page)) {
+        front_page = 1 - front_page;
+        memcpy(prev_rects, rects, n * sizeof(*rects));
+        n_prev_rects = n;
+    }
+    else {
+        // Single page mode only draws to page 0, so that has to be shown and
+        // brought up to date as a whole: this frame only went to the hidden
+        // page and page 0 may be two frames behind.
+        g_debug("FBIOPAN_DISPLAY failed, using a single page");
+        page_flip = FALSE;
+        n_prev_rects = 0;
+        memcpy(fbuffer, back_buffer, (long)fbvar.yres * fbfix.line_length);
+        if (front_page != 0) {
+            pan_to_page(0);
+            front_page = 0;
+        }
+    }
+    _GrMouseCompositeEnd();
+    _GrLatencyPresented();
+}
+
+static gboolean present_idle(gpointer user_data)
+{
+    present_source_id = 0;
+    present();
+
+    return G_SOURCE_REMOVE;
+}
+
+static void damaged(void)
+{
+    if (!present_source_id) {
+        present_source_id = g_idle_add(present_idle, NULL);
+    }
+}
+
 static void reset(void)
 {
     struct vt_mode vtm;
     struct vt_stat vtstat;
 
     g_debug("closing vd_lnxfb");
+    free_back_buffer();
     if (fbuffer) {
         memzero(fbuffer, fbvar.yres * fbfix.line_length);
         munmap(fbuffer, fbfix.smem_len);
@@ -333,6 +462,30 @@ static int setmode(GrxVideoMode * mp, int noclear)
                                         fbfix.smem_len,
                                         PROT_READ | PROT_WRITE,
                                         MAP_SHARED, fbfd, 0);
+    if (mp->extended_info->frame && use_back_buffer) {
+        long size = (long)fbvar.yres * fbfix.line_length;
+
+        free_back_buffer();
+        back_buffer = g_try_malloc(size);
+        if (!back_buffer) {
+            g_debug("Could not allocate back buffer");
+            munmap(fbuffer, fbfix.smem_len);
+            fbuffer = mp->extended_info->frame = NULL;
+            return FALSE;
+        }
+        // keep the current screen contents for noclear
+        memcpy(back_buffer, fbuffer + (long)fbvar.yoffset * fbfix.line_length, size);
+        mp->extended_info->frame = back_buffer;
+
+        page_flip = fbvar.yres_virtual >= 2 * fbvar.yres &&
+                    fbfix.smem_len >= 2 * size &&
+                    fbfix.ypanstep > 0 &&
+                    pan_to_page(0);
+        front_page = 0;
+        n_prev_rects = 0;
+        g_debug("back buffer enabled, page flipping %s",
+                page_flip ? "enabled" : "not available");
+    }
     if (mp->extended_info->frame && ttyfd > -1) {
         ioctl(ttyfd, KDSKBMODE, K_OFF);
         ioctl(ttyfd, KDSETMODE, KD_GRAPHICS);
@@ -351,6 +504,7 @@ static int settext(GrxVideoMode * mp, int noclear)
 {
     struct vt_mode vtm;
 
+    free_back_buffer();
     if (fbuffer) {
         memzero(fbuffer, fbvar.yres * fbfix.line_length);
         munmap(fbuffer, fbfix.smem_len);
@@ -406,6 +560,8 @@ static int build_video_mode(GrxVideoMode * mp, GrxVideoModeExt * ep)
     ep->set_bank = NULL;
     ep->set_rw_banks = NULL;
     ep->load_color = NULL;
+    ep->damaged = use_back_buffer ? damaged : NULL;
+    ep->present = use_back_buffer ? present : NULL;
     switch (fbvar.bits_per_pixel) {
     case 1:
         if (fbfix.visual == FB_VISUAL_MONO01)
@@ -487,6 +643,28 @@ static gboolean console_switch_handler (gpointer user_data)
 {
     GrxEvent event;
 
+    if (back_buffer) {
+        // The screen context is in system memory, so nothing has to be saved.
+        // Drawing can even continue while switched away.
+        if (in_graphics_mode) {
+            event.type = GRX_EVENT_TYPE_APP_DEACTIVATE;
+            grx_event_put (&event);
+            grx_linuxfb_release ();
+        } else {
+            grx_linuxfb_aquire ();
+            // the console may have panned or drawn on the frame buffer
+            if (page_flip) {
+                page_flip = pan_to_page (front_page);
+            }
+            n_prev_rects = 0;
+            grx_context_mark_dirty (grx_get_screen_context (), 0, 0,
+                grx_get_screen_width () - 1, grx_get_screen_height () - 1);
+            event.type = GRX_EVENT_TYPE_APP_ACTIVATE;
+            grx_event_put (&event);
+        }
+        return G_SOURCE_CONTINUE;
+    }
+
     if (in_graphics_mode) {
         // A well-behaved user program must listen for GRX_EVENT_TYPE_APP_DEACTIVATE
         // and stop drawing on the screen until GRX_EVENT_TYPE_APP_ACTIVATE is received.
@@ -533,6 +711,24 @@ static gboolean console_switch_handler (gpointer user_data)
     return G_SOURCE_CONTINUE;
 }
 
+/* checks for a whole flag in a comma or space separated list of options */
+static gboolean has_option(const char *options, const char *flag)
+{
+    size_t len = strlen(flag);
+
+    while (options && *options) {
+        size_t n = strcspn(options, ", ");
+
+        if (n == len && strncmp(options, flag, len) == 0) {
+            return TRUE;
+        }
+        options += n;
+        options += strspn(options, ", ");
+    }
+
+    return FALSE;
+}
+
 static int init(const char *options)
 {
     if (detect()) {
@@ -542,6 +738,9 @@ static int init(const char *options)
         GrxEvent event;
         GError *err = NULL;
 
+        use_back_buffer = has_option(options, "db");
+        use_input_thread = has_option(options, "it");
+
         device_manager = g_initable_new (GRX_TYPE_LIBINPUT_DEVICE_MANAGER, NULL,
                                          &err, NULL);
         if (!device_manager) {
@@ -562,7 +761,15 @@ static int init(const char *options)
         grx_event_put (&event);
 
         DRVINFO->device_manager = GRX_DEVICE_MANAGER (device_manager);
-        grx_libinput_device_manager_event_add (device_manager);
+        if (!use_input_thread ||
+            !grx_libinput_device_manager_start_thread (device_manager, &err))
+        {
+            if (err) {
+                g_debug ("%s", err->message);
+                g_clear_error (&err);
+            }
+            grx_libinput_device_manager_event_add (device_manager);
+        }
 
         return TRUE;
     }
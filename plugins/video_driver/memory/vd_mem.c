@@ -114,6 +114,21 @@ static GrxVideoModeExt gr8ext = {
     .load_color       = NULL,                       /* color loader */
 };
 
+static GrxVideoModeExt gr16ext = {
+    .mode             = GRX_FRAME_MODE_RAM_16BPP,   /* frame driver */
+    .drv              = NULL,                       /* frame driver override */
+    .frame            = NULL,                       /* frame buffer address */
+    .cprec            = { 5, 6, 5 },                /* color precisions */
+    .cpos             = { 11, 5, 0 },               /* color component bit positions */
+    .flags            = GRX_VIDEO_MODE_FLAG_MEMORY, /* mode flag bits */
+    .setup            = mem_setmode,                /* mode set */
+    .set_virtual_size = NULL,                       /* virtual size set */
+    .scroll           = NULL,                       /* virtual scroll */
+    .set_bank         = NULL,                       /* bank set function */
+    .set_rw_banks     = NULL,                       /* double bank set function */
+    .load_color       = NULL,                       /* color loader */
+};
+
 static GrxVideoModeExt gr24ext = {
 #ifdef GRX_USE_RAM3x8
     .mode             = GRX_FRAME_MODE_RAM_3X8BPP,  /* frame driver */
@@ -137,6 +152,21 @@ static GrxVideoModeExt gr24ext = {
     .load_color       = NULL,                       /* color loader */
 };
 
+static GrxVideoModeExt gr32ext = {
+    .mode             = GRX_FRAME_MODE_RAM_32BPP_LOW,/* frame driver */
+    .drv              = NULL,                       /* frame driver override */
+    .frame            = NULL,                       /* frame buffer address */
+    .cprec            = { 8, 8, 8 },                /* color precisions */
+    .cpos             = { 16, 8, 0 },               /* color component bit positions */
+    .flags            = GRX_VIDEO_MODE_FLAG_MEMORY, /* mode flag bits */
+    .setup            = mem_setmode,                /* mode set */
+    .set_virtual_size = NULL,                       /* virtual size set */
+    .scroll           = NULL,                       /* virtual scroll */
+    .set_bank         = NULL,                       /* bank set function */
+    .set_rw_banks     = NULL,                       /* double bank set function */
+    .load_color       = NULL,                       /* color loader */
+};
+
 static int dummymode (GrxVideoMode * mp , int noclear )
 {
     FreeMemBuf();
@@ -164,7 +194,9 @@ static GrxVideoMode modes[] = {
     {  TRUE,  2,  640,  480,  0x00,  160,    0,  &gr2ext                          },
     {  TRUE,  4,  640,  480,  0x00,  320,    0,  &gr4ext                          },
     {  TRUE,  8,  640,  480,  0x00,  640,    0,  &gr8ext                          },
+    {  TRUE, 16,  640,  480,  0x00, 1280,    0,  &gr16ext                         },
     {  TRUE, 24,  640,  480,  0x00, 1920,    0,  &gr24ext                         },
+    {  TRUE, 32,  640,  480,  0x00, 2560,    0,  &gr32ext                         },
     {  TRUE,  1,   80,   25,  0x00,  160,    0,  &dummyExt                        }
 };
 
@@ -194,15 +226,25 @@ static GrxVideoMode * mem_selectmode ( GrxVideoDriver * drv, int w, int h,
                    LineOffset = (w + 7) >> 3;
                    size = h;
                    break;
-         case 4:   index = 1;
+         case 2:   index = 1;
+                   LineOffset = (w + 3) >> 2;
+                   size = h;
+                   break;
+         case 4:   index = 2;
                    LineOffset = (w + 7) >> 3;
                    size = 4*h;
                    break;
-         case 8:   index = 2;
+         case 8:   index = 3;
                    LineOffset = w;
                    size = h;
                    break;
-         case 24:  index = 3;
+         case 15:
+         case 16:  index = 4;
+                   bpp = 16;
+                   LineOffset = 2*w;
+                   size = h;
+                   break;
+         case 24:  index = 5;
 #ifdef GRX_USE_RAM3x8
                    LineOffset = w;
                    size = 3*h;
@@ -211,6 +253,10 @@ static GrxVideoMode * mem_selectmode ( GrxVideoDriver * drv, int w, int h,
                    size = h;
 #endif
                    break;
+         case 32:  index = 6;
+                   LineOffset = 4*w;
+                   size = h;
+                   break;
          default:  return NULL;
       }
 
@@ -15,8 +15,10 @@
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  */
 
+#include "colors.h"
 #include "globals.h"
 #include "libgrx.h"
+#include "grdriver.h"
 #include "mouse.h"
 #include "clipping.h"
 
@@ -44,6 +46,7 @@ void grx_context_bit_blt(GrxContext *dst,int dx,int dy,GrxContext *src,
         int  oldx1,oldy1;
         int  oldx2,oldy2;
         int  dstx2,dsty2;
+        _GR_contextBinding b;
         void (*bltfun)(GrxFrame*,int,int,GrxFrame*,int,int,int,int,GrxColor);
         if(dst == NULL) dst = CURC;
         if(src == NULL) src = CURC;
@@ -59,15 +62,23 @@ void grx_context_bit_blt(GrxContext *dst,int dx,int dy,GrxContext *src,
         y1 += (dy - oldy1);
         x2 -= (oldx2 - dstx2);
         y2 -= (oldy2 - dsty2);
-        if(src->gc_driver == dst->gc_driver)
+        /* only an ARGB source has an alpha channel to composite with */
+        if((C_OPER(oper) == C_BLEND) &&
+           (src->gc_driver->mode != GRX_FRAME_MODE_RAM_32BPP_ARGB))
+            oper = grx_color_to_write_mode(oper);
+        if(C_OPER(oper) == C_BLEND)
+            bltfun = _GrFrDrvBlendBitBlt;
+        else if(src->gc_driver == dst->gc_driver)
             bltfun = src->gc_driver->bitblt;
         else if(src->gc_driver->mode == dst->gc_driver->rmode)
             bltfun = dst->gc_driver->bltr2v;
         else if(src->gc_driver->rmode == dst->gc_driver->mode)
             bltfun = src->gc_driver->bltv2r;
         else return;
-        mouse_block(src,x1,y1,x2,y2);
+        mouse_block_read(src,x1,y1,x2,y2);
         mouse_addblock(dst,dx,dy,dstx2,dsty2);
+        /* the generic blits draw through the current context */
+        context_bind(&b,dst);
         (*bltfun)(
             &dst->frame,(dx + dst->x_offset),(dy + dst->y_offset),
             &src->frame,(x1 + src->x_offset),(y1 + src->y_offset),
@@ -75,5 +86,6 @@ void grx_context_bit_blt(GrxContext *dst,int dx,int dy,GrxContext *src,
             (y2 - y1 + 1),
             oper
         );
+        context_unbind(&b);
         mouse_unblock();
 }
@@ -49,6 +49,7 @@ void grx_context_bit_blt_1bpp(GrxContext *dst,int dx,int dy,
   int oldx1,oldy1;
   int oldx2,oldy2;
   int dstx2,dsty2;
+  _GR_contextBinding b;
 
   if(dst == NULL) dst = CURC;
   if(src == NULL) src = CURC;
@@ -68,13 +69,16 @@ void grx_context_bit_blt_1bpp(GrxContext *dst,int dx,int dy,
   y1 += (dy - oldy1);
   x2 -= (oldx2 - dstx2);
   y2 -= (oldy2 - dsty2);
-  mouse_block(src,x1,y1,x2,y2);
+  mouse_block_read(src,x1,y1,x2,y2);
   mouse_addblock(dst,dx,dy,dstx2,dsty2);
 
+  /* the frame driver draws the bitmap to the current context */
+  context_bind(&b,dst);
   (dst->gc_driver->drawbitmap)((dx + dst->x_offset),(dy + dst->y_offset),
     (x2 - x1 + 1),(y2 - y1 + 1),src->gc_base_address.plane0,src->gc_line_offset,
     /*alex:the offset should anyway be the x1,y1 point in src, as clipped*/
     (x1 + (y1 * (src->gc_line_offset << 3))),fg,bg);
+  context_unbind(&b);
 
   mouse_unblock();
 }
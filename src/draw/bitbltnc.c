@@ -15,9 +15,12 @@
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  */
 
+#include "colors.h"
 #include "globals.h"
 #include "libgrx.h"
+#include "grdriver.h"
 #include "clipping.h"
+#include "damage.h"
 
 /**
  * grx_context_fast_bit_blt:
@@ -47,13 +50,19 @@ void grx_context_fast_bit_blt(GrxContext *dst,int dx,int dy,
         if(src == NULL) src = CURC;
         isort(x1,x2);
         isort(y1,y2);
-        if(src->gc_driver == dst->gc_driver)
+        if((C_OPER(oper) == C_BLEND) &&
+           (src->gc_driver->mode != GRX_FRAME_MODE_RAM_32BPP_ARGB))
+            oper = grx_color_to_write_mode(oper);
+        if(C_OPER(oper) == C_BLEND)
+            bltfun = _GrFrDrvBlendBitBlt;
+        else if(src->gc_driver == dst->gc_driver)
             bltfun = src->gc_driver->bitblt;
         else if(src->gc_driver->mode == dst->gc_driver->rmode)
             bltfun = dst->gc_driver->bltr2v;
         else if(src->gc_driver->rmode == dst->gc_driver->mode)
             bltfun = src->gc_driver->bltv2r;
         else return;
+        damage_add(dst,dx,dy,(dx + x2 - x1),(dy + y2 - y1));
         (*bltfun)(
             &dst->frame,(dx + dst->x_offset),(dy + dst->y_offset),
             &src->frame,(x1 + src->x_offset),(y1 + src->y_offset),
@@ -18,6 +18,7 @@
 #include "globals.h"
 #include "libgrx.h"
 #include "clipping.h"
+#include "damage.h"
 
 /**
  * grx_fast_draw_box:
@@ -38,6 +39,7 @@ void grx_fast_draw_box(int x1,int y1,int x2,int y2,GrxColor c)
 {
         isort(x1,x2);
         isort(y1,y2);
+        damage_add(CURC,x1,y1,x2,y2);
         (*FDRV->drawhline)(
             x1 + CURC->x_offset,
             y1 + CURC->y_offset,
@@ -0,0 +1,165 @@
+/*
+ * bulkdraw.c ---- drawing many pixels, lines or boxes in one call
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * The items are clipped one by one, but the mouse cursor is only checked
+ * once for the box around all of them and the frame driver is called
+ * directly, so the cost per item is close to that of the driver itself.
+ */
+
+#include <grx/draw.h>
+
+#include "globals.h"
+#include "mouse.h"
+#include "libgrx.h"
+#include "arith.h"
+#include "clipping.h"
+
+#define item_color(colors,n_colors,i)   ((n_colors) == 1 ? (colors)[0] : (colors)[i])
+
+/* gets the box around the points, clipped to the current context */
+static gboolean clipped_bounds(gint n, const GrxPoint *pt,
+                               gint *x1, gint *y1, gint *x2, gint *y2)
+{
+    gint i;
+
+    *x1 = *x2 = pt[0].x;
+    *y1 = *y2 = pt[0].y;
+    for (i = 1; i < n; i++) {
+        *x1 = imin(*x1, pt[i].x);
+        *y1 = imin(*y1, pt[i].y);
+        *x2 = imax(*x2, pt[i].x);
+        *y2 = imax(*y2, pt[i].y);
+    }
+    clip_ordbox_(CURC, *x1, *y1, *x2, *y2, return FALSE, CLIP_EMPTY_MACRO_ARG);
+
+    return TRUE;
+}
+
+/**
+ * grx_draw_pixels:
+ * @n_points: the number of points in @points
+ * @points: (array length=n_points): the pixels to draw
+ * @n_colors: the number of colors in @colors, 1 or @n_points
+ * @colors: (array length=n_colors): the color of each pixel or a single
+ *     color for all of them
+ *
+ * Draws many single pixels on the current context. This gives the same
+ * result as calling grx_draw_pixel() for each point, but much faster.
+ */
+void grx_draw_pixels(gint n_points, const GrxPoint *points,
+                     gint n_colors, const GrxColor *colors)
+{
+    gint x1, y1, x2, y2, i;
+
+    if (n_points <= 0) {
+        return;
+    }
+    g_return_if_fail(points != NULL);
+    g_return_if_fail(colors != NULL);
+    g_return_if_fail(n_colors == 1 || n_colors == n_points);
+
+    if (!clipped_bounds(n_points, points, &x1, &y1, &x2, &y2)) {
+        return;
+    }
+    mouse_block(CURC, x1, y1, x2, y2);
+    for (i = 0; i < n_points; i++) {
+        gint x = points[i].x;
+        gint y = points[i].y;
+        clip_dot_(CURC, x, y, continue);
+        (*FDRV->drawpixel)(x + CURC->x_offset, y + CURC->y_offset,
+                           item_color(colors, n_colors, i));
+    }
+    mouse_unblock();
+}
+
+/**
+ * grx_draw_lines:
+ * @n_points: the number of points in @points, two for each line
+ * @points: (array length=n_points): the starting and ending points of the
+ *     lines
+ * @n_colors: the number of colors in @colors, 1 or @n_points / 2
+ * @colors: (array length=n_colors): the color of each line or a single
+ *     color for all of them
+ *
+ * Draws many separate lines on the current context. This gives the same
+ * result as calling grx_draw_line() for each pair of points. Also see
+ * grx_draw_polyline() for lines that are joined.
+ */
+void grx_draw_lines(gint n_points, const GrxPoint *points,
+                    gint n_colors, const GrxColor *colors)
+{
+    gint x1, y1, x2, y2, i, n = n_points / 2;
+
+    if (n_points <= 0) {
+        return;
+    }
+    g_return_if_fail(points != NULL);
+    g_return_if_fail(n_points % 2 == 0);
+    g_return_if_fail(colors != NULL);
+    g_return_if_fail(n_colors == 1 || n_colors == n);
+
+    if (!clipped_bounds(n_points, points, &x1, &y1, &x2, &y2)) {
+        return;
+    }
+    mouse_block(CURC, x1, y1, x2, y2);
+    for (i = 0; i < n; i++) {
+        gint lx1 = points[2*i].x,   ly1 = points[2*i].y;
+        gint lx2 = points[2*i+1].x, ly2 = points[2*i+1].y;
+        clip_line_(CURC, lx1, ly1, lx2, ly2, continue, CLIP_EMPTY_MACRO_ARG);
+        (*FDRV->drawline)(lx1 + CURC->x_offset, ly1 + CURC->y_offset,
+                          lx2 - lx1, ly2 - ly1,
+                          item_color(colors, n_colors, i));
+    }
+    mouse_unblock();
+}
+
+/**
+ * grx_draw_filled_boxes:
+ * @n_points: the number of points in @points, two for each box
+ * @points: (array length=n_points): two opposite corners of each box
+ * @n_colors: the number of colors in @colors, 1 or @n_points / 2
+ * @colors: (array length=n_colors): the color of each box or a single
+ *     color for all of them
+ *
+ * Draws many filled rectangles on the current context. This gives the same
+ * result as calling grx_draw_filled_box() for each pair of points.
+ */
+void grx_draw_filled_boxes(gint n_points, const GrxPoint *points,
+                           gint n_colors, const GrxColor *colors)
+{
+    gint x1, y1, x2, y2, i, n = n_points / 2;
+
+    if (n_points <= 0) {
+        return;
+    }
+    g_return_if_fail(points != NULL);
+    g_return_if_fail(n_points % 2 == 0);
+    g_return_if_fail(colors != NULL);
+    g_return_if_fail(n_colors == 1 || n_colors == n);
+
+    if (!clipped_bounds(n_points, points, &x1, &y1, &x2, &y2)) {
+        return;
+    }
+    mouse_block(CURC, x1, y1, x2, y2);
+    for (i = 0; i < n; i++) {
+        gint bx1 = points[2*i].x,   by1 = points[2*i].y;
+        gint bx2 = points[2*i+1].x, by2 = points[2*i+1].y;
+        clip_box_(CURC, bx1, by1, bx2, by2, continue, CLIP_EMPTY_MACRO_ARG);
+        (*FDRV->drawblock)(bx1 + CURC->x_offset, by1 + CURC->y_offset,
+                           bx2 - bx1 + 1, by2 - by1 + 1,
+                           item_color(colors, n_colors, i));
+    }
+    mouse_unblock();
+}
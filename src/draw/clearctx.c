@@ -63,9 +63,8 @@ void grx_clear_context(GrxColor bg)
  */
 void grx_context_clear(GrxContext *ctx, GrxColor bg)
 {
-  GrxContext s;
-  grx_save_current_context(&s);
-  grx_set_current_context(ctx);
+  _GR_contextBinding b;
+  context_bind(&b,ctx);
   grx_clear_context(bg);
-  grx_set_current_context(&s);
+  context_unbind(&b);
 }
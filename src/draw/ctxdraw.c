@@ -0,0 +1,279 @@
+/*
+ * ctxdraw.c ---- drawing functions that take the context to draw on
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Each of these makes a copy of its context current for the calling thread
+ * only and calls the matching function for the current context. So worker
+ * threads can draw to their own contexts while the main thread keeps using
+ * the current context, as long as no two threads draw to the same pixels.
+ * Screen contexts should only be drawn to from the main thread.
+ */
+
+#include <grx/context.h>
+#include <grx/draw.h>
+
+#include "globals.h"
+#include "libgrx.h"
+
+/**
+ * grx_context_draw_pixel:
+ * @context: the context to draw on
+ * @x: the X coordinate
+ * @y: the Y coordinate
+ * @c: the color
+ *
+ * Draws a single pixel on @context. Also see grx_draw_pixel().
+ *
+ * Unlike the functions for the current context, this can be called from any
+ * thread.
+ */
+void grx_context_draw_pixel(GrxContext *context, gint x, gint y, GrxColor c)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_draw_pixel(x, y, c);
+    context_unbind(&b);
+}
+
+/**
+ * grx_context_draw_line:
+ * @context: the context to draw on
+ * @x1: starting X coordinate
+ * @y1: starting Y coordinate
+ * @x2: ending X coordinate
+ * @y2: ending Y coordinate
+ * @c: the color
+ *
+ * Draws a line on @context. Also see grx_draw_line().
+ *
+ * Unlike the functions for the current context, this can be called from any
+ * thread.
+ */
+void grx_context_draw_line(GrxContext *context, gint x1, gint y1, gint x2, gint y2,
+                           GrxColor c)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_draw_line(x1, y1, x2, y2, c);
+    context_unbind(&b);
+}
+
+/**
+ * grx_context_draw_box:
+ * @context: the context to draw on
+ * @x1: the left X coordinate
+ * @y1: the top Y coordinate
+ * @x2: the right X coordinate
+ * @y2: the bottom Y coordinate
+ * @c: the color
+ *
+ * Draws the outline of a rectangle on @context. Also see grx_draw_box().
+ *
+ * Unlike the functions for the current context, this can be called from any
+ * thread.
+ */
+void grx_context_draw_box(GrxContext *context, gint x1, gint y1, gint x2, gint y2,
+                          GrxColor c)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_draw_box(x1, y1, x2, y2, c);
+    context_unbind(&b);
+}
+
+/**
+ * grx_context_draw_filled_box:
+ * @context: the context to draw on
+ * @x1: the left X coordinate
+ * @y1: the top Y coordinate
+ * @x2: the right X coordinate
+ * @y2: the bottom Y coordinate
+ * @c: the color
+ *
+ * Draws a filled rectangle on @context. Also see grx_draw_filled_box().
+ *
+ * Unlike the functions for the current context, this can be called from any
+ * thread.
+ */
+void grx_context_draw_filled_box(GrxContext *context, gint x1, gint y1, gint x2, gint y2,
+                                 GrxColor c)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_draw_filled_box(x1, y1, x2, y2, c);
+    context_unbind(&b);
+}
+
+/**
+ * grx_context_draw_polyline:
+ * @context: the context to draw on
+ * @n_points: the number of points in @points
+ * @points: (array length=n_points): an array of #GrxPoint
+ * @c: the color
+ *
+ * Draws a multi-segment line on @context. Also see grx_draw_polyline().
+ *
+ * Unlike the functions for the current context, this can be called from any
+ * thread.
+ */
+void grx_context_draw_polyline(GrxContext *context, gint n_points, GrxPoint *points,
+                               GrxColor c)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_draw_polyline(n_points, points, c);
+    context_unbind(&b);
+}
+
+/**
+ * grx_context_draw_polygon:
+ * @context: the context to draw on
+ * @n_points: the number of points in @points
+ * @points: (array length=n_points): an array of #GrxPoint
+ * @c: the color
+ *
+ * Draws the outline of a closed polygon on @context. Also see
+ * grx_draw_polygon().
+ *
+ * Unlike the functions for the current context, this can be called from any
+ * thread.
+ */
+void grx_context_draw_polygon(GrxContext *context, gint n_points, GrxPoint *points,
+                              GrxColor c)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_draw_polygon(n_points, points, c);
+    context_unbind(&b);
+}
+
+/**
+ * grx_context_draw_filled_polygon:
+ * @context: the context to draw on
+ * @n_points: the number of points in @points
+ * @points: (array length=n_points): an array of #GrxPoint
+ * @c: the color
+ *
+ * Draws a filled polygon on @context. Also see grx_draw_filled_polygon().
+ *
+ * Unlike the functions for the current context, this can be called from any
+ * thread.
+ */
+void grx_context_draw_filled_polygon(GrxContext *context, gint n_points, GrxPoint *points,
+                                     GrxColor c)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_draw_filled_polygon(n_points, points, c);
+    context_unbind(&b);
+}
+
+/**
+ * grx_context_draw_ellipse:
+ * @context: the context to draw on
+ * @xc: the X coordinate of the center of the ellipse
+ * @yc: the Y coordinate of the center of the ellipse
+ * @rx: the radius in the X direction
+ * @ry: the radius in the Y direction
+ * @c: the color
+ *
+ * Draws the outline of an ellipse on @context. Also see grx_draw_ellipse().
+ *
+ * Unlike the functions for the current context, this can be called from any
+ * thread.
+ */
+void grx_context_draw_ellipse(GrxContext *context, gint xc, gint yc, gint rx, gint ry,
+                              GrxColor c)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_draw_ellipse(xc, yc, rx, ry, c);
+    context_unbind(&b);
+}
+
+/**
+ * grx_context_draw_filled_ellipse:
+ * @context: the context to draw on
+ * @xc: the X coordinate of the center of the ellipse
+ * @yc: the Y coordinate of the center of the ellipse
+ * @rx: the radius in the X direction
+ * @ry: the radius in the Y direction
+ * @c: the color
+ *
+ * Draws a filled ellipse on @context. Also see grx_draw_filled_ellipse().
+ *
+ * Unlike the functions for the current context, this can be called from any
+ * thread.
+ */
+void grx_context_draw_filled_ellipse(GrxContext *context, gint xc, gint yc, gint rx, gint ry,
+                                     GrxColor c)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_draw_filled_ellipse(xc, yc, rx, ry, c);
+    context_unbind(&b);
+}
+
+/**
+ * grx_context_put_scanline:
+ * @context: the context to draw on
+ * @x1: the starting X coordinate
+ * @x2: the ending X coordinate
+ * @y: the Y coordinate
+ * @scan_line: (array): the colors of the pixels
+ * @op: the #GrxColorMode operator
+ *
+ * Writes a row of pixels to @context. Also see grx_put_scanline().
+ *
+ * Unlike the functions for the current context, this can be called from any
+ * thread.
+ */
+void grx_context_put_scanline(GrxContext *context, gint x1, gint x2, gint y,
+                              const GrxColor *scan_line, GrxColor op)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_put_scanline(x1, x2, y, scan_line, op);
+    context_unbind(&b);
+}
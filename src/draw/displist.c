@@ -0,0 +1,435 @@
+/*
+ * displist.c ---- recorded drawing commands that can be replayed
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <glib-object.h>
+
+#include <grx/context.h>
+#include <grx/display_list.h>
+#include <grx/draw.h>
+
+#include "globals.h"
+#include "libgrx.h"
+#include "drawlist.h"
+
+struct _GrxDisplayList {
+    _GR_drawList list;
+    guint        ref_count;
+};
+
+G_DEFINE_BOXED_TYPE(GrxDisplayList, grx_display_list, grx_display_list_ref, grx_display_list_unref);
+
+/**
+ * grx_display_list_new:
+ *
+ * Creates an empty display list. Commands are recorded with the
+ * grx_display_list_draw_*() and grx_display_list_add_*() functions and drawn
+ * by grx_display_list_replay().
+ *
+ * Returns: (transfer full): the new display list
+ */
+GrxDisplayList *grx_display_list_new(void)
+{
+    GrxDisplayList *l;
+
+    l = g_malloc0(sizeof(*l));
+    _GrDrawListInit(&l->list);
+
+    return grx_display_list_ref(l);
+}
+
+/**
+ * grx_display_list_ref:
+ * @list: the display list
+ *
+ * Increases the reference count of @list.
+ *
+ * Returns: (transfer full): @list
+ */
+GrxDisplayList *grx_display_list_ref(GrxDisplayList *list)
+{
+    g_return_val_if_fail(list != NULL, NULL);
+
+    list->ref_count++;
+
+    return list;
+}
+
+/**
+ * grx_display_list_unref:
+ * @list: (transfer full): the display list
+ *
+ * Decreases the reference count of @list. When it reaches 0, @list is freed.
+ */
+void grx_display_list_unref(GrxDisplayList *list)
+{
+    g_return_if_fail(list != NULL);
+    g_return_if_fail(list->ref_count > 0);
+
+    list->ref_count--;
+    if (list->ref_count == 0) {
+        _GrDrawListFree(&list->list);
+        g_free(list);
+    }
+}
+
+/**
+ * grx_display_list_clear:
+ * @list: the display list
+ *
+ * Forgets all of the recorded commands. The memory of the buffers is kept
+ * for recording the next scene.
+ */
+void grx_display_list_clear(GrxDisplayList *list)
+{
+    g_return_if_fail(list != NULL);
+
+    _GrDrawListClear(&list->list);
+}
+
+/**
+ * grx_display_list_get_length:
+ * @list: the display list
+ *
+ * Gets the number of recorded commands. Each call of a grx_display_list_add_*()
+ * function is one command, no matter how many items it adds.
+ *
+ * Returns: the number of commands
+ */
+guint grx_display_list_get_length(GrxDisplayList *list)
+{
+    g_return_val_if_fail(list != NULL, 0);
+
+    return draw_list_len(&list->list);
+}
+
+/**
+ * grx_display_list_draw_pixel:
+ * @list: the display list
+ * @x: the X coordinate
+ * @y: the Y coordinate
+ * @c: the color
+ *
+ * Records a grx_draw_pixel() call.
+ */
+void grx_display_list_draw_pixel(GrxDisplayList *list, gint x, gint y, GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+
+    _GrDrawListAdd(&list->list, DRAW_CMD_PIXEL, x, y, x, y, c);
+}
+
+/**
+ * grx_display_list_draw_line:
+ * @list: the display list
+ * @x1: starting X coordinate
+ * @y1: starting Y coordinate
+ * @x2: ending X coordinate
+ * @y2: ending Y coordinate
+ * @c: the color
+ *
+ * Records a grx_draw_line() call.
+ */
+void grx_display_list_draw_line(GrxDisplayList *list, gint x1, gint y1, gint x2, gint y2,
+                                GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+
+    _GrDrawListAdd(&list->list, DRAW_CMD_LINE, x1, y1, x2, y2, c);
+}
+
+/**
+ * grx_display_list_draw_box:
+ * @list: the display list
+ * @x1: the left X coordinate
+ * @y1: the top Y coordinate
+ * @x2: the right X coordinate
+ * @y2: the bottom Y coordinate
+ * @c: the color
+ *
+ * Records a grx_draw_box() call.
+ */
+void grx_display_list_draw_box(GrxDisplayList *list, gint x1, gint y1, gint x2, gint y2,
+                               GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+
+    _GrDrawListAdd(&list->list, DRAW_CMD_BOX, x1, y1, x2, y2, c);
+}
+
+/**
+ * grx_display_list_draw_filled_box:
+ * @list: the display list
+ * @x1: the left X coordinate
+ * @y1: the top Y coordinate
+ * @x2: the right X coordinate
+ * @y2: the bottom Y coordinate
+ * @c: the color
+ *
+ * Records a grx_draw_filled_box() call.
+ */
+void grx_display_list_draw_filled_box(GrxDisplayList *list, gint x1, gint y1, gint x2, gint y2,
+                                      GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+
+    _GrDrawListAdd(&list->list, DRAW_CMD_FILLED_BOX, x1, y1, x2, y2, c);
+}
+
+/**
+ * grx_display_list_draw_polyline:
+ * @list: the display list
+ * @n_points: the number of points in @points
+ * @points: (array length=n_points): an array of #GrxPoint
+ * @c: the color
+ *
+ * Records a grx_draw_polyline() call. The points are copied.
+ */
+void grx_display_list_draw_polyline(GrxDisplayList *list, gint n_points, GrxPoint *points,
+                                    GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+    g_return_if_fail(points != NULL || n_points <= 0);
+
+    _GrDrawListAddPoints(&list->list, DRAW_CMD_POLYLINE, n_points, points, c);
+}
+
+/**
+ * grx_display_list_draw_polygon:
+ * @list: the display list
+ * @n_points: the number of points in @points
+ * @points: (array length=n_points): an array of #GrxPoint
+ * @c: the color
+ *
+ * Records a grx_draw_polygon() call. The points are copied.
+ */
+void grx_display_list_draw_polygon(GrxDisplayList *list, gint n_points, GrxPoint *points,
+                                   GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+    g_return_if_fail(points != NULL || n_points <= 0);
+
+    _GrDrawListAddPoints(&list->list, DRAW_CMD_POLYGON, n_points, points, c);
+}
+
+/**
+ * grx_display_list_draw_filled_polygon:
+ * @list: the display list
+ * @n_points: the number of points in @points
+ * @points: (array length=n_points): an array of #GrxPoint
+ * @c: the color
+ *
+ * Records a grx_draw_filled_polygon() call. The points are copied.
+ */
+void grx_display_list_draw_filled_polygon(GrxDisplayList *list, gint n_points,
+                                          GrxPoint *points, GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+    g_return_if_fail(points != NULL || n_points <= 0);
+
+    _GrDrawListAddPoints(&list->list, DRAW_CMD_FILLED_POLYGON, n_points, points, c);
+}
+
+/**
+ * grx_display_list_draw_ellipse:
+ * @list: the display list
+ * @xc: the X coordinate of the center of the ellipse
+ * @yc: the Y coordinate of the center of the ellipse
+ * @rx: the radius in the X direction
+ * @ry: the radius in the Y direction
+ * @c: the color
+ *
+ * Records a grx_draw_ellipse() call.
+ */
+void grx_display_list_draw_ellipse(GrxDisplayList *list, gint xc, gint yc, gint rx, gint ry,
+                                   GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+
+    _GrDrawListAdd(&list->list, DRAW_CMD_ELLIPSE, xc, yc, rx, ry, c);
+}
+
+/**
+ * grx_display_list_draw_filled_ellipse:
+ * @list: the display list
+ * @xc: the X coordinate of the center of the ellipse
+ * @yc: the Y coordinate of the center of the ellipse
+ * @rx: the radius in the X direction
+ * @ry: the radius in the Y direction
+ * @c: the color
+ *
+ * Records a grx_draw_filled_ellipse() call.
+ */
+void grx_display_list_draw_filled_ellipse(GrxDisplayList *list, gint xc, gint yc,
+                                          gint rx, gint ry, GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+
+    _GrDrawListAdd(&list->list, DRAW_CMD_FILLED_ELLIPSE, xc, yc, rx, ry, c);
+}
+
+/**
+ * grx_display_list_draw_text:
+ * @list: the display list
+ * @text: the text to draw
+ * @x: the x coordinate
+ * @y: the y coordinate
+ * @options: #GrxTextOptions to control how the text is drawn
+ *
+ * Records a grx_draw_text() call. The text is copied and a reference to
+ * @options is kept, so changes to @options show up in later replays.
+ */
+void grx_display_list_draw_text(GrxDisplayList *list, const gchar *text, gint x, gint y,
+                                GrxTextOptions *options)
+{
+    g_return_if_fail(list != NULL);
+    g_return_if_fail(text != NULL);
+    g_return_if_fail(options != NULL);
+
+    _GrDrawListAddText(&list->list, text, x, y, options);
+}
+
+/**
+ * grx_display_list_bit_blt:
+ * @list: the display list
+ * @x: destination X coordinate
+ * @y: destination Y coordinate
+ * @src: the source context
+ * @x1: the source left X coordinate
+ * @y1: the source top Y coordinate
+ * @x2: the source right X coordinate
+ * @y2: the source bottom Y coordinate
+ * @op: the color operation
+ *
+ * Records a grx_context_bit_blt() call to the context of the replay. A
+ * reference to @src is kept and its pixels are read when the list is
+ * replayed, not when the call is recorded.
+ */
+void grx_display_list_bit_blt(GrxDisplayList *list, gint x, gint y, GrxContext *src,
+                              gint x1, gint y1, gint x2, gint y2, GrxColor op)
+{
+    g_return_if_fail(list != NULL);
+    g_return_if_fail(src != NULL);
+
+    _GrDrawListAddBitBlt(&list->list, x, y, src, x1, y1, x2, y2, op);
+}
+
+/* checks the packed arrays and adds them as one bulk command */
+static void add_bulk(GrxDisplayList *list, _GR_drawCmdType type, guint item_points,
+                     GBytes *points, GBytes *colors, GrxColor c)
+{
+    gsize size, item_size = item_points * sizeof(GrxPoint);
+    const GrxColor *colordata = NULL;
+    const GrxPoint *pointdata;
+    guint n;
+
+    pointdata = g_bytes_get_data(points, &size);
+    g_return_if_fail(size % item_size == 0);
+    n = size / item_size;
+    if (colors) {
+        colordata = g_bytes_get_data(colors, &size);
+        g_return_if_fail(size == n * sizeof(GrxColor));
+    }
+    if (n == 0) {
+        return;
+    }
+
+    _GrDrawListAddBulk(&list->list, type, n, pointdata, colordata, c);
+}
+
+/**
+ * grx_display_list_add_pixels:
+ * @list: the display list
+ * @points: packed #GrxPoint coordinates, two #gint each
+ * @colors: (nullable): packed #GrxColor values, one for each point
+ * @c: the color of all of the points when @colors is %NULL
+ *
+ * Records many pixels as one command. The arrays are copied. On replay, the
+ * pixels are clipped and written to the frame driver one by one without
+ * the overhead of a grx_draw_pixel() call for each.
+ */
+void grx_display_list_add_pixels(GrxDisplayList *list, GBytes *points, GBytes *colors,
+                                 GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+    g_return_if_fail(points != NULL);
+
+    add_bulk(list, DRAW_CMD_PIXELS, 1, points, colors, c);
+}
+
+/**
+ * grx_display_list_add_lines:
+ * @list: the display list
+ * @points: packed #GrxPoint coordinates, the two end points of each line
+ * @colors: (nullable): packed #GrxColor values, one for each line
+ * @c: the color of all of the lines when @colors is %NULL
+ *
+ * Records many separate lines as one command. The arrays are copied.
+ */
+void grx_display_list_add_lines(GrxDisplayList *list, GBytes *points, GBytes *colors,
+                                GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+    g_return_if_fail(points != NULL);
+
+    add_bulk(list, DRAW_CMD_LINES, 2, points, colors, c);
+}
+
+/**
+ * grx_display_list_add_filled_boxes:
+ * @list: the display list
+ * @points: packed #GrxPoint coordinates, two opposite corners of each box
+ * @colors: (nullable): packed #GrxColor values, one for each box
+ * @c: the color of all of the boxes when @colors is %NULL
+ *
+ * Records many filled boxes as one command. The arrays are copied.
+ */
+void grx_display_list_add_filled_boxes(GrxDisplayList *list, GBytes *points, GBytes *colors,
+                                       GrxColor c)
+{
+    g_return_if_fail(list != NULL);
+    g_return_if_fail(points != NULL);
+
+    add_bulk(list, DRAW_CMD_FILLED_BOXES, 2, points, colors, c);
+}
+
+/**
+ * grx_display_list_replay:
+ * @list: the display list
+ * @context: (nullable): the context to draw on or %NULL for the current context
+ *
+ * Draws all of the recorded commands in the order they were recorded. The
+ * commands are kept, so the list can be replayed again.
+ *
+ * When @context is given, this can be called from any thread, like the
+ * grx_context_draw_*() functions.
+ */
+void grx_display_list_replay(GrxDisplayList *list, GrxContext *context)
+{
+    _GR_contextBinding b;
+    guint i;
+
+    g_return_if_fail(list != NULL);
+
+    if (context) {
+        context_bind(&b, context);
+    }
+    for (i = 0; i < draw_list_len(&list->list); i++) {
+        _GrDrawCmdRun(&list->list, draw_list_cmd(&list->list, i));
+    }
+    if (context) {
+        context_unbind(&b);
+    }
+}
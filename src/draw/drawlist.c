@@ -0,0 +1,353 @@
+/*
+ * drawlist.c ---- recorded drawing commands
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <string.h>
+
+#include <grx/draw.h>
+#include <grx/text.h>
+
+#include "globals.h"
+#include "libgrx.h"
+#include "arith.h"
+#include "drawlist.h"
+
+/* _GrScanEllipse() draws larger ellipses as polygons of short lines */
+#define ELLIPSE_SCAN_MAX_R  120
+
+void _GrDrawListInit(_GR_drawList *l)
+{
+    l->cmds   = g_array_new(FALSE, FALSE, sizeof(_GR_drawCmd));
+    l->points = g_array_new(FALSE, FALSE, sizeof(GrxPoint));
+    l->colors = g_array_new(FALSE, FALSE, sizeof(GrxColor));
+    l->text   = g_string_new(NULL);
+}
+
+void _GrDrawListClear(_GR_drawList *l)
+{
+    guint i;
+
+    for (i = 0; i < l->cmds->len; i++) {
+        _GR_drawCmd *cmd = draw_list_cmd(l, i);
+        if (cmd->options) {
+            grx_text_options_unref(cmd->options);
+        }
+        if (cmd->src) {
+            grx_context_unref(cmd->src);
+        }
+    }
+    g_array_set_size(l->cmds, 0);
+    g_array_set_size(l->points, 0);
+    g_array_set_size(l->colors, 0);
+    g_string_truncate(l->text, 0);
+}
+
+void _GrDrawListFree(_GR_drawList *l)
+{
+    _GrDrawListClear(l);
+    g_array_unref(l->cmds);
+    g_array_unref(l->points);
+    g_array_unref(l->colors);
+    g_string_free(l->text, TRUE);
+}
+
+_GR_drawCmd *_GrDrawListAdd(_GR_drawList *l, _GR_drawCmdType type,
+                            gint x1, gint y1, gint x2, gint y2, GrxColor c)
+{
+    _GR_drawCmd *cmd;
+
+    g_array_set_size(l->cmds, l->cmds->len + 1);
+    cmd = draw_list_cmd(l, l->cmds->len - 1);
+    cmd->type    = type;
+    cmd->color   = c;
+    cmd->x1      = x1;
+    cmd->y1      = y1;
+    cmd->x2      = x2;
+    cmd->y2      = y2;
+    cmd->first   = 0;
+    cmd->count   = 0;
+    cmd->colors  = DRAW_CMD_ONE_COLOR;
+    cmd->options = NULL;
+    cmd->src     = NULL;
+
+    return cmd;
+}
+
+_GR_drawCmd *_GrDrawListAddPoints(_GR_drawList *l, _GR_drawCmdType type,
+                                  gint n, const GrxPoint *points, GrxColor c)
+{
+    _GR_drawCmd *cmd = _GrDrawListAdd(l, type, 0, 0, 0, 0, c);
+
+    cmd->first = l->points->len;
+    cmd->count = MAX(n, 0);
+    g_array_append_vals(l->points, points, cmd->count);
+
+    return cmd;
+}
+
+/* points per item of the bulk commands */
+static guint bulk_points(_GR_drawCmdType type)
+{
+    return (type == DRAW_CMD_PIXELS) ? 1 : 2;
+}
+
+/*
+ * _GrDrawListAddBulk:
+ *
+ * Records n pixels, lines or filled boxes in one command. If colors is NULL
+ * all of them are drawn with c.
+ */
+_GR_drawCmd *_GrDrawListAddBulk(_GR_drawList *l, _GR_drawCmdType type,
+                                gint n, const GrxPoint *points,
+                                const GrxColor *colors, GrxColor c)
+{
+    _GR_drawCmd *cmd = _GrDrawListAdd(l, type, 0, 0, 0, 0, c);
+
+    cmd->first = l->points->len;
+    cmd->count = MAX(n, 0);
+    g_array_append_vals(l->points, points, cmd->count * bulk_points(type));
+    if (colors && cmd->count) {
+        cmd->colors = l->colors->len;
+        g_array_append_vals(l->colors, colors, cmd->count);
+    }
+
+    return cmd;
+}
+
+_GR_drawCmd *_GrDrawListAddBitBlt(_GR_drawList *l, gint x, gint y,
+                                  GrxContext *src, gint x1, gint y1,
+                                  gint x2, gint y2, GrxColor op)
+{
+    GrxPoint box[2] = { { x1, y1 }, { x2, y2 } };
+    _GR_drawCmd *cmd = _GrDrawListAddPoints(l, DRAW_CMD_BIT_BLT, 2, box, op);
+
+    isort(box[0].x, box[1].x);
+    isort(box[0].y, box[1].y);
+    cmd->x1  = x;
+    cmd->y1  = y;
+    cmd->x2  = x + box[1].x - box[0].x;
+    cmd->y2  = y + box[1].y - box[0].y;
+    cmd->src = grx_context_ref(src);
+
+    return cmd;
+}
+
+_GR_drawCmd *_GrDrawListAddText(_GR_drawList *l, const gchar *text,
+                                gint x, gint y, GrxTextOptions *options)
+{
+    _GR_drawCmd *cmd = _GrDrawListAdd(l, DRAW_CMD_TEXT, x, y, x, y, 0);
+
+    cmd->first   = l->text->len;
+    cmd->count   = strlen(text);
+    cmd->options = grx_text_options_ref(options);
+    g_string_append_len(l->text, text, cmd->count + 1);
+
+    return cmd;
+}
+
+#define cmd_points(l,cmd)   (&g_array_index((l)->points, GrxPoint, (cmd)->first))
+
+static void points_bounds(const GrxPoint *pt, guint n,
+                          gint *x1, gint *y1, gint *x2, gint *y2)
+{
+    guint i;
+
+    if (n == 0) {
+        *x1 = *y1 = 0;
+        *x2 = *y2 = -1;
+        return;
+    }
+    *x1 = *x2 = pt[0].x;
+    *y1 = *y2 = pt[0].y;
+    for (i = 1; i < n; i++) {
+        *x1 = imin(*x1, pt[i].x);
+        *y1 = imin(*y1, pt[i].y);
+        *x2 = imax(*x2, pt[i].x);
+        *y2 = imax(*y2, pt[i].y);
+    }
+}
+
+/*
+ * _GrDrawCmdBounds:
+ *
+ * Gets a box that contains every pixel the command can draw. For text this
+ * is a guess from the font size that errs on the large side.
+ */
+void _GrDrawCmdBounds(const _GR_drawList *l, const _GR_drawCmd *cmd,
+                      gint *x1, gint *y1, gint *x2, gint *y2)
+{
+    switch (cmd->type) {
+    case DRAW_CMD_POLYLINE:
+    case DRAW_CMD_POLYGON:
+    case DRAW_CMD_FILLED_POLYGON:
+        points_bounds(cmd_points(l, cmd), cmd->count, x1, y1, x2, y2);
+        return;
+    case DRAW_CMD_PIXELS:
+    case DRAW_CMD_LINES:
+    case DRAW_CMD_FILLED_BOXES:
+        points_bounds(cmd_points(l, cmd), cmd->count * bulk_points(cmd->type),
+                      x1, y1, x2, y2);
+        return;
+    case DRAW_CMD_ELLIPSE:
+    case DRAW_CMD_FILLED_ELLIPSE:
+        *x1 = cmd->x1 - iabs(cmd->x2);
+        *y1 = cmd->y1 - iabs(cmd->y2);
+        *x2 = cmd->x1 + iabs(cmd->x2);
+        *y2 = cmd->y1 + iabs(cmd->y2);
+        return;
+    case DRAW_CMD_TEXT: {
+        // any alignment, plus overhanging glyphs
+        GrxFont *font = grx_text_options_get_font(cmd->options);
+        gint w = grx_font_get_text_width(font, &l->text->str[cmd->first]);
+        gint h = grx_font_get_height(font);
+        *x1 = cmd->x1 - w - h;
+        *y1 = cmd->y1 - h - h;
+        *x2 = cmd->x1 + w + h;
+        *y2 = cmd->y1 + h + h;
+        return;
+    }
+    default:
+        *x1 = imin(cmd->x1, cmd->x2);
+        *y1 = imin(cmd->y1, cmd->y2);
+        *x2 = imax(cmd->x1, cmd->x2);
+        *y2 = imax(cmd->y1, cmd->y2);
+        return;
+    }
+}
+
+static gboolean points_straight(const GrxPoint *pt, guint n, gboolean closed)
+{
+    guint i;
+
+    for (i = 1; i < n; i++) {
+        if (pt[i].x != pt[i-1].x && pt[i].y != pt[i-1].y) {
+            return FALSE;
+        }
+    }
+    if (closed && n > 1 && pt[0].x != pt[n-1].x && pt[0].y != pt[n-1].y) {
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*
+ * _GrDrawCmdClipExact:
+ *
+ * Tells if narrowing the X range of the clip box only takes away pixels of
+ * the command without moving any of the others. Sloped lines are clipped by
+ * moving their end points, which can shift the pixels of the rest of the
+ * line, so those have to be drawn with the real clip box. The fills only
+ * clip their spans in X.
+ */
+gboolean _GrDrawCmdClipExact(const _GR_drawList *l, const _GR_drawCmd *cmd)
+{
+    switch (cmd->type) {
+    case DRAW_CMD_LINE:
+        return (cmd->x1 == cmd->x2) || (cmd->y1 == cmd->y2);
+    case DRAW_CMD_POLYLINE:
+        return points_straight(cmd_points(l, cmd), cmd->count, FALSE);
+    case DRAW_CMD_POLYGON:
+        return points_straight(cmd_points(l, cmd), cmd->count, TRUE);
+    case DRAW_CMD_LINES: {
+        const GrxPoint *pt = cmd_points(l, cmd);
+        guint i;
+        for (i = 0; i < cmd->count; i++, pt += 2) {
+            if (!points_straight(pt, 2, FALSE)) {
+                return FALSE;
+            }
+        }
+        return TRUE;
+    }
+    case DRAW_CMD_BIT_BLT:
+        // the source may be the destination itself
+        return FALSE;
+    case DRAW_CMD_ELLIPSE:
+        return (iabs(cmd->x2) <= ELLIPSE_SCAN_MAX_R) &&
+               (iabs(cmd->y2) <= ELLIPSE_SCAN_MAX_R);
+    default:
+        return TRUE;
+    }
+}
+
+/* runs a bulk command with one of the grx_draw_*() functions for arrays */
+static void run_bulk(const _GR_drawList *l, const _GR_drawCmd *cmd,
+                     void (*draw)(gint, const GrxPoint *, gint, const GrxColor *))
+{
+    const GrxColor *colors = &cmd->color;
+    gint n_colors = 1;
+
+    if (cmd->colors != DRAW_CMD_ONE_COLOR) {
+        colors = &g_array_index(l->colors, GrxColor, cmd->colors);
+        n_colors = cmd->count;
+    }
+    (*draw)(cmd->count * bulk_points(cmd->type), cmd_points(l, cmd), n_colors, colors);
+}
+
+/*
+ * _GrDrawCmdRun:
+ *
+ * Draws the command on the current context.
+ */
+void _GrDrawCmdRun(const _GR_drawList *l, const _GR_drawCmd *cmd)
+{
+    switch (cmd->type) {
+    case DRAW_CMD_PIXEL:
+        grx_draw_pixel(cmd->x1, cmd->y1, cmd->color);
+        break;
+    case DRAW_CMD_LINE:
+        grx_draw_line(cmd->x1, cmd->y1, cmd->x2, cmd->y2, cmd->color);
+        break;
+    case DRAW_CMD_BOX:
+        grx_draw_box(cmd->x1, cmd->y1, cmd->x2, cmd->y2, cmd->color);
+        break;
+    case DRAW_CMD_FILLED_BOX:
+        grx_draw_filled_box(cmd->x1, cmd->y1, cmd->x2, cmd->y2, cmd->color);
+        break;
+    case DRAW_CMD_POLYLINE:
+        grx_draw_polyline(cmd->count, cmd_points(l, cmd), cmd->color);
+        break;
+    case DRAW_CMD_POLYGON:
+        grx_draw_polygon(cmd->count, cmd_points(l, cmd), cmd->color);
+        break;
+    case DRAW_CMD_FILLED_POLYGON:
+        grx_draw_filled_polygon(cmd->count, cmd_points(l, cmd), cmd->color);
+        break;
+    case DRAW_CMD_ELLIPSE:
+        grx_draw_ellipse(cmd->x1, cmd->y1, cmd->x2, cmd->y2, cmd->color);
+        break;
+    case DRAW_CMD_FILLED_ELLIPSE:
+        grx_draw_filled_ellipse(cmd->x1, cmd->y1, cmd->x2, cmd->y2, cmd->color);
+        break;
+    case DRAW_CMD_TEXT:
+        grx_draw_text(&l->text->str[cmd->first], cmd->x1, cmd->y1, cmd->options);
+        break;
+    case DRAW_CMD_BIT_BLT: {
+        const GrxPoint *box = cmd_points(l, cmd);
+        grx_context_bit_blt(CURC, cmd->x1, cmd->y1, cmd->src,
+                            box[0].x, box[0].y, box[1].x, box[1].y, cmd->color);
+        break;
+    }
+    case DRAW_CMD_PIXELS:
+        run_bulk(l, cmd, grx_draw_pixels);
+        break;
+    case DRAW_CMD_LINES:
+        run_bulk(l, cmd, grx_draw_lines);
+        break;
+    case DRAW_CMD_FILLED_BOXES:
+        run_bulk(l, cmd, grx_draw_filled_boxes);
+        break;
+    }
+}
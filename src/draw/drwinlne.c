@@ -20,6 +20,7 @@
 #include <grx/draw_nc.h>
 #include <grx/mode.h>
 
+#include "globals.h"
 #include "libgrx.h"
 
 /**
@@ -18,6 +18,7 @@
 #include "globals.h"
 #include "libgrx.h"
 #include "clipping.h"
+#include "damage.h"
 
 /**
  * grx_fast_draw_filled_box:
@@ -36,6 +37,7 @@
  */
 void grx_fast_draw_filled_box(int x1,int y1,int x2,int y2,GrxColor c)
 {
+        damage_add(CURC,x1,y1,x2,y2);
         (*FDRV->drawblock)(
             x1 + CURC->x_offset,
             y1 + CURC->y_offset,
@@ -19,6 +19,7 @@
 #include <grx/draw.h>
 
 #include <stdlib.h>
+#include "globals.h"
 #include "libgrx.h"
 
 /**
@@ -124,11 +125,10 @@ void grx_context_flood_spill(GrxContext *ctx, int x1, int y1, int x2, int y2,
 {
   int y;
   int x;
-  GrxContext ctx_save;
+  _GR_contextBinding b;
   GrxColor *scanline;
 
-  grx_save_current_context(&ctx_save);
-  grx_set_current_context(ctx);
+  context_bind(&b,ctx);
 
   for(y = y1; y <= y2; ++y)
   {
@@ -142,7 +142,7 @@ void grx_context_flood_spill(GrxContext *ctx, int x1, int y1, int x2, int y2,
       grx_put_scanline(x1, x2, y, scanline, GRX_COLOR_MODE_WRITE);
     }
   }
-  grx_set_current_context(&ctx_save);
+  context_unbind(&b);
 }
 
 /**
@@ -172,11 +172,10 @@ void grx_context_flood_spill2(GrxContext *ctx, int x1, int y1, int x2, int y2,
 {
   int y;
   int x;
-  GrxContext ctx_save;
+  _GR_contextBinding b;
   GrxColor *scanline;
 
-  grx_save_current_context(&ctx_save);
-  grx_set_current_context(ctx);
+  context_bind(&b,ctx);
 
   for(y = y1; y <= y2; ++y)
   {
@@ -192,5 +191,5 @@ void grx_context_flood_spill2(GrxContext *ctx, int x1, int y1, int x2, int y2,
       grx_put_scanline(x1, x2, y, scanline, GRX_COLOR_MODE_WRITE);
     }
   }
-  grx_set_current_context(&ctx_save);
+  context_unbind(&b);
 }
@@ -18,6 +18,7 @@
 #include <grx/draw.h>
 #include <grx/draw_nc.h>
 
+#include "globals.h"
 #include "libgrx.h"
 #include "clipping.h"
 
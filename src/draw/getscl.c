@@ -42,7 +42,7 @@ const GrxColor *grx_context_get_scanline(GrxContext *ctx,int x1,int x2,int yy,un
         if (ctx == NULL) ctx = CURC;
         /* don't accept any clipping .... */
         clip_hline_(ctx,x1,x2,yy,goto done,goto done);
-        mouse_block(ctx,x1,yy,x2,yy);
+        mouse_block_read(ctx,x1,yy,x2,yy);
         res = (*ctx->gc_driver->getindexedscanline)(
             &ctx->frame,
             x1 + ctx->x_offset,
@@ -18,6 +18,7 @@
 #include "globals.h"
 #include "libgrx.h"
 #include "clipping.h"
+#include "damage.h"
 
 /**
  * grx_fast_draw_line:
@@ -39,6 +40,7 @@
  */
 void grx_fast_draw_line(int x1,int y1,int x2,int y2,GrxColor c)
 {
+        damage_add(CURC,x1,y1,x2,y2);
         (*FDRV->drawline)(
             x1 + CURC->x_offset,
             y1 + CURC->y_offset,
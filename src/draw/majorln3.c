@@ -18,6 +18,7 @@
 #include "globals.h"
 #include "libgrx.h"
 #include "clipping.h"
+#include "damage.h"
 
 /**
  * grx_fast_draw_hline:
@@ -38,6 +39,7 @@
 void grx_fast_draw_hline(int x1,int x2,int yy,GrxColor c)
 {
         isort(x1,x2);
+        damage_add(CURC,x1,yy,x2,yy);
         (*FDRV->drawhline)(
             x1 + CURC->x_offset,
             yy + CURC->y_offset,
@@ -18,6 +18,7 @@
 #include "globals.h"
 #include "libgrx.h"
 #include "clipping.h"
+#include "damage.h"
 
 /**
  * grx_fast_draw_vline:
@@ -38,6 +39,7 @@
 void grx_fast_draw_vline(int xx,int y1,int y2,GrxColor c)
 {
         isort(y1,y2);
+        damage_add(CURC,xx,y1,xx,y2);
         (*FDRV->drawvline)(
             xx + CURC->x_offset,
             y1 + CURC->y_offset,
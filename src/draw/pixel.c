@@ -32,7 +32,7 @@ GrxColor grx_get_pixel_at(int x,int y)
 {
         GrxColor retval;
         cxclip_dot_(CURC,x,y,return(GRX_COLOR_NONE));
-        mouse_block(CURC,x,y,x,y);
+        mouse_block_read(CURC,x,y,x,y);
         retval = (*FDRV->readpixel)(
             &CURC->frame,
             x + CURC->x_offset,
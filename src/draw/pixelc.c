@@ -34,7 +34,7 @@ GrxColor grx_context_get_pixel_at(GrxContext *c,int x,int y)
 {
         GrxColor retval;
         cxclip_dot_(c,x,y,return(GRX_COLOR_NONE));
-        mouse_block(c,x,y,x,y);
+        mouse_block_read(c,x,y,x,y);
         retval = (*c->gc_driver->readpixel)(
             &c->frame,
             x + c->x_offset,
@@ -0,0 +1,502 @@
+/*
+ * tiles.c ---- drawing large contexts on several threads
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * The tiles are full height columns of the context. Every tile is drawn
+ * through a copy of the context whose clip box is narrowed to the tile, so
+ * only the X clipping differs from drawing the whole context. Fills, boxes,
+ * text and straight lines come out the same with any X clip range. A sloped
+ * line is clipped by moving its end points, so one that crosses tiles is
+ * drawn on its own with the real clip box after everything recorded before
+ * it, and the tiles carry on after it.
+ */
+
+#include <glib-object.h>
+
+#include <grx/context.h>
+#include <grx/draw.h>
+#include <grx/tiles.h>
+
+#include "globals.h"
+#include "libgrx.h"
+#include "arith.h"
+#include "drawlist.h"
+
+/* tiles start on multiples of this many frame pixels, so that no byte (or
+ * word written by the span fills) of the frame is shared by two tiles */
+#define TILE_ALIGN          64
+/* for the automatic tile width: tiles per thread, for load balancing */
+#define TILES_PER_THREAD    4
+
+struct _GrxTileBatch {
+    GrxContext  *context;
+    gint         tile_width;    /* requested width, 0 for automatic */
+    gint         n_threads;
+    _GR_drawList list;
+    GThreadPool *pool;          /* created on the first render */
+    guint        ref_count;
+
+    /* state of the render in progress */
+    gint         width;         /* tile width */
+    gint         x0;            /* frame X coordinate of the first tile */
+    gint         n_tiles;
+    GArray     **bins;          /* command indices for each tile */
+    guint       *next;          /* next bin entry to draw for each tile */
+    guint        end;           /* draw the commands before this one */
+    gint         next_tile;     /* tile to be claimed next */
+    gint         n_busy;        /* worker threads still drawing */
+    GMutex       lock;
+    GCond        done;
+};
+
+G_DEFINE_BOXED_TYPE(GrxTileBatch, grx_tile_batch, grx_tile_batch_ref, grx_tile_batch_unref);
+
+static void draw_tile(GrxTileBatch *b, gint t)
+{
+    GArray *bin = b->bins[t];
+    guint k = b->next[t];
+    GrxContext tile;
+    _GR_contextBinding cb;
+    gint x1, x2;
+
+    if (k >= bin->len || g_array_index(bin, guint, k) >= b->end) {
+        return;
+    }
+    x1 = b->x0 + t * b->width - b->context->x_offset;
+    x2 = x1 + b->width - 1;
+    tile = *b->context;
+    grx_context_set_clip_box(&tile,
+        imax(x1, b->context->x_clip_low), b->context->y_clip_low,
+        imin(x2, b->context->x_clip_high), b->context->y_clip_high);
+    context_bind(&cb, &tile);
+    for (; k < bin->len; k++) {
+        guint i = g_array_index(bin, guint, k);
+        if (i >= b->end) {
+            break;
+        }
+        _GrDrawCmdRun(&b->list, draw_list_cmd(&b->list, i));
+    }
+    context_unbind(&cb);
+    b->next[t] = k;
+}
+
+static void draw_tiles(GrxTileBatch *b)
+{
+    gint t;
+
+    while ((t = g_atomic_int_add(&b->next_tile, 1)) < b->n_tiles) {
+        draw_tile(b, t);
+    }
+}
+
+static void worker(gpointer data, gpointer user_data)
+{
+    GrxTileBatch *b = user_data;
+
+    draw_tiles(b);
+    g_mutex_lock(&b->lock);
+    if (--b->n_busy == 0) {
+        g_cond_signal(&b->done);
+    }
+    g_mutex_unlock(&b->lock);
+}
+
+/* draws the binned commands before b->end in all tiles at the same time */
+static void run_tiles(GrxTileBatch *b)
+{
+    gint i, n = imin(b->n_threads, b->n_tiles) - 1;
+
+    b->next_tile = 0;
+    b->n_busy = n;
+    for (i = 0; i < n; i++) {
+        g_thread_pool_push(b->pool, b, NULL);
+    }
+    draw_tiles(b);
+    g_mutex_lock(&b->lock);
+    while (b->n_busy > 0) {
+        g_cond_wait(&b->done, &b->lock);
+    }
+    g_mutex_unlock(&b->lock);
+}
+
+static void run_serial(GrxTileBatch *b, guint first, guint end)
+{
+    _GR_contextBinding cb;
+
+    context_bind(&cb, b->context);
+    for (; first < end; first++) {
+        _GrDrawCmdRun(&b->list, draw_list_cmd(&b->list, first));
+    }
+    context_unbind(&cb);
+}
+
+/**
+ * grx_tile_batch_new:
+ * @context: the context to draw on
+ * @tile_width: the width of the tiles or 0 to pick one from the number of
+ *     processors
+ *
+ * Creates a batch for drawing on @context from several threads. Commands are
+ * recorded with the grx_tile_batch_draw_*() functions and drawn by
+ * grx_tile_batch_render().
+ *
+ * The tiles are columns of the full height of @context. Their width is
+ * rounded up to a multiple of 64 pixels. Batches for a screen context draw
+ * on the calling thread only.
+ *
+ * Returns: (transfer full): the new batch
+ */
+GrxTileBatch *grx_tile_batch_new(GrxContext *context, gint tile_width)
+{
+    GrxTileBatch *b;
+
+    g_return_val_if_fail(context != NULL, NULL);
+
+    b = g_malloc0(sizeof(*b));
+    b->context = grx_context_ref(context);
+    b->tile_width = MAX(tile_width, 0);
+    b->n_threads = g_get_num_processors();
+    _GrDrawListInit(&b->list);
+    g_mutex_init(&b->lock);
+    g_cond_init(&b->done);
+
+    return grx_tile_batch_ref(b);
+}
+
+/**
+ * grx_tile_batch_ref:
+ * @batch: the batch
+ *
+ * Increases the reference count of @batch.
+ *
+ * Returns: (transfer full): @batch
+ */
+GrxTileBatch *grx_tile_batch_ref(GrxTileBatch *batch)
+{
+    g_return_val_if_fail(batch != NULL, NULL);
+
+    batch->ref_count++;
+
+    return batch;
+}
+
+/**
+ * grx_tile_batch_unref:
+ * @batch: (transfer full): the batch
+ *
+ * Decreases the reference count of @batch. When it reaches 0, @batch and
+ * any commands that were not rendered are freed.
+ */
+void grx_tile_batch_unref(GrxTileBatch *batch)
+{
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(batch->ref_count > 0);
+
+    batch->ref_count--;
+    if (batch->ref_count == 0) {
+        if (batch->pool) {
+            g_thread_pool_free(batch->pool, FALSE, TRUE);
+        }
+        _GrDrawListFree(&batch->list);
+        g_mutex_clear(&batch->lock);
+        g_cond_clear(&batch->done);
+        grx_context_unref(batch->context);
+        g_free(batch);
+    }
+}
+
+/**
+ * grx_tile_batch_draw_pixel:
+ * @batch: the batch
+ * @x: the X coordinate
+ * @y: the Y coordinate
+ * @c: the color
+ *
+ * Records a grx_draw_pixel() call.
+ */
+void grx_tile_batch_draw_pixel(GrxTileBatch *batch, gint x, gint y, GrxColor c)
+{
+    g_return_if_fail(batch != NULL);
+
+    _GrDrawListAdd(&batch->list, DRAW_CMD_PIXEL, x, y, x, y, c);
+}
+
+/**
+ * grx_tile_batch_draw_line:
+ * @batch: the batch
+ * @x1: starting X coordinate
+ * @y1: starting Y coordinate
+ * @x2: ending X coordinate
+ * @y2: ending Y coordinate
+ * @c: the color
+ *
+ * Records a grx_draw_line() call. Horizontal and vertical lines are drawn in
+ * tiles, other lines that cross tiles are drawn on one thread.
+ */
+void grx_tile_batch_draw_line(GrxTileBatch *batch, gint x1, gint y1, gint x2, gint y2,
+                              GrxColor c)
+{
+    g_return_if_fail(batch != NULL);
+
+    _GrDrawListAdd(&batch->list, DRAW_CMD_LINE, x1, y1, x2, y2, c);
+}
+
+/**
+ * grx_tile_batch_draw_box:
+ * @batch: the batch
+ * @x1: the left X coordinate
+ * @y1: the top Y coordinate
+ * @x2: the right X coordinate
+ * @y2: the bottom Y coordinate
+ * @c: the color
+ *
+ * Records a grx_draw_box() call.
+ */
+void grx_tile_batch_draw_box(GrxTileBatch *batch, gint x1, gint y1, gint x2, gint y2,
+                             GrxColor c)
+{
+    g_return_if_fail(batch != NULL);
+
+    _GrDrawListAdd(&batch->list, DRAW_CMD_BOX, x1, y1, x2, y2, c);
+}
+
+/**
+ * grx_tile_batch_draw_filled_box:
+ * @batch: the batch
+ * @x1: the left X coordinate
+ * @y1: the top Y coordinate
+ * @x2: the right X coordinate
+ * @y2: the bottom Y coordinate
+ * @c: the color
+ *
+ * Records a grx_draw_filled_box() call.
+ */
+void grx_tile_batch_draw_filled_box(GrxTileBatch *batch, gint x1, gint y1, gint x2, gint y2,
+                                    GrxColor c)
+{
+    g_return_if_fail(batch != NULL);
+
+    _GrDrawListAdd(&batch->list, DRAW_CMD_FILLED_BOX, x1, y1, x2, y2, c);
+}
+
+/**
+ * grx_tile_batch_draw_polyline:
+ * @batch: the batch
+ * @n_points: the number of points in @points
+ * @points: (array length=n_points): an array of #GrxPoint
+ * @c: the color
+ *
+ * Records a grx_draw_polyline() call. The points are copied.
+ */
+void grx_tile_batch_draw_polyline(GrxTileBatch *batch, gint n_points, GrxPoint *points,
+                                  GrxColor c)
+{
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(points != NULL || n_points <= 0);
+
+    _GrDrawListAddPoints(&batch->list, DRAW_CMD_POLYLINE, n_points, points, c);
+}
+
+/**
+ * grx_tile_batch_draw_polygon:
+ * @batch: the batch
+ * @n_points: the number of points in @points
+ * @points: (array length=n_points): an array of #GrxPoint
+ * @c: the color
+ *
+ * Records a grx_draw_polygon() call. The points are copied.
+ */
+void grx_tile_batch_draw_polygon(GrxTileBatch *batch, gint n_points, GrxPoint *points,
+                                 GrxColor c)
+{
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(points != NULL || n_points <= 0);
+
+    _GrDrawListAddPoints(&batch->list, DRAW_CMD_POLYGON, n_points, points, c);
+}
+
+/**
+ * grx_tile_batch_draw_filled_polygon:
+ * @batch: the batch
+ * @n_points: the number of points in @points
+ * @points: (array length=n_points): an array of #GrxPoint
+ * @c: the color
+ *
+ * Records a grx_draw_filled_polygon() call. The points are copied.
+ */
+void grx_tile_batch_draw_filled_polygon(GrxTileBatch *batch, gint n_points, GrxPoint *points,
+                                        GrxColor c)
+{
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(points != NULL || n_points <= 0);
+
+    _GrDrawListAddPoints(&batch->list, DRAW_CMD_FILLED_POLYGON, n_points, points, c);
+}
+
+/**
+ * grx_tile_batch_draw_ellipse:
+ * @batch: the batch
+ * @xc: the X coordinate of the center of the ellipse
+ * @yc: the Y coordinate of the center of the ellipse
+ * @rx: the radius in the X direction
+ * @ry: the radius in the Y direction
+ * @c: the color
+ *
+ * Records a grx_draw_ellipse() call.
+ */
+void grx_tile_batch_draw_ellipse(GrxTileBatch *batch, gint xc, gint yc, gint rx, gint ry,
+                                 GrxColor c)
+{
+    g_return_if_fail(batch != NULL);
+
+    _GrDrawListAdd(&batch->list, DRAW_CMD_ELLIPSE, xc, yc, rx, ry, c);
+}
+
+/**
+ * grx_tile_batch_draw_filled_ellipse:
+ * @batch: the batch
+ * @xc: the X coordinate of the center of the ellipse
+ * @yc: the Y coordinate of the center of the ellipse
+ * @rx: the radius in the X direction
+ * @ry: the radius in the Y direction
+ * @c: the color
+ *
+ * Records a grx_draw_filled_ellipse() call.
+ */
+void grx_tile_batch_draw_filled_ellipse(GrxTileBatch *batch, gint xc, gint yc, gint rx, gint ry,
+                                        GrxColor c)
+{
+    g_return_if_fail(batch != NULL);
+
+    _GrDrawListAdd(&batch->list, DRAW_CMD_FILLED_ELLIPSE, xc, yc, rx, ry, c);
+}
+
+/**
+ * grx_tile_batch_draw_text:
+ * @batch: the batch
+ * @text: the text to draw
+ * @x: the x coordinate
+ * @y: the y coordinate
+ * @options: #GrxTextOptions to control how the text is drawn
+ *
+ * Records a grx_draw_text() call. The text is copied and a reference to
+ * @options is kept until the batch is rendered, so @options should not be
+ * changed before that.
+ */
+void grx_tile_batch_draw_text(GrxTileBatch *batch, const gchar *text, gint x, gint y,
+                              GrxTextOptions *options)
+{
+    g_return_if_fail(batch != NULL);
+    g_return_if_fail(text != NULL);
+    g_return_if_fail(options != NULL);
+
+    _GrDrawListAddText(&batch->list, text, x, y, options);
+}
+
+/**
+ * grx_tile_batch_render:
+ * @batch: the batch
+ *
+ * Draws all of the recorded commands on the context of @batch and forgets
+ * them. Returns when everything is drawn.
+ *
+ * The commands are sorted into the tiles they touch and the tiles are drawn
+ * by worker threads. Nothing else may draw on the context meanwhile.
+ */
+void grx_tile_batch_render(GrxTileBatch *batch)
+{
+    GrxContext *c;
+    GArray *serial;
+    guint i, n;
+    gint t, first, last;
+
+    g_return_if_fail(batch != NULL);
+
+    c = batch->context;
+    n = draw_list_len(&batch->list);
+    if (n == 0) {
+        return;
+    }
+
+    batch->width = batch->tile_width;
+    if (batch->width == 0) {
+        batch->width = (c->x_clip_high - c->x_clip_low + 1) /
+                       (batch->n_threads * TILES_PER_THREAD);
+    }
+    batch->width = (imax(batch->width, 1) + TILE_ALIGN - 1) & ~(TILE_ALIGN - 1);
+    first = (c->x_clip_low + c->x_offset) / batch->width;
+    last = (c->x_clip_high + c->x_offset) / batch->width;
+    batch->x0 = first * batch->width;
+    batch->n_tiles = last - first + 1;
+
+    if (c->gc_is_on_screen || batch->n_threads < 2 || batch->n_tiles < 2 ||
+        c->x_clip_low > c->x_clip_high || c->y_clip_low > c->y_clip_high)
+    {
+        run_serial(batch, 0, n);
+        _GrDrawListClear(&batch->list);
+        return;
+    }
+
+    if (!batch->pool) {
+        batch->pool = g_thread_pool_new(worker, batch, batch->n_threads - 1,
+                                        FALSE, NULL);
+    }
+
+    // sort the commands into the tiles they touch
+    batch->bins = g_new(GArray *, batch->n_tiles);
+    batch->next = g_new0(guint, batch->n_tiles);
+    for (t = 0; t < batch->n_tiles; t++) {
+        batch->bins[t] = g_array_new(FALSE, FALSE, sizeof(guint));
+    }
+    serial = g_array_new(FALSE, FALSE, sizeof(guint));
+    for (i = 0; i < n; i++) {
+        _GR_drawCmd *cmd = draw_list_cmd(&batch->list, i);
+        gint x1, y1, x2, y2, t1, t2;
+
+        _GrDrawCmdBounds(&batch->list, cmd, &x1, &y1, &x2, &y2);
+        if (x2 < c->x_clip_low || x1 > c->x_clip_high ||
+            y2 < c->y_clip_low || y1 > c->y_clip_high)
+        {
+            continue;
+        }
+        t1 = (imax(x1, c->x_clip_low) + c->x_offset) / batch->width - first;
+        t2 = (imin(x2, c->x_clip_high) + c->x_offset) / batch->width - first;
+        if (t1 != t2 && !_GrDrawCmdClipExact(&batch->list, cmd)) {
+            g_array_append_val(serial, i);
+            continue;
+        }
+        for (t = t1; t <= t2; t++) {
+            g_array_append_val(batch->bins[t], i);
+        }
+    }
+
+    // the tiles are drawn up to each command that has to be drawn whole
+    for (i = 0; i <= serial->len; i++) {
+        batch->end = (i < serial->len) ? g_array_index(serial, guint, i) : n;
+        run_tiles(batch);
+        if (i < serial->len) {
+            run_serial(batch, batch->end, batch->end + 1);
+        }
+    }
+
+    for (t = 0; t < batch->n_tiles; t++) {
+        g_array_unref(batch->bins[t]);
+    }
+    g_free(batch->bins);
+    g_free(batch->next);
+    batch->bins = NULL;
+    batch->next = NULL;
+    g_array_unref(serial);
+    _GrDrawListClear(&batch->list);
+}
@@ -17,17 +17,145 @@
 
 #include <grx/events.h>
 
+#include "latency.h"
+
 G_DEFINE_BOXED_TYPE (GrxEvent, grx_event, grx_event_copy, grx_event_free);
 
-static GQueue *queue;
+/* must be a power of 2 */
+#define QUEUE_SIZE 256
+
+/* events handled by one dispatch of a source, unless changed */
+#define DEFAULT_DISPATCH_BUDGET 64
+
+static guint dispatch_budget = DEFAULT_DISPATCH_BUDGET;
+
+/*
+ * The queue is a ring buffer of events, so queueing an event does not
+ * allocate memory. The events hold a reference to their device. Events can
+ * be put from any thread, the lock protects everything but the static
+ * events array contents that the consumer got from grx_event_peek().
+ */
+static struct {
+    GMutex lock;
+    guint head;
+    guint length;
+    guint dropped;
+    GMainContext *context;      /* where the event sources are attached */
+    GrxEvent events[QUEUE_SIZE];
+    gint64 queued[QUEUE_SIZE];  /* when the events were put */
+} queue;
+
+/* the time stamp of input events, NULL for other events */
+static gint64 *event_time (GrxEvent *event)
+{
+    switch (event->type) {
+    case GRX_EVENT_TYPE_KEY_DOWN:
+    case GRX_EVENT_TYPE_KEY_UP:
+        return &event->key.time;
+    case GRX_EVENT_TYPE_POINTER_MOTION:
+        return &event->motion.time;
+    case GRX_EVENT_TYPE_BUTTON_PRESS:
+    case GRX_EVENT_TYPE_BUTTON_RELEASE:
+    case GRX_EVENT_TYPE_BUTTON_DOUBLE_PRESS:
+        return &event->button.time;
+    case GRX_EVENT_TYPE_TOUCH_DOWN:
+    case GRX_EVENT_TYPE_TOUCH_MOTION:
+    case GRX_EVENT_TYPE_TOUCH_UP:
+    case GRX_EVENT_TYPE_TOUCH_CANCEL:
+        return &event->touch.time;
+    default:
+        return NULL;
+    }
+}
+
+static void event_ref_device (GrxEvent *event)
+{
+    GrxDevice *device = grx_event_get_device (event);
+
+    if (device) {
+        g_object_ref (device);
+    }
+}
 
-static inline GQueue *get_queue (void)
+static void event_unref_device (GrxEvent *event)
 {
-    if (!queue) {
-        queue = g_queue_new ();
+    GrxDevice *device = grx_event_get_device (event);
+
+    if (device) {
+        g_object_unref (device);
+    }
+}
+
+/*
+ * Motion events only tell where the pointer or finger is now, so a motion
+ * event that follows one of the same device (and touch point) replaces it.
+ * The first event in the queue is left alone, it may have been peeked at.
+ */
+static gboolean coalesce (GrxEvent *event)
+{
+    GrxEvent *last;
+
+    if (queue.length < 2) {
+        return FALSE;
+    }
+    last = &queue.events[(queue.head + queue.length - 1) & (QUEUE_SIZE - 1)];
+    if (last->type != event->type) {
+        return FALSE;
+    }
+
+    switch (event->type) {
+    case GRX_EVENT_TYPE_POINTER_MOTION:
+        if (last->motion.device != event->motion.device ||
+            last->motion.modifiers != event->motion.modifiers)
+        {
+            return FALSE;
+        }
+        last->motion.x = event->motion.x;
+        last->motion.y = event->motion.y;
+        last->motion.time = event->motion.time;
+        return TRUE;
+    case GRX_EVENT_TYPE_TOUCH_MOTION:
+        if (last->touch.device != event->touch.device ||
+            last->touch.id != event->touch.id ||
+            last->touch.modifiers != event->touch.modifiers)
+        {
+            return FALSE;
+        }
+        last->touch.x = event->touch.x;
+        last->touch.y = event->touch.y;
+        last->touch.time = event->touch.time;
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
+/*
+ * Removes up to max events from the front of the queue, the caller gets
+ * their device references. Returns the number of events removed.
+ */
+static guint pop (GrxEvent *events, guint max)
+{
+    gint64 now = 0;
+    guint n;
+
+    g_mutex_lock (&queue.lock);
+    n = MIN (max, queue.length);
+    if (n && _GrLatencyEnabled) {
+        now = g_get_monotonic_time ();
+    }
+    for (guint i = 0; i < n; i++) {
+        events[i] = queue.events[queue.head];
+        if (now) {
+            gint64 *time = event_time (&events[i]);
+            _GrLatencyDequeued (queue.queued[queue.head], time ? *time : 0, now);
+        }
+        queue.head = (queue.head + 1) & (QUEUE_SIZE - 1);
     }
+    queue.length -= n;
+    g_mutex_unlock (&queue.lock);
 
-    return queue;
+    return n;
 }
 
 /**
@@ -55,7 +183,13 @@ GrxEvent *grx_event_new (GrxEventType type)
  */
 gboolean grx_events_pending (void)
 {
-    return !g_queue_is_empty (get_queue ());
+    gboolean ret;
+
+    g_mutex_lock (&queue.lock);
+    ret = queue.length > 0;
+    g_mutex_unlock (&queue.lock);
+
+    return ret;
 }
 
 /**
@@ -64,11 +198,21 @@ gboolean grx_events_pending (void)
  * Gets the first event in the queue, but does not remove the event from the
  * queue.
  *
- * Returns: (transfer none): the event
+ * The event is only valid until it is removed from the queue.
+ *
+ * Returns: (transfer none) (nullable): the event or %NULL if the queue is empty
  */
 GrxEvent *grx_event_peek (void)
 {
-    return g_queue_peek_head (get_queue ());
+    GrxEvent *event = NULL;
+
+    g_mutex_lock (&queue.lock);
+    if (queue.length) {
+        event = &queue.events[queue.head];
+    }
+    g_mutex_unlock (&queue.lock);
+
+    return event;
 }
 
 /**
@@ -78,11 +222,17 @@ GrxEvent *grx_event_peek (void)
  *
  * Free the event with grx_event_free().
  *
- * Returns: (transfer full): the event
+ * Returns: (transfer full) (nullable): the event or %NULL if the queue is empty
  */
 GrxEvent *grx_event_get (void)
 {
-    return g_queue_pop_head (get_queue ());
+    GrxEvent event;
+
+    if (!pop (&event, 1)) {
+        return NULL;
+    }
+
+    return g_slice_dup (GrxEvent, &event);
 }
 
 /**
@@ -90,10 +240,60 @@ GrxEvent *grx_event_get (void)
  * @event: the event
  *
  * Adds a copy of @event to the end of the queue.
+ *
+ * This may be called from any thread. A #GRX_EVENT_TYPE_POINTER_MOTION or
+ * #GRX_EVENT_TYPE_TOUCH_MOTION event that follows the same kind of event
+ * from the same device only updates the coordinates of the queued one. The
+ * queue holds a fixed number of events, if it is full @event is dropped.
+ *
+ * Input events with a time of 0 get the current time.
  */
 void grx_event_put (GrxEvent *event)
 {
-    g_queue_push_tail (get_queue (), grx_event_copy (event));
+    GMainContext *context = NULL;
+    gboolean dropped = FALSE;
+    GrxEvent copy;
+    gint64 now, *time;
+
+    g_return_if_fail (event != NULL);
+
+    now = g_get_monotonic_time ();
+    copy = *event;
+    time = event_time (&copy);
+    if (time && !*time) {
+        *time = now;
+    }
+
+    g_mutex_lock (&queue.lock);
+    if (coalesce (&copy)) {
+        g_mutex_unlock (&queue.lock);
+        return;
+    }
+    if (queue.length < QUEUE_SIZE) {
+        guint i = (queue.head + queue.length) & (QUEUE_SIZE - 1);
+        queue.events[i] = copy;
+        queue.queued[i] = now;
+        event_ref_device (&queue.events[i]);
+        queue.length++;
+        if (queue.context) {
+            context = g_main_context_ref (queue.context);
+        }
+    }
+    else {
+        dropped = queue.dropped++ == 0;
+    }
+    g_mutex_unlock (&queue.lock);
+
+    if (dropped) {
+        g_warning ("Event queue is full, dropping events");
+    }
+    /* the main loop may be sleeping if this is another thread */
+    if (context) {
+        if (!g_main_context_is_owner (context)) {
+            g_main_context_wakeup (context);
+        }
+        g_main_context_unref (context);
+    }
 }
 
 /**
@@ -109,39 +309,7 @@ GrxEvent *grx_event_copy (GrxEvent *event)
     g_return_val_if_fail (event != NULL, NULL);
 
     GrxEvent* new_event = g_slice_dup (GrxEvent, event);
-    switch (event->type) {
-    case GRX_EVENT_TYPE_NONE:
-    case GRX_EVENT_TYPE_APP_ACTIVATE:
-    case GRX_EVENT_TYPE_APP_DEACTIVATE:
-    case GRX_EVENT_TYPE_APP_QUIT:
-        break;
-    case GRX_EVENT_TYPE_KEY_UP:
-    case GRX_EVENT_TYPE_KEY_DOWN:
-        if (new_event->key.device) {
-            g_object_ref (new_event->key.device);
-        }
-        break;
-    case GRX_EVENT_TYPE_POINTER_MOTION:
-        if (new_event->motion.device) {
-            g_object_ref (new_event->motion.device);
-        }
-        break;
-    case GRX_EVENT_TYPE_BUTTON_PRESS:
-    case GRX_EVENT_TYPE_BUTTON_RELEASE:
-    case GRX_EVENT_TYPE_BUTTON_DOUBLE_PRESS:
-        if (new_event->button.device) {
-            g_object_ref (new_event->button.device);
-        }
-        break;
-    case GRX_EVENT_TYPE_TOUCH_DOWN:
-    case GRX_EVENT_TYPE_TOUCH_MOTION:
-    case GRX_EVENT_TYPE_TOUCH_UP:
-    case GRX_EVENT_TYPE_TOUCH_CANCEL:
-        if (new_event->touch.device) {
-            g_object_ref (new_event->touch.device);
-        }
-        break;
-    }
+    event_ref_device (new_event);
 
     return new_event;
 }
@@ -154,39 +322,7 @@ GrxEvent *grx_event_copy (GrxEvent *event)
  */
 void grx_event_free (GrxEvent *event)
 {
-    switch (event->type) {
-    case GRX_EVENT_TYPE_NONE:
-    case GRX_EVENT_TYPE_APP_ACTIVATE:
-    case GRX_EVENT_TYPE_APP_DEACTIVATE:
-    case GRX_EVENT_TYPE_APP_QUIT:
-        break;
-    case GRX_EVENT_TYPE_KEY_UP:
-    case GRX_EVENT_TYPE_KEY_DOWN:
-        if (event->key.device) {
-            g_object_unref (event->key.device);
-        }
-        break;
-    case GRX_EVENT_TYPE_POINTER_MOTION:
-        if (event->motion.device) {
-            g_object_unref (event->motion.device);
-        }
-        break;
-    case GRX_EVENT_TYPE_BUTTON_PRESS:
-    case GRX_EVENT_TYPE_BUTTON_RELEASE:
-    case GRX_EVENT_TYPE_BUTTON_DOUBLE_PRESS:
-        if (event->button.device) {
-            g_object_unref (event->button.device);
-        }
-        break;
-    case GRX_EVENT_TYPE_TOUCH_DOWN:
-    case GRX_EVENT_TYPE_TOUCH_MOTION:
-    case GRX_EVENT_TYPE_TOUCH_UP:
-    case GRX_EVENT_TYPE_TOUCH_CANCEL:
-        if (event->touch.device) {
-            g_object_unref (event->touch.device);
-        }
-        break;
-    }
+    event_unref_device (event);
     g_slice_free (GrxEvent, event);
 }
 
@@ -408,12 +544,44 @@ guint32 grx_event_get_button (GrxEvent *event)
     }
 }
 
+/**
+ * grx_event_get_time:
+ * @event: the event
+ *
+ * Gets the time when an input event happened, in microseconds of the clock
+ * used by g_get_monotonic_time(). Video drivers set this to the time stamp of
+ * the input device if there is one, otherwise it is the time the event was
+ * added to the queue.
+ *
+ * Returns: the time or 0 if @event is not an input event
+ */
+gint64 grx_event_get_time (GrxEvent *event)
+{
+    gint64 *time;
+
+    g_return_val_if_fail (event != NULL, 0);
+
+    time = event_time (event);
+
+    return time ? *time : 0;
+}
+
 /* source implementation */
 
 static gboolean source_prepare (GSource *source, gint *timeout)
 {
     *timeout = -1;
 
+    /* remember who to wake up when events come from other threads */
+    if (G_UNLIKELY (queue.context != g_source_get_context (source))) {
+        g_mutex_lock (&queue.lock);
+        if (queue.context) {
+            g_main_context_unref (queue.context);
+        }
+        queue.context = g_main_context_ref (g_source_get_context (source));
+        g_mutex_unlock (&queue.lock);
+    }
+
     return grx_events_pending ();
 }
 
@@ -422,31 +590,91 @@ static gboolean source_check (GSource *source)
     return grx_events_pending ();
 }
 
+/*
+ * Handles up to dispatch_budget events, so that a burst of input does not
+ * take a main loop iteration per event but other sources still get a turn.
+ */
 static gboolean
 source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
 {
-    GrxEvent *event = grx_event_get ();
+    GrxEvent event;
+    guint budget = dispatch_budget;
+
+    while (budget-- && pop (&event, 1)) {
+        if (callback) {
+            ((GrxEventHandlerFunc)callback) (&event, user_data);
+        }
+        event_unref_device (&event);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
 
-    if (!event) {
+static GSourceFuncs source_funcs = {
+    .prepare    = source_prepare,
+    .check      = source_check,
+    .dispatch   = source_dispatch,
+    .finalize   = NULL,
+};
+
+static gboolean
+batch_source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
+{
+    GrxEvent events[QUEUE_SIZE];
+    guint n;
+
+    n = pop (events, MIN (dispatch_budget, QUEUE_SIZE));
+    if (!n) {
         return G_SOURCE_CONTINUE;
     }
 
     if (callback) {
-        ((GrxEventHandlerFunc)callback) (event, user_data);
+        ((GrxEventBatchHandlerFunc)callback) (events, n, user_data);
     }
 
-    grx_event_free (event);
+    for (guint i = 0; i < n; i++) {
+        event_unref_device (&events[i]);
+    }
 
     return G_SOURCE_CONTINUE;
 }
 
-static GSourceFuncs source_funcs = {
+static GSourceFuncs batch_source_funcs = {
     .prepare    = source_prepare,
     .check      = source_check,
-    .dispatch   = source_dispatch,
+    .dispatch   = batch_source_dispatch,
     .finalize   = NULL,
 };
 
+/**
+ * grx_event_set_dispatch_budget:
+ * @max_events: the maximum number of events, at least 1
+ *
+ * Sets how many events an event source handles in one main loop iteration.
+ * This also applies to the input sources of the video drivers. The default
+ * is 64, larger values drain bursts of input faster, smaller values keep
+ * other sources of the main loop more responsive.
+ */
+void grx_event_set_dispatch_budget (guint max_events)
+{
+    g_return_if_fail (max_events > 0);
+
+    dispatch_budget = max_events;
+}
+
+/**
+ * grx_event_get_dispatch_budget:
+ *
+ * Gets the number of events an event source handles in one main loop
+ * iteration.
+ *
+ * Returns: the maximum number of events
+ */
+guint grx_event_get_dispatch_budget (void)
+{
+    return dispatch_budget;
+}
+
 /**
  * grx_event_handler_source_new:
  *
@@ -489,3 +717,49 @@ guint grx_event_handler_add (GrxEventHandlerFunc callback, gpointer user_data,
 
     return id;
 }
+
+/**
+ * grx_event_batch_handler_source_new:
+ *
+ * Creates a new source that will be dispatched with all pending events at
+ * once, up to the limit set with grx_event_set_dispatch_budget().
+ *
+ * The source will not initially be associated with any #GMainContext and must
+ * be added to one with g_source_attach() before it will be executed. The
+ * callback function (set with g_source_set_callback()) is expected to be a
+ * #GrxEventBatchHandlerFunc.
+ *
+ * Generally, you will want to use grx_event_batch_handler_add() instead.
+ *
+ * Returns: a new #GSource
+ */
+GSource *grx_event_batch_handler_source_new (void)
+{
+    return g_source_new (&batch_source_funcs, sizeof (GSource));
+}
+
+/**
+ * grx_event_batch_handler_add:
+ * @callback: the function to be called when events occur
+ * @user_data: (transfer full) (nullable): user data passed to @callback
+ * @notify: (nullable): callback to destroy @user_data when source is removed
+ *
+ * Creates a new batched event source and adds it to the default main
+ * context. Use this instead of grx_event_handler_add() when the application
+ * wants to redraw once after handling a group of events.
+ *
+ * Returns: the source id
+ */
+guint grx_event_batch_handler_add (GrxEventBatchHandlerFunc callback,
+                                   gpointer user_data, GDestroyNotify notify)
+{
+    GSource *source;
+    guint id;
+
+    source = grx_event_batch_handler_source_new ();
+    g_source_set_callback (source, (GSourceFunc)callback, user_data, notify);
+    id = g_source_attach (source, g_main_context_default ());
+    g_source_unref (source);
+
+    return id;
+}
@@ -0,0 +1,138 @@
+/*
+ * latency.c ---- input latency measurements
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <string.h>
+
+#include <glib.h>
+
+#include <grx/events.h>
+
+#include "libgrx.h"
+#include "grdriver.h"
+#include "latency.h"
+
+gboolean _GrLatencyEnabled;
+
+/* events may be taken from the queue on another thread than presenting */
+static GMutex lock;
+static GrxLatencyStats measured[GRX_LATENCY_TYPE_PRESENT + 1];
+static gint64 oldest_input;     /* 0 if no input since the last present */
+
+static void add_sample(GrxLatencyStats *st, gint64 usec)
+{
+    guint b;
+
+    usec = MAX(usec, 0);
+    if (!st->count || usec < st->min) {
+        st->min = usec;
+    }
+    st->max = MAX(st->max, usec);
+    st->total += usec;
+    st->count++;
+    for (b = 0; b < GRX_LATENCY_N_BUCKETS - 1; b++) {
+        if (usec < (G_GINT64_CONSTANT(64) << b)) {
+            break;
+        }
+    }
+    st->buckets[b]++;
+}
+
+void _GrLatencyDequeued(gint64 queued, gint64 time, gint64 now)
+{
+    g_mutex_lock(&lock);
+    add_sample(&measured[GRX_LATENCY_TYPE_QUEUE], now - queued);
+    if (time && (!oldest_input || time < oldest_input)) {
+        oldest_input = time;
+    }
+    g_mutex_unlock(&lock);
+}
+
+void _GrLatencyPresented(void)
+{
+    if (!_GrLatencyEnabled) {
+        return;
+    }
+    g_mutex_lock(&lock);
+    if (oldest_input) {
+        add_sample(&measured[GRX_LATENCY_TYPE_PRESENT],
+                   g_get_monotonic_time() - oldest_input);
+        oldest_input = 0;
+    }
+    g_mutex_unlock(&lock);
+}
+
+/**
+ * grx_latency_set_enabled:
+ * @enabled: %TRUE to measure latencies
+ *
+ * Turns latency measurements on or off. They are off by default.
+ *
+ * When on, the time every event spends in the queue is recorded. The time
+ * from an input event until the display shows the result is recorded when the
+ * video driver updates the display: for drivers that copy the frame buffer
+ * (gtk3, linuxfb with a back buffer) this happens on their own, for the
+ * others it is when grx_present_screen() is called. Use grx_latency_get_stats()
+ * to read the results.
+ */
+void grx_latency_set_enabled(gboolean enabled)
+{
+    g_mutex_lock(&lock);
+    _GrLatencyEnabled = enabled;
+    oldest_input = 0;
+    g_mutex_unlock(&lock);
+}
+
+/**
+ * grx_latency_get_enabled:
+ *
+ * Gets whether latencies are measured.
+ *
+ * Returns: %TRUE if latency measurements are on
+ */
+gboolean grx_latency_get_enabled(void)
+{
+    return _GrLatencyEnabled;
+}
+
+/**
+ * grx_latency_get_stats:
+ * @type: which latency
+ * @stats: (out caller-allocates): the measurements
+ *
+ * Gets the latencies measured since they were turned on or last reset.
+ */
+void grx_latency_get_stats(GrxLatencyType type, GrxLatencyStats *stats)
+{
+    g_return_if_fail(type <= GRX_LATENCY_TYPE_PRESENT);
+    g_return_if_fail(stats != NULL);
+
+    g_mutex_lock(&lock);
+    *stats = measured[type];
+    g_mutex_unlock(&lock);
+}
+
+/**
+ * grx_latency_reset:
+ *
+ * Clears all latency measurements.
+ */
+void grx_latency_reset(void)
+{
+    g_mutex_lock(&lock);
+    memset(measured, 0, sizeof(measured));
+    oldest_input = 0;
+    g_mutex_unlock(&lock);
+}
@@ -0,0 +1,114 @@
+/*
+ * blendblt.c ---- compositing a premultiplied ARGB frame over any frame
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include "colors.h"
+#include "globals.h"
+#include "libgrx.h"
+#include "grdriver.h"
+#include "allocate.h"
+#include "arith.h"
+#include "memcopy.h"
+#include "blend.h"
+
+#define FOFS(x,y,lo) umuladd32((y),(lo),((x)<<2))
+
+/* the row kernel for destinations that hold 8 bit channels in a word */
+static _GR_spanBlend span_kernel(GrxFrameMode mode)
+{
+        switch(mode) {
+            case GRX_FRAME_MODE_RAM_32BPP_ARGB:
+            case GRX_FRAME_MODE_RAM_32BPP_LOW:
+#ifdef LFB_BY_NEAR_POINTER
+            case GRX_FRAME_MODE_LFB_32BPP_LOW:
+#endif
+                return _GrSpanBlend_argb;
+            case GRX_FRAME_MODE_RAM_32BPP_HIGH:
+#ifdef LFB_BY_NEAR_POINTER
+            case GRX_FRAME_MODE_LFB_32BPP_HIGH:
+#endif
+                return _GrSpanBlend_argb_h;
+            default:
+                return NULL;
+        }
+}
+
+/* any other destination is read and written a row at a time by its driver */
+static void blend_row_generic(GrxFrame *dst,int dx,int dy,const GR_int32u *s,int w)
+{
+        GrxFrameDriver *drv = dst->driver;
+        GrxColor *row;
+        int i;
+        row = (drv->getindexedscanline)
+            ? (*drv->getindexedscanline)(dst,dx,dy,w,NULL)
+            : _GrFrDrvGenericGetIndexedScanline(dst,dx,dy,w,NULL);
+        if (!row) return;
+        for (i = 0; i < w; i++) {
+            GR_int32u p = s[i], a = p >> 24;
+            guint8 r, g, b;
+            if (a == 0) continue;
+            if (a != 255) {
+                grx_color_query(row[i],&r,&g,&b);
+                p = blend_over_argb(p,((GR_int32u)r << 16) | (g << 8) | b);
+            }
+            row[i] = grx_color_get_inline((p >> 16) & 255,(p >> 8) & 255,p & 255);
+        }
+        if (drv->putscanline)
+            (*drv->putscanline)(dx,dy,w,row,GRX_COLOR_MODE_WRITE);
+        else
+            _GrFrDrvGenericPutScanline(dx,dy,w,row,GRX_COLOR_MODE_WRITE);
+}
+
+/*
+ * Composites a w x h area of a GRX_FRAME_MODE_RAM_32BPP_ARGB source over
+ * the destination, which may have any frame mode.
+ */
+void _GrFrDrvBlendBitBlt(GrxFrame *dst,int dx,int dy,GrxFrame *src,int x,int y,int w,int h,GrxColor op)
+{
+        GrxFrame csave;
+        _GR_spanBlend kernel;
+        const unsigned char *sp;
+        unsigned char *dp;
+        int step, overlap;
+        GRX_ENTER();
+        kernel  = span_kernel(dst->driver->mode);
+        overlap = (dst->base_address.plane0 == src->base_address.plane0);
+        step    = 1;
+        if (dy > y) {
+            y  += (h - 1);
+            dy += (h - 1);
+            step = (-1);
+        }
+        /* the scanline writers draw through the current context */
+        sttcopy(&csave,&CURC->frame);
+        sttcopy(&CURC->frame,dst);
+        do {
+            sp = &src->base_address.plane0[FOFS(x,y,src->line_offset)];
+            if (kernel) {
+                dp = &dst->base_address.plane0[FOFS(dx,dy,dst->line_offset)];
+                if (overlap) {
+                    void *tmp = _GrTempBufferAlloc(w << 2);
+                    if (!tmp) break;
+                    memcopy(tmp,sp,w << 2);
+                    sp = tmp;
+                }
+                (*kernel)(dp,sp,w);
+            }
+            else blend_row_generic(dst,dx,dy,(const GR_int32u *)sp,w);
+            y += step; dy += step;
+        } while(--h > 0);
+        sttcopy(&CURC->frame,&csave);
+        GRX_LEAVE();
+}
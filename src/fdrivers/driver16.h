@@ -23,9 +23,11 @@
 #include "globals.h"
 #include "libgrx.h"
 #include "grdriver.h"
+#include "allocate.h"
 #include "arith.h"
 #include "mempeek.h"
 #include "memfill.h"
+#include "blend.h"
 
 /* frame offset address calculation */
 #define FOFS(x,y,lo) umuladd32((y),(lo),((x) << 1))
@@ -290,11 +292,87 @@ static
 #include "generic/line.c"
 #endif
 
-static
-#include "generic/bitmap.c"
+#define PK_SIZE         2
+#define PK_TYPE         GR_int16u
+#define PK_COL(c)       ((GR_int16u)(c))
+#define PK_SET(p,v)     poke16(p,v)
+#define PK_XOR(p,v)     poke16_xor(p,v)
+#define PK_OR(p,v)      poke16_or(p,v)
+#define PK_AND(p,v)     poke16_and(p,v)
+#include "generic/pkbitmap.c"
 
-static
-#include "generic/pattern.c"
+static void blendspan(int x,int y,int w,const unsigned char *alpha,GrxColor color)
+{
+        unsigned char *ptr;
+        GR_int32u mask, cs;
+        GRX_ENTER();
+        ptr  = &CURC->gc_base_address.plane0[FOFS(x,y,CURC->gc_line_offset)];
+        mask = blend_spread_mask16();
+        cs   = blend_spread16((GR_int16u)color,mask);
+        SETFARSEL(CURC->gc_selector);
+        for ( ; w > 0; w--, ptr += 2) {
+            unsigned int a = *(alpha++);
+            if (a == 0) continue;
+            if (a == 255) {
+                poke16(ptr,(GR_int16u)color);
+                continue;
+            }
+            /* 5 bit weights keep every spread component product in range */
+            a = (blend_alpha256(a) + 4) >> 3;
+            poke16(ptr,blend_pack16(blend_spread(cs,blend_spread16(peek16(ptr),mask),a,mask)));
+        }
+        GRX_LEAVE();
+}
+
+static GrxColor *getindexedscanline(GrxFrame *c,int x,int y,int w,int *indx)
+{
+        GrxColor *pixels, *p;
+        unsigned char *pp;
+        GRX_ENTER();
+        p = pixels = _GrTempBufferAlloc(sizeof(GrxColor) * (w+1));
+        if (pixels) {
+#ifdef FAR_ACCESS
+            pp = &SCRN->gc_base_address.plane0[FOFS(0,y,SCRN->gc_line_offset)];
+            setup_far_selector(SCRN->gc_selector);
+#else
+            pp = &c->base_address.plane0[FOFS(0,y,c->line_offset)];
+#endif
+            if (indx) {
+                for ( ; w > 0; w--) {
+                    int xx = x + *(indx++);
+                    *(p++) = (GR_int16u)peek16(pp + (xx << 1));
+                }
+            } else {
+                for (pp += (x << 1); w > 0; w--, pp += 2) {
+                    *(p++) = (GR_int16u)peek16(pp);
+                }
+            }
+        }
+        GRX_RETURN(pixels);
+}
+
+static void putscanline(int x,int y,int w,const GrxColor *scl,GrxColor op)
+{
+        unsigned char *ptr;
+        GrxColor skipc;
+        GRX_ENTER();
+        ptr = &CURC->gc_base_address.plane0[FOFS(x,y,CURC->gc_line_offset)];
+        SETFARSEL(CURC->gc_selector);
+        switch(C_OPER(op)) {
+            case C_IMAGE:
+                skipc = op ^ GRX_COLOR_MODE_IMAGE;
+                for ( ; w > 0; w--, ptr += 2) {
+                    GrxColor col = *(scl++);
+                    if (col != skipc) poke16(ptr,(GR_int16u)(col));
+                }
+                break;
+            case C_XOR: for ( ; w > 0; w--, ptr += 2, scl++) poke16_xor(ptr,(GR_int16u)(*scl)); break;
+            case C_OR:  for ( ; w > 0; w--, ptr += 2, scl++) poke16_or(ptr,(GR_int16u)(*scl)); break;
+            case C_AND: for ( ; w > 0; w--, ptr += 2, scl++) poke16_and(ptr,(GR_int16u)(*scl)); break;
+            default:    for ( ; w > 0; w--, ptr += 2, scl++) poke16(ptr,(GR_int16u)(*scl)); break;
+        }
+        GRX_LEAVE();
+}
 
 static void bitblt(GrxFrame *dst,int dx,int dy,
                    GrxFrame *src,int sx,int sy,
@@ -23,10 +23,12 @@
 #include "globals.h"
 #include "libgrx.h"
 #include "grdriver.h"
+#include "allocate.h"
 #include "arith.h"
 #include "mempeek.h"
 #include "memfill.h"
 #include "access24.h"
+#include "blend.h"
 
 /* frame offset address calculation */
 #define MULT3(x)     ( (x)+(x)+(x) )
@@ -148,11 +150,84 @@ static
 static
 #include "generic/block.c"
 
-static
-#include "generic/bitmap.c"
+#define PK_SIZE         3
+#define PK_TYPE         GrxColor
+#define PK_COL(c)       ((c) & 0xFFFFFF)
+#define PK_SET(p,v)     poke24_set(p,v)
+#define PK_XOR(p,v)     poke24_xor(p,v)
+#define PK_OR(p,v)      poke24_or(p,v)
+#define PK_AND(p,v)     poke24_and(p,v)
+#include "generic/pkbitmap.c"
 
-static
-#include "generic/pattern.c"
+static void blendspan(int x,int y,int w,const unsigned char *alpha,GrxColor color)
+{
+        unsigned char *ptr;
+        GRX_ENTER();
+        ptr   = &CURC->gc_base_address.plane0[FOFS(x,y,CURC->gc_line_offset)];
+        color &= GRX_COLOR_VALUE_MASK;
+        SETFARSEL(CURC->gc_selector);
+        for ( ; w > 0; w--, ptr += 3) {
+            unsigned int a = *(alpha++);
+            if (a == 0) continue;
+            if (a == 255) {
+                poke24_set(ptr,color);
+                continue;
+            }
+            a = blend_alpha256(a);
+            poke24_set(ptr,blend_888(color,peek24(ptr),a));
+        }
+        GRX_LEAVE();
+}
+
+static GrxColor *getindexedscanline(GrxFrame *c,int x,int y,int w,int *indx)
+{
+        GrxColor *pixels, *p;
+        unsigned char *pp;
+        GRX_ENTER();
+        p = pixels = _GrTempBufferAlloc(sizeof(GrxColor) * (w+1));
+        if (pixels) {
+#ifdef FAR_ACCESS
+            pp = &SCRN->gc_base_address.plane0[FOFS(0,y,SCRN->gc_line_offset)];
+            setup_far_selector(SCRN->gc_selector);
+#else
+            pp = &c->base_address.plane0[FOFS(0,y,c->line_offset)];
+#endif
+            if (indx) {
+                for ( ; w > 0; w--) {
+                    int xx = x + *(indx++);
+                    *(p++) = peek24(pp + MULT3(xx));
+                }
+            } else {
+                for (pp += MULT3(x); w > 0; w--, pp += 3) {
+                    *(p++) = peek24(pp);
+                }
+            }
+        }
+        GRX_RETURN(pixels);
+}
+
+static void putscanline(int x,int y,int w,const GrxColor *scl,GrxColor op)
+{
+        unsigned char *ptr;
+        GrxColor skipc;
+        GRX_ENTER();
+        ptr = &CURC->gc_base_address.plane0[FOFS(x,y,CURC->gc_line_offset)];
+        SETFARSEL(CURC->gc_selector);
+        switch(C_OPER(op)) {
+            case C_IMAGE:
+                skipc = op ^ GRX_COLOR_MODE_IMAGE;
+                for ( ; w > 0; w--, ptr += 3) {
+                    GrxColor col = *(scl++);
+                    if (col != skipc) poke24_set(ptr,col);
+                }
+                break;
+            case C_XOR: for ( ; w > 0; w--, ptr += 3, scl++) poke24_xor(ptr,*scl); break;
+            case C_OR:  for ( ; w > 0; w--, ptr += 3, scl++) poke24_or(ptr,*scl); break;
+            case C_AND: for ( ; w > 0; w--, ptr += 3, scl++) poke24_and(ptr,*scl); break;
+            default:    for ( ; w > 0; w--, ptr += 3, scl++) poke24_set(ptr,*scl); break;
+        }
+        GRX_LEAVE();
+}
 
 static void bitblt(GrxFrame *dst,int dx,int dy,GrxFrame *src,int sx,int sy,int w,int h,GrxColor op)
 {
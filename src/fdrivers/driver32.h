@@ -24,9 +24,11 @@
 #include "globals.h"
 #include "libgrx.h"
 #include "grdriver.h"
+#include "allocate.h"
 #include "arith.h"
 #include "mempeek.h"
 #include "memfill.h"
+#include "blend.h"
 
 /* frame offset address calculation */
 #define FOFS(x,y,lo) umuladd32((y),(lo),((x)<<2))
@@ -320,11 +322,84 @@ static
 #include "generic/line.c"
 #endif
 
-static
-#include "generic/bitmap.c"
+#define PK_SIZE         4
+#define PK_TYPE         GR_int32u
+#define PK_COL(c)       COL2PIX(c)
+#define PK_SET(p,v)     poke32(p,v)
+#define PK_XOR(p,v)     poke32_xor(p,v)
+#define PK_OR(p,v)      poke32_or(p,v)
+#define PK_AND(p,v)     poke32_and(p,v)
+#include "generic/pkbitmap.c"
 
-static
-#include "generic/pattern.c"
+static void blendspan(int x,int y,int w,const unsigned char *alpha,GrxColor color)
+{
+        unsigned char *ptr;
+        GRX_ENTER();
+        ptr   = &CURC->gc_base_address.plane0[FOFS(x,y,CURC->gc_line_offset)];
+        color = PIX2COL(COL2PIX(color));
+        SETFARSEL(CURC->gc_selector);
+        for ( ; w > 0; w--, ptr += 4) {
+            unsigned int a = *(alpha++);
+            if (a == 0) continue;
+            if (a == 255) {
+                poke32(ptr,COL2PIX(color));
+                continue;
+            }
+            a = blend_alpha256(a);
+            poke32(ptr,COL2PIX(blend_888(color,PIX2COL(peek32(ptr)),a)));
+        }
+        GRX_LEAVE();
+}
+
+static GrxColor *getindexedscanline(GrxFrame *c,int x,int y,int w,int *indx)
+{
+        GrxColor *pixels, *p;
+        unsigned char *pp;
+        GRX_ENTER();
+        p = pixels = _GrTempBufferAlloc(sizeof(GrxColor) * (w+1));
+        if (pixels) {
+#ifdef FAR_ACCESS
+            pp = &SCRN->gc_base_address.plane0[FOFS(0,y,SCRN->gc_line_offset)];
+            setup_far_selector(SCRN->gc_selector);
+#else
+            pp = &c->base_address.plane0[FOFS(0,y,c->line_offset)];
+#endif
+            if (indx) {
+                for ( ; w > 0; w--) {
+                    int xx = x + *(indx++);
+                    *(p++) = PIX2COL(peek32(pp + (xx << 2)));
+                }
+            } else {
+                for (pp += (x << 2); w > 0; w--, pp += 4) {
+                    *(p++) = PIX2COL(peek32(pp));
+                }
+            }
+        }
+        GRX_RETURN(pixels);
+}
+
+static void putscanline(int x,int y,int w,const GrxColor *scl,GrxColor op)
+{
+        unsigned char *ptr;
+        GrxColor skipc;
+        GRX_ENTER();
+        ptr = &CURC->gc_base_address.plane0[FOFS(x,y,CURC->gc_line_offset)];
+        SETFARSEL(CURC->gc_selector);
+        switch(C_OPER(op)) {
+            case C_IMAGE:
+                skipc = op ^ GRX_COLOR_MODE_IMAGE;
+                for ( ; w > 0; w--, ptr += 4) {
+                    GrxColor col = *(scl++);
+                    if (col != skipc) poke32(ptr,COL2PIX(col));
+                }
+                break;
+            case C_XOR: for ( ; w > 0; w--, ptr += 4, scl++) poke32_xor(ptr,COL2PIX(*scl)); break;
+            case C_OR:  for ( ; w > 0; w--, ptr += 4, scl++) poke32_or(ptr,COL2PIX(*scl)); break;
+            case C_AND: for ( ; w > 0; w--, ptr += 4, scl++) poke32_and(ptr,COL2PIX(*scl)); break;
+            default:    for ( ; w > 0; w--, ptr += 4, scl++) poke32(ptr,COL2PIX(*scl)); break;
+        }
+        GRX_LEAVE();
+}
 
 static void bitblt(GrxFrame *dst,int dx,int dy,
                    GrxFrame *src,int sx,int sy,
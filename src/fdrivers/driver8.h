@@ -309,84 +309,15 @@ static
 
 /* -------------------------------------------------------------------- */
 
-static void drawbitmap(int x, int y, int w, int h, unsigned char *bmp,
-                       int pitch, int start, GrxColor fg, GrxColor bg)
-{
-        int fgop, bgop;
-        int dofg, dobg;
-        GRX_ENTER();
-        fgop = C_OPER(fg);
-        bgop = C_OPER(bg);
-        dofg = DOCOLOR8(fg,fgop);
-        dobg = DOCOLOR8(bg,bgop);
-        if(dofg | dobg) {
-            long offs = FOFS(x,y,CURC->gc_line_offset);
-            int  once = dofg && dobg && (fgop == bgop);
-            int  skip = CURC->gc_line_offset;
-            bmp   += start >> 3;
-            start &= 7;
-            SETFARSEL(CURC->gc_selector);
-            do {
-                GR_int8u  *bp = (GR_int8u *)bmp;
-                GR_int8u  bits    = *bp;
-                GR_int8u  mask    = 0x80 >> start;
-                GR_int32u w1      = w;
-                unsigned char *pp = &CURC->gc_base_address.plane0[offs];
-#               define DOBOTH(POKEOP) do {                              \
-                    POKEOP(pp,((bits&mask)?(GR_int8u)fg:(GR_int8u)bg)); \
-                    if((mask >>= 1) == 0) bits = *++bp,mask = 0x80;     \
-                    pp++;                                               \
-                } while(--w1 != 0)
-#               define DOFGC(POKEOP) do {                               \
-                    if((mask & bits) != 0) POKEOP(pp,(GR_int8u)fg);     \
-                    if((mask >>= 1)  == 0) bits = *++bp,mask = 0x80;    \
-                    pp++;                                               \
-                } while(--w1 != 0)
-#               define DOBGC(POKEOP) do {                               \
-                    if((mask & bits) == 0) POKEOP(pp,(GR_int8u)bg);     \
-                    if((mask >>= 1)  == 0) bits = *++bp,mask = 0x80;    \
-                    pp++;                                               \
-                } while(--w1 != 0)
-                if(once) switch(fgop) {
-                    case C_XOR: DOBOTH(poke8_xor); break;
-                    case C_OR:  DOBOTH(poke8_or);  break;
-                    case C_AND: DOBOTH(poke8_and); break;
-                    default:    DOBOTH(poke8);     break;
-                }
-                else {
-                    unsigned char *ppsave = pp;
-                    GR_int32u w1save = w1;
-                    if(dofg) switch(fgop) {
-                        case C_XOR: DOFGC(poke8_xor); break;
-                        case C_OR:  DOFGC(poke8_or);  break;
-                        case C_AND: DOFGC(poke8_and); break;
-                        default:    DOFGC(poke8);     break;
-                    }
-                    if(dobg) {
-                        pp   = ppsave;
-                        w1   = w1save;
-                        bp   = (GR_int8u *)bmp;
-                        bits = *bp;
-                        mask = 0x80 >> start;
-                        switch(bgop) {
-                            case C_XOR: DOBGC(poke8_xor); break;
-                            case C_OR:  DOBGC(poke8_or);  break;
-                            case C_AND: DOBGC(poke8_and); break;
-                            default:    DOBGC(poke8);     break;
-                        }
-                    }
-                }
-                offs += skip;
-                bmp  += pitch;
-            } while(--h != 0);
-        }
-        GRX_LEAVE();
-}
-
-/* -------------------------------------------------------------------- */
-
-static
-#include "generic/pattern.c"
+#define PK_SIZE         1
+#define PK_TYPE         GR_int8u
+#define PK_COL(c)       ((GR_int8u)(c))
+#define PK_NOOP(v,op)   (((op) <= C_AND) && !DOCOLOR8(v,op))
+#define PK_SET(p,v)     poke8(p,v)
+#define PK_XOR(p,v)     poke8_xor(p,v)
+#define PK_OR(p,v)      poke8_or(p,v)
+#define PK_AND(p,v)     poke8_and(p,v)
+#include "generic/pkbitmap.c"
 
 /* -------------------------------------------------------------------- */
 
@@ -688,6 +688,7 @@ static int init(GrxVideoMode *mp)
         CLRINFO->nfree--;
       }
     }
+    _GrColorsChanged();
   }
   PIXEL_CACHE_INVALIDATE();
   return(TRUE);
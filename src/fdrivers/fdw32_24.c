@@ -148,7 +148,6 @@ static void w32_bitblt(GrxFrame *dst, int dx, int dy, GrxFrame *src,
 void w32_putscanline(int x, int y, int w,
                      const GrxColor *scl, GrxColor op )
 {
-    GrxColor skipc;
     RECT Rect;
 
     GRX_ENTER();
@@ -157,12 +156,7 @@ void w32_putscanline(int x, int y, int w,
     Rect.right = x + w;
     Rect.bottom = y + 1;
 
-    skipc = op ^ GRX_COLOR_MODE_IMAGE;
-    op &= GRX_COLOR_MODE_MASK;
-    for ( w += x; x < w; ++x) {
-        GrxColor c = *(scl++);
-        if (c != skipc) drawpixel(x, y, (c|op));
-    }
+    putscanline(x, y, w, scl, op);
 
     InvalidateRect(hGRXWnd, &Rect, FALSE);
     GRX_LEAVE();
@@ -190,6 +184,6 @@ GrxFrameDriver _GrFrameDriverWIN32_24 = {
     .bitblt             = w32_bitblt,
     .bltv2r             = bitblt,
     .bltr2v             = w32_bitblt,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
+    .getindexedscanline = getindexedscanline,
     .putscanline        = w32_putscanline,
 };
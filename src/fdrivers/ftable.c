@@ -64,5 +64,6 @@ GrxFrameDriver *_GrFrameDriverTable[] = {
     &_GrFrameDriverRAM32L,
     &_GrFrameDriverRAM32H,
 #endif
+    &_GrFrameDriverRAM32A,
     NULL
 };
@@ -0,0 +1,57 @@
+/*
+ * genblend.c ---- generic, slow coverage blending routine
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include "colors.h"
+#include "globals.h"
+#include "libgrx.h"
+#include "grdriver.h"
+#include "blend.h"
+
+/* will blend color c into a row of the current context by coverage.   */
+/* Partially covered pixels are read back, mixed in RGB space and      */
+/* mapped to the nearest frame color, so palette modes get a usable    */
+/* (if coarse) result as well.                                         */
+
+void _GrFrDrvGenericBlendSpan(int x,int y,int w,
+                              const unsigned char *alpha,GrxColor c)
+{
+   _GR_readPix readpixel;
+   _GR_drawPix drawpixel;
+   guint8 r, g, b;
+   GRX_ENTER();
+   readpixel = CURC->gc_driver->readpixel;
+   drawpixel = CURC->gc_driver->drawpixel;
+   c &= GRX_COLOR_VALUE_MASK;
+   grx_color_query(c,&r,&g,&b);
+   for ( w += x; x < w; ++x) {
+     unsigned int a = *(alpha++);
+     GrxColor p;
+     guint8 pr, pg, pb;
+     if (a == 0) continue;
+     if (a == 255) {
+       (*drawpixel)(x,y,c);
+       continue;
+     }
+     a = blend_alpha256(a);
+     p = (*readpixel)(&CURC->frame,x,y);
+     grx_color_query(p,&pr,&pg,&pb);
+     pr = (r * a + pr * (256 - a)) >> 8;
+     pg = (g * a + pg * (256 - a)) >> 8;
+     pb = (b * a + pb * (256 - a)) >> 8;
+     (*drawpixel)(x,y,grx_color_get_inline(pr,pg,pb));
+   }
+   GRX_LEAVE();
+}
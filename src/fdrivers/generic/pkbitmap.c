@@ -0,0 +1,133 @@
+/*
+ * generic/pkbitmap.c ---- bitmap and pattern expansion for packed pixels
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+/*
+ * Defines drawbitmap() and drawpattern() for a packed pixel frame driver.
+ * The driver header defines before including this file:
+ *   PK_SIZE           bytes per pixel
+ *   PK_TYPE           type holding a pixel value
+ *   PK_COL(c)         the pixel value of color c, without the operation
+ *   PK_SET(p,v)       and PK_XOR, PK_OR, PK_AND: store pixel value v at p
+ * and optionally PK_NOOP(v,op), true when drawing v with op changes nothing.
+ *
+ * The bits are taken a byte at a time: a byte without any pixel of the
+ * color to draw is skipped as a whole, full bytes are stored without
+ * testing bits, and when both colors are plain writes every pixel is
+ * picked from the two values with a mask instead of a branch.
+ */
+
+/* store the pixels of the set bits in bits (MSB = leftmost pixel) */
+#define PK_BITS(STORE,p,bits,v) do {                                    \
+    unsigned char *_pp_ = (p);                                          \
+    unsigned int _b_ = (bits);                                          \
+    for ( ; _b_ != 0; _b_ = (_b_ << 1) & 0xff, _pp_ += PK_SIZE) {       \
+        if (_b_ & 0x80) STORE(_pp_,(v));                                \
+    }                                                                   \
+} while (0)
+
+static INLINE void pk_bitrow_one(unsigned char *pp,const GR_int8u *bp,int bstep,
+                                 int start,int w,unsigned int inv,int op,PK_TYPE v)
+{
+        unsigned int bits;
+        int n;
+        for ( ; w > 0; w -= n, bp += bstep, pp += n * PK_SIZE, start = 0) {
+            n    = 8 - start;
+            bits = ((*bp ^ inv) << start) & 0xff;
+            if (n > w) {
+                n = w;
+                bits &= 0xff00 >> n;
+            }
+            if (bits == 0) continue;
+            switch (op) {
+                case C_XOR: PK_BITS(PK_XOR,pp,bits,v); break;
+                case C_OR:  PK_BITS(PK_OR, pp,bits,v); break;
+                case C_AND: PK_BITS(PK_AND,pp,bits,v); break;
+                default:
+                    if (bits == 0xff) {
+                        unsigned char *p = pp;
+                        int i;
+                        for (i = 0; i < 8; i++, p += PK_SIZE) PK_SET(p,v);
+                    }
+                    else PK_BITS(PK_SET,pp,bits,v);
+                    break;
+            }
+        }
+}
+
+static INLINE void pk_bitrow_both(unsigned char *pp,const GR_int8u *bp,int bstep,
+                                  int start,int w,PK_TYPE fgv,PK_TYPE bgv)
+{
+        PK_TYPE diff = fgv ^ bgv;
+        unsigned int bits;
+        int n, i;
+        for ( ; w > 0; w -= n, bp += bstep, start = 0) {
+            n    = imin(8 - start, w);
+            bits = (*bp << start) & 0xff;
+            for (i = 0; i < n; i++, pp += PK_SIZE, bits <<= 1) {
+                PK_TYPE m = (PK_TYPE)0 - (PK_TYPE)((bits >> 7) & 1);
+                PK_SET(pp,(PK_TYPE)(bgv ^ (diff & m)));
+            }
+        }
+}
+
+/* a color with no effect, e.g. GRX_COLOR_NONE */
+#ifndef PK_NOOP
+#define PK_NOOP(v,op)   ((((op) == C_XOR) || ((op) == C_OR)) && ((v) == 0))
+#endif
+
+static void pk_bitrows(int x,int y,int w,int h,
+                       const GR_int8u *bp,int pitch,int bstep,int start,
+                       GrxColor fg,GrxColor bg)
+{
+        int fgop = C_OPER(fg);
+        int bgop = C_OPER(bg);
+        PK_TYPE fgv = PK_COL(fg);
+        PK_TYPE bgv = PK_COL(bg);
+        int dofg = !PK_NOOP(fgv,fgop);
+        int dobg = !PK_NOOP(bgv,bgop);
+        int both = dofg && dobg &&
+                   (fgop != C_XOR) && (fgop != C_OR) && (fgop != C_AND) &&
+                   (bgop != C_XOR) && (bgop != C_OR) && (bgop != C_AND);
+        unsigned int skip = CURC->gc_line_offset;
+        unsigned char *pp = &CURC->gc_base_address.plane0[FOFS(x,y,skip)];
+        if (!(dofg | dobg)) return;
+        SETFARSEL(CURC->gc_selector);
+        do {
+            if (both) pk_bitrow_both(pp,bp,bstep,start,w,fgv,bgv);
+            else {
+                if (dofg) pk_bitrow_one(pp,bp,bstep,start,w,0x00,fgop,fgv);
+                if (dobg) pk_bitrow_one(pp,bp,bstep,start,w,0xff,bgop,bgv);
+            }
+            pp += skip;
+            bp += pitch;
+        } while (--h != 0);
+}
+
+static void drawbitmap(int x,int y,int w,int h,
+                       unsigned char *bmp,int pitch,int start,GrxColor fg,GrxColor bg)
+{
+        GRX_ENTER();
+        bmp += (unsigned int)start >> 3;
+        pk_bitrows(x,y,w,h,bmp,pitch,1,start & 7,fg,bg);
+        GRX_LEAVE();
+}
+
+static void drawpattern(int x,int y,int w,unsigned char patt,GrxColor fg,GrxColor bg)
+{
+        GRX_ENTER();
+        pk_bitrows(x,y,w,1,&patt,0,0,0,fg,bg);
+        GRX_LEAVE();
+}
@@ -51,8 +51,8 @@ GrxFrameDriver _GrFrameDriverSVGA16_LFB = {
     .bitblt             = bitblt,
     .bltv2r             = bltv2r,
     .bltr2v             = bltr2v,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
-    .putscanline        = _GrFrDrvGenericPutScanline,
+    .getindexedscanline = getindexedscanline,
+    .putscanline        = putscanline,
 };
 
 #endif
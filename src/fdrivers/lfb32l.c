@@ -53,8 +53,8 @@ GrxFrameDriver _GrFrameDriverSVGA32L_LFB = {
     .bitblt             = bitblt,
     .bltv2r             = bltv2r,
     .bltr2v             = bltr2v,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
-    .putscanline        = _GrFrDrvGenericPutScanline,
+    .getindexedscanline = getindexedscanline,
+    .putscanline        = putscanline,
 };
 
 #endif
@@ -239,6 +239,7 @@ GrxFrameDriver _GrFrameDriverRAM1 = {
     .bltr2v             = NULL,
     .getindexedscanline = getindexedscanline,
     .putscanline        = _GrFrDrvGenericPutScanline,
+    .blendspan          = _GrFrDrvGenericBlendSpan,
 };
 
 GrxFrameDriver _GrFrameDriverMONO01_LFB = {
@@ -263,6 +264,7 @@ GrxFrameDriver _GrFrameDriverMONO01_LFB = {
     .bltr2v             = bltr2r_inv,
     .getindexedscanline = getindexedscanline,
     .putscanline        = _GrFrDrvGenericPutScanline,
+    .blendspan          = _GrFrDrvGenericBlendSpan,
 };
 
 GrxFrameDriver _GrFrameDriverMONO10_LFB = {
@@ -287,4 +289,5 @@ GrxFrameDriver _GrFrameDriverMONO10_LFB = {
     .bltr2v             = bltr2r,
     .getindexedscanline = getindexedscanline,
     .putscanline        = _GrFrDrvGenericPutScanline,
+    .blendspan          = _GrFrDrvGenericBlendSpan,
 };
@@ -40,8 +40,9 @@ GrxFrameDriver _GrFrameDriverRAM16 = {
     .bitblt             = bitblt,
     .bltv2r             = NULL,
     .bltr2v             = NULL,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
-    .putscanline        = _GrFrDrvGenericPutScanline,
+    .getindexedscanline = getindexedscanline,
+    .putscanline        = putscanline,
+    .blendspan          = blendspan,
 };
 
 /* some systems map LFB in normal user space (eg. Linux/svgalib) */
@@ -71,8 +72,9 @@ GrxFrameDriver _GrFrameDriverSVGA16_LFB = {
     .bitblt             = bitblt,
     .bltv2r             = bitblt,
     .bltr2v             = bitblt,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
-    .putscanline        = _GrFrDrvGenericPutScanline,
+    .getindexedscanline = getindexedscanline,
+    .putscanline        = putscanline,
+    .blendspan          = blendspan,
 };
 
 #endif
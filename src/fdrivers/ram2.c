@@ -252,6 +252,7 @@ GrxFrameDriver _GrFrameDriverRAM2 = {
     .bltr2v             = NULL,
     .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
     .putscanline        = _GrFrDrvGenericPutScanline,
+    .blendspan          = _GrFrDrvGenericBlendSpan,
 };
 
 GrxFrameDriver _GrFrameDriverCFB2_LFB = {
@@ -276,4 +277,5 @@ GrxFrameDriver _GrFrameDriverCFB2_LFB = {
     .bltr2v             = bitblt,
     .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
     .putscanline        = _GrFrDrvGenericPutScanline,
+    .blendspan          = _GrFrDrvGenericBlendSpan,
 };
@@ -42,8 +42,9 @@ GrxFrameDriver _GrFrameDriverRAM24 = {
     .bitblt             = bitblt,
     .bltv2r             = NULL,
     .bltr2v             = NULL,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
-    .putscanline        = _GrFrDrvGenericPutScanline,
+    .getindexedscanline = getindexedscanline,
+    .putscanline        = putscanline,
+    .blendspan          = blendspan,
 };
 
 /* some systems map LFB in normal user space (eg. Linux/svgalib) */
@@ -73,7 +74,8 @@ GrxFrameDriver _GrFrameDriverSVGA24_LFB = {
     .bitblt             = bitblt,
     .bltv2r             = bitblt,
     .bltr2v             = bitblt,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
-    .putscanline        = _GrFrDrvGenericPutScanline,
+    .getindexedscanline = getindexedscanline,
+    .putscanline        = putscanline,
+    .blendspan          = blendspan,
 };
 #endif /* defined(LFB_BY_NEAR_POINTER) */
@@ -0,0 +1,306 @@
+/*
+ * ram32a.c ---- the 16M color RAM memory driver with a premultiplied alpha
+ *               channel in the upper 8 bits of each pixel
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * The pixels are native endian 0xAARRGGBB words, the same layout as
+ * cairo's ARGB32, so that icons and overlays can be shared without
+ * conversion. Colors have no alpha and the color modes only combine the
+ * color channels: GRX_COLOR_MODE_WRITE, XOR and OR make the pixels opaque
+ * (otherwise XOR and OR could leave channels larger than the alpha, which is
+ * not a valid premultiplied pixel) and AND keeps their alpha. Blitting such
+ * a context with GRX_COLOR_MODE_BLEND composites it over the destination,
+ * see blendblt.c.
+ */
+
+#include "colors.h"
+#include "globals.h"
+#include "libgrx.h"
+#include "grdriver.h"
+#include "allocate.h"
+#include "arith.h"
+#include "mempeek.h"
+#include "memfill.h"
+#include "blend.h"
+
+#define OPAQUE          0xFF000000UL
+#define PIX2COL(p)      ((p) & 0xFFFFFF)
+#define COL2PIX(c)      ((c) & 0xFFFFFF)
+
+/* frame offset address calculation */
+#define FOFS(x,y,lo) umuladd32((y),(lo),((x)<<2))
+#define SETFARSEL(sel)
+
+/* XOR the color channels and make the pixel opaque */
+#define poke_l_xor_opaque(p,v)  poke_l((p),(peek_l(p) ^ (v)) | OPAQUE)
+
+static INLINE
+GrxColor readpixel(GrxFrame *c,int x,int y)
+{
+        GRX_ENTER();
+        GRX_RETURN(PIX2COL(peek_l(&c->base_address.plane0[FOFS(x,y,c->line_offset)])));
+}
+
+static INLINE
+void drawpixel(int x,int y,GrxColor color)
+{
+        unsigned char *ptr;
+        int op;
+        GRX_ENTER();
+        ptr  = &CURC->gc_base_address.plane0[FOFS(x,y,CURC->gc_line_offset)];
+        op   = C_OPER(color);
+        color= COL2PIX(color);
+        switch(op) {
+            case C_XOR: poke_l_xor_opaque(ptr,color); break;
+            case C_OR:  poke_l_or( ptr,color | OPAQUE); break;
+            case C_AND: poke_l_and(ptr,color | OPAQUE); break;
+            default:    poke_l(    ptr,color | OPAQUE); break;
+        }
+        GRX_LEAVE();
+}
+
+static void drawvline(int x,int y,int h,GrxColor color)
+{
+        unsigned lwdt;
+        unsigned char *pp;
+        int op;
+
+        GRX_ENTER();
+        lwdt = CURC->gc_line_offset;
+        pp   = &CURC->gc_base_address.plane0[FOFS(x,y,CURC->gc_line_offset)];
+        op   = C_OPER(color);
+        color= COL2PIX(color);
+        switch(op) {
+            case C_XOR:
+                for ( ; h > 0; h--, pp += lwdt) poke_l_xor_opaque(pp,color);
+                break;
+            case C_OR:  colfill_l_or( pp,lwdt,color | OPAQUE,h); break;
+            case C_AND: colfill_l_and(pp,lwdt,color | OPAQUE,h); break;
+            default:    colfill_l(    pp,lwdt,color | OPAQUE,h); break;
+        }
+        GRX_LEAVE();
+}
+
+static void drawblock(int x,int y,int w,int h,GrxColor color)
+{
+        unsigned skip;
+        int op;
+        unsigned char *pp;
+        GR_repl cval;
+
+        GRX_ENTER();
+        skip  = CURC->gc_line_offset;
+        pp    = &CURC->gc_base_address.plane0[FOFS(x,y,skip)];
+        skip -= w<<2;
+        op    = C_OPER(color);
+        color = COL2PIX(color);
+        if (op != C_XOR) color |= OPAQUE;
+        cval  = freplicate_l(color);
+        do {
+            int ww = w;
+            switch(op) {
+                case C_XOR:
+                    for ( ; ww > 0; ww--, pp += 4) poke_l_xor_opaque(pp,color);
+                    break;
+                case C_OR:  repfill_l_or( pp,cval,ww); break;
+                case C_AND: repfill_l_and(pp,cval,ww); break;
+                default:    repfill_l(    pp,cval,ww); break;
+            }
+            pp += skip;
+        } while(--h != 0);
+        GRX_LEAVE();
+}
+
+static void drawhline(int x,int y,int w,GrxColor color)
+{
+        drawblock(x,y,w,1,color);
+}
+
+static
+#include "generic/line.c"
+
+#define PK_SIZE         4
+#define PK_TYPE         GR_int32u
+#define PK_COL(c)       COL2PIX(c)
+#define PK_SET(p,v)     poke_l(p,(v) | OPAQUE)
+#define PK_XOR(p,v)     poke_l_xor_opaque(p,v)
+#define PK_OR(p,v)      poke_l_or(p,(v) | OPAQUE)
+#define PK_AND(p,v)     poke_l_and(p,(v) | OPAQUE)
+#include "generic/pkbitmap.c"
+
+/* anti-aliased text and shapes: the coverage is added to the alpha too */
+static void blendspan(int x,int y,int w,const unsigned char *alpha,GrxColor color)
+{
+        unsigned char *ptr;
+        GRX_ENTER();
+        ptr   = &CURC->gc_base_address.plane0[FOFS(x,y,CURC->gc_line_offset)];
+        color = COL2PIX(color);
+        for ( ; w > 0; w--, ptr += 4) {
+            GR_int32u pix, pa;
+            unsigned int a = *(alpha++);
+            if (a == 0) continue;
+            if (a == 255) {
+                poke_l(ptr,color | OPAQUE);
+                continue;
+            }
+            a   = blend_alpha256(a);
+            pix = peek_l(ptr);
+            pa  = (255 * a + (pix >> 24) * (256 - a)) >> 8;
+            poke_l(ptr,blend_888(color,PIX2COL(pix),a) | (pa << 24));
+        }
+        GRX_LEAVE();
+}
+
+static GrxColor *getindexedscanline(GrxFrame *c,int x,int y,int w,int *indx)
+{
+        GrxColor *pixels, *p;
+        unsigned char *pp;
+        GRX_ENTER();
+        p = pixels = _GrTempBufferAlloc(sizeof(GrxColor) * (w+1));
+        if (pixels) {
+            pp = &c->base_address.plane0[FOFS(0,y,c->line_offset)];
+            if (indx) {
+                for ( ; w > 0; w--) {
+                    int xx = x + *(indx++);
+                    *(p++) = PIX2COL(peek_l(pp + (xx << 2)));
+                }
+            } else {
+                for (pp += (x << 2); w > 0; w--, pp += 4) {
+                    *(p++) = PIX2COL(peek_l(pp));
+                }
+            }
+        }
+        GRX_RETURN(pixels);
+}
+
+static void putscanline(int x,int y,int w,const GrxColor *scl,GrxColor op)
+{
+        unsigned char *ptr;
+        GrxColor skipc;
+        GRX_ENTER();
+        ptr = &CURC->gc_base_address.plane0[FOFS(x,y,CURC->gc_line_offset)];
+        switch(C_OPER(op)) {
+            case C_IMAGE:
+                skipc = op ^ GRX_COLOR_MODE_IMAGE;
+                for ( ; w > 0; w--, ptr += 4) {
+                    GrxColor col = *(scl++);
+                    if (col != skipc) poke_l(ptr,COL2PIX(col) | OPAQUE);
+                }
+                break;
+            case C_XOR: for ( ; w > 0; w--, ptr += 4, scl++) poke_l_xor_opaque(ptr,COL2PIX(*scl)); break;
+            case C_OR:  for ( ; w > 0; w--, ptr += 4, scl++) poke_l_or(ptr,COL2PIX(*scl) | OPAQUE); break;
+            case C_AND: for ( ; w > 0; w--, ptr += 4, scl++) poke_l_and(ptr,COL2PIX(*scl) | OPAQUE); break;
+            default:    for ( ; w > 0; w--, ptr += 4, scl++) poke_l(ptr,COL2PIX(*scl) | OPAQUE); break;
+        }
+        GRX_LEAVE();
+}
+
+static INLINE
+void blit_pixel(unsigned char *p,GR_int32u v,int op)
+{
+        switch(op) {
+            case C_XOR: poke_l_xor_opaque(p,v); break;
+            case C_OR:  poke_l_or(p,v | OPAQUE); break;
+            default:    poke_l_and(p,v | OPAQUE); break;
+        }
+}
+
+/*
+ * XOR, OR and AND blits work on the color channels like drawing does, the
+ * source alpha is ignored and the destination stays a valid pixel
+ */
+static void blit_colors(GrxFrame *dst,int dx,int dy,
+                        GrxFrame *src,int sx,int sy,
+                        int w,int h,int op)
+{
+        const unsigned char *sp;
+        unsigned char *dp;
+        int step = 1, i;
+        if (dy > sy || (dy == sy && dx > sx)) {
+            sy += (h - 1);
+            dy += (h - 1);
+            step = (-1);
+        }
+        do {
+            sp = &src->base_address.plane0[FOFS(sx,sy,src->line_offset)];
+            dp = &dst->base_address.plane0[FOFS(dx,dy,dst->line_offset)];
+            if (step < 0) {
+                /* the rows may overlap in place, go right to left */
+                for (i = w - 1; i >= 0; i--) {
+                    GR_int32u v = PIX2COL(peek_l(sp + (i << 2)));
+                    blit_pixel(dp + (i << 2),v,op);
+                }
+            } else {
+                for (i = 0; i < w; i++) {
+                    GR_int32u v = PIX2COL(peek_l(sp + (i << 2)));
+                    blit_pixel(dp + (i << 2),v,op);
+                }
+            }
+            sy += step; dy += step;
+        } while(--h > 0);
+}
+
+static void bitblt(GrxFrame *dst,int dx,int dy,
+                   GrxFrame *src,int sx,int sy,
+                   int w,int h,GrxColor op)
+{
+        GRX_ENTER();
+        switch(C_OPER(op)) {
+            case C_BLEND:
+                _GrFrDrvBlendBitBlt(dst,dx,dy,src,sx,sy,w,h,op);
+                break;
+            case C_IMAGE:
+                _GrFrDrvGenericBitBlt(dst,dx,dy,src,sx,sy,w,h,op);
+                break;
+            case C_XOR:
+            case C_OR:
+            case C_AND:
+                blit_colors(dst,dx,dy,src,sx,sy,w,h,C_OPER(op));
+                break;
+            default:
+                _GrFrDrvPackedBitBltR2R(
+                    dst,(dx << 2),dy,
+                    src,(sx << 2),sy,
+                    (w << 2),h,
+                    op
+                );
+                break;
+        }
+        GRX_LEAVE();
+}
+
+GrxFrameDriver _GrFrameDriverRAM32A = {
+    .mode               = GRX_FRAME_MODE_RAM_32BPP_ARGB, /* frame mode */
+    .rmode              = GRX_FRAME_MODE_UNDEFINED,      /* compatible RAM frame mode */
+    .is_video           = FALSE,                         /* onscreen */
+    .row_align          = 4,                             /* scan line width alignment */
+    .num_planes         = 1,                             /* number of planes */
+    .bits_per_pixel     = 32,                            /* bits per pixel */
+    .max_plane_size     = 32*16*1024L*1024L,             /* max plane size the code can handle */
+    .init               = NULL,
+    .readpixel          = readpixel,
+    .drawpixel          = drawpixel,
+    .drawline           = drawline,
+    .drawhline          = drawhline,
+    .drawvline          = drawvline,
+    .drawblock          = drawblock,
+    .drawbitmap         = drawbitmap,
+    .drawpattern        = drawpattern,
+    .bitblt             = bitblt,
+    .bltv2r             = NULL,
+    .bltr2v             = NULL,
+    .getindexedscanline = getindexedscanline,
+    .putscanline        = putscanline,
+    .blendspan          = blendspan,
+};
@@ -43,8 +43,9 @@ GrxFrameDriver _GrFrameDriverRAM32L = {
     .bitblt             = bitblt,
     .bltv2r             = NULL,
     .bltr2v             = NULL,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
-    .putscanline        = _GrFrDrvGenericPutScanline,
+    .getindexedscanline = getindexedscanline,
+    .putscanline        = putscanline,
+    .blendspan          = blendspan,
 };
 
 /* some systems map LFB in normal user space (eg. Linux/svgalib) */
@@ -74,8 +75,9 @@ GrxFrameDriver _GrFrameDriverSVGA32L_LFB = {
     .bitblt             = bitblt,
     .bltv2r             = bitblt,
     .bltr2v             = bitblt,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
-    .putscanline        = _GrFrDrvGenericPutScanline,
+    .getindexedscanline = getindexedscanline,
+    .putscanline        = putscanline,
+    .blendspan          = blendspan,
 };
 
 #endif
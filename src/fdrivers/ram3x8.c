@@ -194,4 +194,5 @@ GrxFrameDriver _GrFrameDriverRAM3x8 = {
     .bltr2v             = NULL,
     .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
     .putscanline        = _GrFrDrvGenericPutScanline,
+    .blendspan          = _GrFrDrvGenericBlendSpan,
 };
@@ -287,4 +287,5 @@ GrxFrameDriver _GrFrameDriverRAM4x1 = {
     .bltr2v             = NULL,
     .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
     .putscanline        = _GrFrDrvGenericPutScanline,
+    .blendspan          = _GrFrDrvGenericBlendSpan,
 };
@@ -46,6 +46,7 @@ GrxFrameDriver _GrFrameDriverRAM8 = {
     .bltr2v             = NULL,
     .getindexedscanline = getindexedscanline,
     .putscanline        = putscanline,
+    .blendspan          = _GrFrDrvGenericBlendSpan,
 };
 
 
@@ -79,6 +80,7 @@ GrxFrameDriver _GrFrameDriverSVGA8_LFB = {
     .bltr2v             = bitblit,
     .getindexedscanline = getindexedscanline,
     .putscanline        = putscanline,
+    .blendspan          = _GrFrDrvGenericBlendSpan,
 };
 
 #endif
@@ -38,7 +38,7 @@
 #define maskset(d,c,msk) \
     poke_b((d),(peek_b(d) & ~(msk)) | ((c) & (msk)))
 
-static unsigned char *LineBuff = NULL;
+static GR_THREAD_LOCAL unsigned char *LineBuff = NULL;
 
 static int do_alloc(int width) {
     size_t bytes;
@@ -26,9 +26,6 @@
 #define FAR_ACCESS
 #include "driver16.h"
 
-static
-#include "generic/putscl.c"
-
 #include "sdlframe.h"
 
 /* -------------------------------------------------------------------- */
@@ -53,7 +50,7 @@ GrxFrameDriver _GrFrameDriverSDL16 = {
     .bitblt             = sdl_bitblt,
     .bltv2r             = bltv2r,
     .bltr2v             = sdl_bltr2v,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
+    .getindexedscanline = getindexedscanline,
     .putscanline        = sdl_putscanline,
 };
 
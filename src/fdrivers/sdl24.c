@@ -25,9 +25,6 @@
 #define FAR_ACCESS
 #include "driver24.h"
 
-static
-#include "generic/putscl.c"
-
 #include "sdlframe.h"
 
 /* -------------------------------------------------------------------- */
@@ -52,7 +49,7 @@ GrxFrameDriver _GrFrameDriverSDL24 = {
     .bitblt             = sdl_bitblt,
     .bltv2r             = bltv2r,
     .bltr2v             = sdl_bltr2v,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
+    .getindexedscanline = getindexedscanline,
     .putscanline        = sdl_putscanline,
 };
 
@@ -27,9 +27,6 @@
 #define FAR_ACCESS
 #include "driver32.h"
 
-static
-#include "generic/putscl.c"
-
 #include "sdlframe.h"
 
 /* -------------------------------------------------------------------- */
@@ -54,7 +51,7 @@ GrxFrameDriver _GrFrameDriverSDL32H = {
     .bitblt             = sdl_bitblt,
     .bltv2r             = bltv2r,
     .bltr2v             = sdl_bltr2v,
-    .getindexedscanline = _GrFrDrvGenericGetIndexedScanline,
+    .getindexedscanline = getindexedscanline,
     .putscanline        = sdl_putscanline,
 };
 
@@ -0,0 +1,406 @@
+/*
+ * dither.c ---- converting image rows to the colors of low depth frames
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Only integer arithmetic is used and only two rows of errors are kept, so
+ * this works on machines without a FPU and with images of any height.
+ */
+
+#include <glib.h>
+#include <string.h>
+
+#include <grx/context.h>
+#include <grx/draw.h>
+#include <grx/gformats.h>
+#include <grx/mode.h>
+
+#include "globals.h"
+#include "mouse.h"
+#include "libgrx.h"
+#include "clipping.h"
+#include "dither.h"
+#include "rgbconv.h"
+
+/* same rounding as grx_color_get() */
+#define ROUNDCOLORCOMP(x,n) (                                   \
+    ((unsigned int)(x) >= CLRINFO->mask[n]) ?                   \
+        CLRINFO->mask[n] :                                      \
+        (((x) + CLRINFO->round[n]) & CLRINFO->mask[n])          \
+)
+
+#define GRAY(r,g,b)     (((r) * 19595 + (g) * 38470 + (b) * 7471) >> 16)
+
+/* how the rows are written */
+typedef enum {
+    PACK_NONE,          /* grx_put_scanline() */
+    PACK_1BPP,
+    PACK_1BPP_INV,      /* 0 = white, 1 = black */
+    PACK_2BPP,
+    PACK_8BPP,
+} PackType;
+
+struct _GR_dither {
+    GrxImageDither method;
+    GrxColorPaletteType type;
+    PackType pack;
+    int      x, w;
+    int      nch;           /* 1 for grayscale frames, 3 otherwise */
+    int      row;           /* rows done */
+    _GR_rgbConv *cv;
+    GrxColor *colors;
+    gint16  *err[2];        /* (w + 2) * nch errors, this row and the next */
+    gint16   offset[3][64]; /* ordered: added to the samples */
+    guint8   level[256];    /* grayscale: sample to level */
+    guint8   value[3][256]; /* grayscale: level to gray, RGB: the rounded samples */
+};
+
+static GrxImageDither image_dither = GRX_IMAGE_DITHER_NONE;
+
+/* the usual recursive 8x8 matrix, 0..63 */
+static const guint8 bayer[8][8] = {
+    {  0, 32,  8, 40,  2, 34, 10, 42 },
+    { 48, 16, 56, 24, 50, 18, 58, 26 },
+    { 12, 44,  4, 36, 14, 46,  6, 38 },
+    { 60, 28, 52, 20, 62, 30, 54, 22 },
+    {  3, 35, 11, 43,  1, 33,  9, 41 },
+    { 51, 19, 59, 27, 49, 17, 57, 25 },
+    { 15, 47,  7, 39, 13, 45,  5, 37 },
+    { 63, 31, 55, 23, 61, 29, 53, 21 },
+};
+
+/**
+ * grx_set_image_dither:
+ * @dither: the dithering method
+ *
+ * Sets how grx_context_load_from_png(), grx_context_load_from_jpeg(),
+ * grx_context_load_from_pnm() and the other image loaders put the pixels
+ * into contexts with 256 colors or less.
+ *
+ * With #GRX_IMAGE_DITHER_NONE, the default, every pixel gets the nearest
+ * color, which makes blobs of photos on monochrome and 4 color displays.
+ * Dithering spreads the difference to the nearest color over the
+ * neighbouring pixels, #GRX_IMAGE_DITHER_ORDERED with a fixed pattern and
+ * #GRX_IMAGE_DITHER_FLOYD_STEINBERG by diffusing it to the next pixels,
+ * which looks better but is slower.
+ *
+ * Contexts with more colors are not dithered.
+ */
+void grx_set_image_dither(GrxImageDither dither)
+{
+  image_dither = dither;
+}
+
+/**
+ * grx_get_image_dither:
+ *
+ * Gets the method set by grx_set_image_dither().
+ *
+ * Returns: the dithering method
+ */
+GrxImageDither grx_get_image_dither(void)
+{
+  return image_dither;
+}
+
+/* frames whose memory can be written directly */
+static PackType pack_type(GrxFrameMode mode)
+{
+  switch( mode ){
+    case GRX_FRAME_MODE_RAM_1BPP:
+    case GRX_FRAME_MODE_LFB_MONO10:
+      return PACK_1BPP;
+    case GRX_FRAME_MODE_LFB_MONO01:
+      return PACK_1BPP_INV;
+    case GRX_FRAME_MODE_RAM_2BPP:
+    case GRX_FRAME_MODE_LFB_2BPP:
+      return PACK_2BPP;
+    case GRX_FRAME_MODE_RAM_8BPP:
+#ifdef LFB_BY_NEAR_POINTER
+    case GRX_FRAME_MODE_LFB_8BPP:
+#endif
+      return PACK_8BPP;
+    default:
+      return PACK_NONE;
+    }
+}
+
+/* the offsets of the ordered dither for levels step apart */
+static void set_offsets(gint16 *offset, int step)
+{
+  int i;
+
+  for( i=0; i<64; i++ )
+    offset[i] = ((2 * i + 1) * step) / 128 - step / 2;
+}
+
+/*
+ * Sets up the conversion of w pixels per row to the current context,
+ * starting at x. Returns NULL if out of memory.
+ */
+_GR_dither *_GrDitherNew(int x, int w)
+{
+  _GR_dither *d;
+  int i, v, n, step;
+
+  d = g_try_new0( _GR_dither,1 );
+  if( d == NULL ) return NULL;
+  d->method = (CLRINFO->ncolors <= 256) ? image_dither : GRX_IMAGE_DITHER_NONE;
+  d->type = CLRINFO->palette_type;
+  d->pack = pack_type( CURC->gc_driver->mode );
+  d->x = x;
+  d->w = w;
+  d->nch = (d->type == GRX_COLOR_PALETTE_TYPE_GRAYSCALE) ? 1 : 3;
+  d->cv = _GrRgbConvNew();
+  d->colors = g_try_new( GrxColor,w );
+  if( d->method == GRX_IMAGE_DITHER_FLOYD_STEINBERG ){
+    d->err[0] = g_try_new0( gint16,(w + 2) * d->nch );
+    d->err[1] = g_try_new0( gint16,(w + 2) * d->nch );
+    if( d->err[0] == NULL || d->err[1] == NULL ){
+      _GrDitherFree( d );
+      return NULL;
+      }
+    }
+  if( d->colors == NULL ){
+    _GrDitherFree( d );
+    return NULL;
+    }
+
+  switch( d->type ){
+    case GRX_COLOR_PALETTE_TYPE_GRAYSCALE:
+      n = CLRINFO->ncolors - 1;
+      for( v=0; v<256; v++ ) d->level[v] = (v * n + 127) / 255;
+      for( i=0; i<=n; i++ ) d->value[0][i] = (i * 255) / n;
+      set_offsets( d->offset[0],255 / n );
+      break;
+    case GRX_COLOR_PALETTE_TYPE_RGB:
+      for( i=0; i<3; i++ ){
+        for( v=0; v<256; v++ ) d->value[i][v] = ROUNDCOLORCOMP( v,i );
+        set_offsets( d->offset[i],256 - CLRINFO->mask[i] );
+        }
+      break;
+    default:
+      /* a guess: the table holds about n levels of each component */
+      for( n=1; (n + 1) * (n + 1) * (n + 1) <= CLRINFO->ncolors; n++ ) ;
+      step = MIN( 256 / n,255 );
+      for( i=0; i<3; i++ ) set_offsets( d->offset[i],step );
+      break;
+    }
+
+  return d;
+}
+
+void _GrDitherFree(_GR_dither *d)
+{
+  if( d == NULL ) return;
+  if( d->cv ) _GrRgbConvFree( d->cv );
+  g_free( d->colors );
+  g_free( d->err[0] );
+  g_free( d->err[1] );
+  g_free( d );
+}
+
+/* the color for the samples in v, which are replaced by what it shows */
+static INLINE GrxColor quantize(_GR_dither *d, int *v)
+{
+  GrxColor c;
+
+  switch( d->type ){
+    case GRX_COLOR_PALETTE_TYPE_GRAYSCALE:
+      c = d->level[v[0]];
+      v[0] = d->value[0][c];
+      return c;
+    case GRX_COLOR_PALETTE_TYPE_RGB:
+      c = d->cv->lut[0][v[0]] | d->cv->lut[1][v[1]] | d->cv->lut[2][v[2]];
+      v[0] = d->value[0][v[0]];
+      v[1] = d->value[1][v[1]];
+      v[2] = d->value[2][v[2]];
+      return c;
+    default:
+      c = _GrRgbConvLookup( d->cv,v[0],v[1],v[2] );
+      if( c < CLRINFO->ncolors && CLRINFO->ctable[c].defined ){
+        v[0] = CLRINFO->ctable[c].r;
+        v[1] = CLRINFO->ctable[c].g;
+        v[2] = CLRINFO->ctable[c].b;
+        }
+      return c;
+    }
+}
+
+/* the samples of pixel, gray for grayscale frames */
+static INLINE void samples(_GR_dither *d, const guint8 *pix, int channels, int *v)
+{
+  if( channels < 3 )
+    v[0] = v[1] = v[2] = pix[0];
+  else if( d->nch == 1 )
+    v[0] = GRAY( pix[0],pix[1],pix[2] );
+  else{
+    v[0] = pix[0];
+    v[1] = pix[1];
+    v[2] = pix[2];
+    }
+}
+
+static void dither_none(_GR_dither *d, const guint8 *pix, int channels, int use_alpha)
+{
+  int x;
+
+  if( channels >= 3 && !use_alpha ){
+    _GrRgbConvRow( d->cv,pix,channels,d->w,d->colors );
+    return;
+    }
+  for( x=0; x<d->w; x++,pix+=channels ){
+    if( use_alpha && pix[3] == 0 )
+      d->colors[x] = GRX_COLOR_NONE;
+    else if( channels < 3 )
+      d->colors[x] = _GrRgbConvPixel( d->cv,pix[0],pix[0],pix[0] );
+    else
+      d->colors[x] = _GrRgbConvPixel( d->cv,pix[0],pix[1],pix[2] );
+    }
+}
+
+static void dither_ordered(_GR_dither *d, int y, const guint8 *pix, int channels,
+                           int use_alpha)
+{
+  const guint8 *bm = bayer[y & 7];
+  int x, i, v[3];
+
+  for( x=0; x<d->w; x++,pix+=channels ){
+    if( use_alpha && pix[3] == 0 ){
+      d->colors[x] = GRX_COLOR_NONE;
+      continue;
+      }
+    samples( d,pix,channels,v );
+    for( i=0; i<d->nch; i++ )
+      v[i] = CLAMP( v[i] + d->offset[i][bm[(d->x + x) & 7]],0,255 );
+    d->colors[x] = quantize( d,v );
+    }
+}
+
+/* left to right and right to left in turns, so that no drift builds up */
+static void dither_fs(_GR_dither *d, const guint8 *pix, int channels, int use_alpha)
+{
+  gint16 *cur = d->err[d->row & 1];
+  gint16 *nxt = d->err[(d->row & 1) ^ 1];
+  int nch = d->nch;
+  int dir = (d->row & 1) ? -1 : 1;
+  int n, x, i, e, e7, e3, e5, v[3], want[3];
+
+  memset( nxt,0,(d->w + 2) * nch * sizeof(gint16) );
+  x = (dir > 0) ? 0 : d->w - 1;
+  for( n=0; n<d->w; n++,x+=dir ){
+    const guint8 *p = pix + x * channels;
+    gint16 *ce = cur + (x + 1) * nch;
+    gint16 *ne = nxt + (x + 1) * nch;
+    if( use_alpha && p[3] == 0 ){
+      d->colors[x] = GRX_COLOR_NONE;
+      continue;
+      }
+    samples( d,p,channels,v );
+    for( i=0; i<nch; i++ )
+      want[i] = v[i] = CLAMP( v[i] + ce[i],0,255 );
+    d->colors[x] = quantize( d,v );
+    for( i=0; i<nch; i++ ){
+      e  = want[i] - v[i];
+      e7 = (e * 7) / 16;
+      e3 = (e * 3) / 16;
+      e5 = (e * 5) / 16;
+      ce[dir * nch + i] += e7;
+      ne[-dir * nch + i] += e3;
+      ne[i] += e5;
+      ne[dir * nch + i] += e - e7 - e3 - e5;
+      }
+    }
+}
+
+/* packs the colors into pixels of bpp bits, the first one in the low bits */
+static void pack_bits(guint8 *p, int x, const GrxColor *c, int w, int bpp, guint inv)
+{
+  int ppb = 8 / bpp;
+  guint pmask = (1 << bpp) - 1;
+  guint bits = 0, mask = 0;
+
+  for( ; w > 0; w--,x++,c++ ){
+    int sh = (x % ppb) * bpp;
+    if( *c != GRX_COLOR_NONE ){
+      mask |= pmask << sh;
+      bits |= ((*c ^ inv) & pmask) << sh;
+      }
+    if( sh == 8 - bpp ){
+      if( mask ) p[x / ppb] = (p[x / ppb] & ~mask) | bits;
+      bits = mask = 0;
+      }
+    }
+  if( mask ) p[(x - 1) / ppb] = (p[(x - 1) / ppb] & ~mask) | bits;
+}
+
+static void putrow(_GR_dither *d, int y)
+{
+  const GrxColor *c;
+  guint8 *p;
+  int x1, x2, w, i;
+
+  if( d->pack == PACK_NONE ){
+    /* the drivers would write GRX_COLOR_NONE as black in WRITE mode */
+    c = d->colors;
+    for( x1=0; x1<d->w; x1=x2 ){
+      while( x1 < d->w && c[x1] == GRX_COLOR_NONE ) x1++;
+      for( x2=x1; x2 < d->w && c[x2] != GRX_COLOR_NONE; x2++ );
+      if( x2 > x1 )
+        grx_put_scanline( d->x + x1,d->x + x2 - 1,y,&c[x1],GRX_COLOR_MODE_WRITE );
+      }
+    return;
+    }
+  x1 = d->x;
+  x2 = d->x + d->w - 1;
+  clip_hline( CURC,x1,x2,y );
+  c = &d->colors[x1 - d->x];
+  w = x2 - x1 + 1;
+  mouse_block( CURC,x1,y,x2,y );
+  p = (guint8 *)&CURC->gc_base_address.plane0[(y + CURC->y_offset) *
+                                              CURC->gc_line_offset];
+  x1 += CURC->x_offset;
+  switch( d->pack ){
+    case PACK_1BPP:     pack_bits( p,x1,c,w,1,0 ); break;
+    case PACK_1BPP_INV: pack_bits( p,x1,c,w,1,1 ); break;
+    case PACK_2BPP:     pack_bits( p,x1,c,w,2,0 ); break;
+    default:
+      for( i=0; i<w; i++ )
+        if( c[i] != GRX_COLOR_NONE ) p[x1 + i] = c[i];
+      break;
+    }
+  mouse_unblock();
+}
+
+/*
+ * Converts and writes row y. pix has channels samples per pixel: gray,
+ * RGB or RGBA. If use_alpha is set, RGBA pixels with a zero alpha are left
+ * alone, other alpha values must have been mixed in already.
+ */
+void _GrDitherRow(_GR_dither *d, int y, const guint8 *pix, int channels, int use_alpha)
+{
+  use_alpha = use_alpha && channels == 4;
+  switch( d->method ){
+    case GRX_IMAGE_DITHER_ORDERED:
+      dither_ordered( d,y,pix,channels,use_alpha );
+      break;
+    case GRX_IMAGE_DITHER_FLOYD_STEINBERG:
+      dither_fs( d,pix,channels,use_alpha );
+      break;
+    default:
+      dither_none( d,pix,channels,use_alpha );
+      break;
+    }
+  putrow( d,y );
+  d->row++;
+}
@@ -36,6 +36,15 @@ int grx_context_load_from_png( GrxContext *grc, char *pngfn, int use_alpha )
   return -1;
 }
 
+/*
+** grx_context_load_from_png_at - Returns error
+*/
+
+int grx_context_load_from_png_at( GrxContext *grc, char *pngfn, int x, int y, int use_alpha )
+{
+  return -1;
+}
+
 /*
 ** grx_query_pnm_file - Returns error
 */
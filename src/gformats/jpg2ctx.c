@@ -29,6 +29,8 @@
 #include <grx/error.h>
 #include <grx/extents.h>
 
+#include "dither.h"
+
 typedef void(*grx_jpeg_src_func)(j_decompress_ptr cinfo, void * data);
 
 static gboolean readjpeg(grx_jpeg_src_func src_func, void *src_func_data, GrxContext *grc, int scale);
@@ -54,7 +56,8 @@ static void grx_jpeg_stdio_src_func(j_decompress_ptr cinfo, void * data)
  * much of the image as it can.
  *
  * If color mode is not in RGB mode, the functions allocates as many colors as
- * it can.
+ * it can. Contexts with 256 colors or less are dithered as set by
+ * grx_set_image_dither().
  *
  * Returns: %TRUE on success, otherwise %FALSE
  */
@@ -106,7 +109,8 @@ static void grx_jpeg_stdio_mem_func(j_decompress_ptr cinfo, void * data)
  * much of the image as it can.
  *
  * If color mode is not in RGB mode, the functions allocates as many colors as
- * it can.
+ * it can. Contexts with 256 colors or less are dithered as set by
+ * grx_set_image_dither().
  *
  * Returns: %TRUE on success, otherwise %FALSE
  */
@@ -191,14 +195,13 @@ static gboolean readjpeg(grx_jpeg_src_func src_func, void *src_func_data, GrxCon
   JSAMPARRAY buffer;
   int row_stride;
   int maxwidth, maxheight;
-  static GrxColor *pColors = NULL;
-  unsigned char *pix_ptr;
-  int x, y, r, g, b;
+  _GR_dither * volatile dt = NULL;
+  int y;
 
   cinfo.err = jpeg_std_error( &jerr.pub );
   jerr.pub.error_exit = my_error_exit;
   if( setjmp( jerr.setjmp_buffer ) ) {
-    if( pColors) free( pColors );
+    _GrDitherFree( dt );
     jpeg_destroy_decompress( &cinfo );
     return FALSE;
   }
@@ -220,31 +223,17 @@ static gboolean readjpeg(grx_jpeg_src_func src_func, void *src_func_data, GrxCon
              grx_get_width() : cinfo.output_width;
   maxheight = (cinfo.output_height > grx_get_height()) ?
              grx_get_height() : cinfo.output_height;
-  pColors = malloc( maxwidth * sizeof(GrxColor) );
-  if( pColors == NULL ) longjmp( jerr.setjmp_buffer,1 );
+  dt = _GrDitherNew( 0,maxwidth );
+  if( dt == NULL ) longjmp( jerr.setjmp_buffer,1 );
 
   for( y=0; y<maxheight; y++ ){
     jpeg_read_scanlines( &cinfo,buffer,1 );
-    pix_ptr = buffer[0];
-    if( cinfo.output_components == 1 ){
-      for( x=0; x<maxwidth; x++ ){
-        r = *pix_ptr++;
-        pColors[x] = grx_color_get( r,r,r );
-        }
-      }
-    else{
-      for( x=0; x<maxwidth; x++ ){
-        r = *pix_ptr++;
-        g = *pix_ptr++;
-        b = *pix_ptr++;
-        pColors[x] = grx_color_get( r,g,b );
-        }
-      }
-    grx_put_scanline( 0,maxwidth-1,y,pColors,GRX_COLOR_MODE_WRITE );
+    _GrDitherRow( dt,y,buffer[0],cinfo.output_components,FALSE );
     }
 
   jpeg_finish_decompress( &cinfo );
   jpeg_destroy_decompress( &cinfo );
+  _GrDitherFree( dt );
   
   return TRUE;
 }
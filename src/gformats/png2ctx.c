@@ -28,13 +28,19 @@
 #include <grx/draw.h>
 #include <grx/error.h>
 #include <grx/extents.h>
+#include <grx/gformats.h>
+#include <grx/mode.h>
+
+#include "dither.h"
 
 #ifndef png_jmpbuf
 #  define png_jmpbuf(png_ptr) ((png_ptr)->jmpbuf)
 #endif
 
-static gboolean readpng(FILE *f, GrxContext *grc, int use_alpha);
+static gboolean readpng(FILE *f, int x0, int y0, int use_alpha);
 static gboolean querypng(FILE *f, int *w, int *h);
+static void storeargb(GrxContext *grc, int x, int y, png_byte *pix_ptr, int w,
+                      int channels, int use_alpha);
 
 /**
  * grx_context_load_from_png:
@@ -51,14 +57,45 @@ static gboolean querypng(FILE *f, int *w, int *h);
  * If color mode is not in RGB mode, the routine allocates as
  * many colors as it can
  *
+ * Contexts with 256 colors or less are dithered as set by
+ * grx_set_image_dither().
+ *
+ * A #GRX_FRAME_MODE_RAM_32BPP_ARGB context keeps the alpha channel of the
+ * image if @use_alpha is %TRUE, so it can be composited later with
+ * #GRX_COLOR_MODE_BLEND, instead of being mixed with the old contents.
+ *
  * Returns: %TRUE on success, otherwise %FALSE
  */
 gboolean grx_context_load_from_png(GrxContext *grc, const char *pngfn, int use_alpha, GError **error)
+{
+  return grx_context_load_from_png_at( grc,pngfn,0,0,use_alpha,error );
+}
+
+/**
+ * grx_context_load_from_png_at:
+ * @context: (nullable): Context to be loaded or %NULL to use the global context
+ * @filename: (type filename): Name of png file
+ * @x: the X coordinate of the image's top left corner in the context
+ * @y: the Y coordinate of the image's top left corner in the context
+ * @use_alpha: if %TRUE, use alpha channel if available
+ * @error: pointer to hold an error or %NULL to ignore
+ *
+ * Like grx_context_load_from_png(), but puts the image at @x, @y. The parts
+ * outside of the clipping box of the context are skipped.
+ *
+ * The image is decoded one row at a time, so loading needs little memory
+ * besides the context itself, except for interlaced images, which are
+ * decoded as a whole.
+ *
+ * Returns: %TRUE on success, otherwise %FALSE
+ */
+gboolean grx_context_load_from_png_at(GrxContext *grc, const char *pngfn, int x, int y,
+                                      int use_alpha, GError **error)
 {
   GrxContext grcaux;
   FILE *f;
   gboolean r;
-  
+
   f = fopen( pngfn,"rb" );
   if (f == NULL) {
     g_set_error(error, G_IO_ERROR, g_io_error_from_errno(errno),
@@ -68,7 +105,7 @@ gboolean grx_context_load_from_png(GrxContext *grc, const char *pngfn, int use_a
 
   grx_save_current_context( &grcaux );
   if( grc != NULL ) grx_set_current_context( grc );
-  r = readpng( f,grc,use_alpha );
+  r = readpng( f,x,y,use_alpha );
   grx_set_current_context( &grcaux );
 
   fclose( f );
@@ -108,26 +145,52 @@ gboolean grx_query_png_file(const char *pngfn, int *width, int *height)
   return r;
 }
 
-static gboolean readpng(FILE *f, GrxContext *grc, int use_alpha)
+/* mixes row with the pixels under it, as far as the alpha channel says */
+static void blendrow(png_byte *pix_ptr, int w, const GrxColor *under, png_byte *mixed)
+{
+  unsigned int alpha;
+  unsigned char ro, go, bo;
+  int x;
+
+  for( x=0; x<w; x++,pix_ptr+=4,mixed+=4 ){
+    alpha = pix_ptr[3];
+    mixed[3] = (alpha == 0) ? 0 : 255;
+    if( alpha == 0 || alpha == 255 ){
+      mixed[0] = pix_ptr[0];
+      mixed[1] = pix_ptr[1];
+      mixed[2] = pix_ptr[2];
+      continue;
+      }
+    grx_color_query( under[x],&ro,&go,&bo );
+    mixed[0] = (pix_ptr[0] * alpha + ro * (255 - alpha) + 127) / 255;
+    mixed[1] = (pix_ptr[1] * alpha + go * (255 - alpha) + 127) / 255;
+    mixed[2] = (pix_ptr[2] * alpha + bo * (255 - alpha) + 127) / 255;
+    }
+}
+
+static gboolean readpng(FILE *f, int x0, int y0, int use_alpha)
 {
+  GrxContext *grc = grx_get_current_context();
   png_struct *png_ptr = NULL;
   png_info *info_ptr = NULL;
   png_byte buf[8];
-  png_byte *png_pixels = NULL;
-  png_byte **row_pointers = NULL;
-  png_byte *pix_ptr = NULL;
+  png_byte * volatile png_pixels = NULL;
+  png_byte ** volatile row_pointers = NULL;
+  png_byte * volatile mixed = NULL;
+  _GR_dither * volatile dt = NULL;
+  png_byte *pix_ptr;
   png_uint_32 row_bytes;
   png_uint_32 width;
   png_uint_32 height;
   int bit_depth;
   int color_type;
-  int alpha_present;
-  int i, x, y;
-  unsigned char r, g, b;
-  int alpha = 0;
-  unsigned char ro, go, bo;
-  int maxwidth, maxheight;
-  GrxColor *pColors = NULL;
+  int channels;
+  int passes;
+  int argb;
+  int y;
+  int cx1, cy1, cx2, cy2;
+  int sx, dx, dw, dy;
+  const GrxColor *under;
 
   /* is it a PNG file? */
   if( fread( buf,1,8,f ) != 8 ) return FALSE;
@@ -146,6 +209,10 @@ static gboolean readpng(FILE *f, GrxContext *grc, int use_alpha)
 
   if( setjmp( png_jmpbuf(png_ptr) ) ){
     png_destroy_read_struct( &png_ptr,&info_ptr,NULL );
+    free( row_pointers );
+    free( png_pixels );
+    free( mixed );
+    _GrDitherFree( dt );
     return FALSE;
     }
 
@@ -173,6 +240,8 @@ static gboolean readpng(FILE *f, GrxContext *grc, int use_alpha)
   if( color_type == PNG_COLOR_TYPE_GRAY ||
       color_type == PNG_COLOR_TYPE_GRAY_ALPHA )
     png_set_gray_to_rgb( png_ptr );
+  /* the interlace passes have to be combined in a whole image */
+  passes = png_set_interlace_handling( png_ptr );
 
   /* we don't do gamma correction by now */
 
@@ -181,85 +250,106 @@ static gboolean readpng(FILE *f, GrxContext *grc, int use_alpha)
                 &color_type,NULL,NULL,NULL);
 
   if( color_type == PNG_COLOR_TYPE_RGB )
-    alpha_present = 0;
+    channels = 3;
   else if( color_type == PNG_COLOR_TYPE_RGB_ALPHA )
-    alpha_present = 1;
+    channels = 4;
   else{
     png_destroy_read_struct( &png_ptr,&info_ptr,NULL );
     return FALSE;
     }
 
-  row_bytes = png_get_rowbytes( png_ptr,info_ptr );
-
-  png_pixels = (png_byte *) malloc( row_bytes * height * sizeof(png_byte) );
-  if( png_pixels == NULL ){
+  /* the part of the image that is visible in the context */
+  grx_context_get_clip_box( grc,&cx1,&cy1,&cx2,&cy2 );
+  sx = MAX( cx1 - x0,0 );
+  dx = x0 + sx;
+  dw = MIN( (gint64)x0 + width - 1,cx2 ) - dx + 1;
+  if( dw <= 0 || y0 > cy2 || (gint64)y0 + height <= cy1 ){
     png_destroy_read_struct( &png_ptr,&info_ptr,NULL );
-    return FALSE;
+    return TRUE;
     }
 
-  row_pointers = (png_byte **) malloc( height * sizeof(png_bytep) );
-  if( row_pointers == NULL ){
+  row_bytes = png_get_rowbytes( png_ptr,info_ptr );
+  png_pixels = malloc( (size_t)row_bytes * (passes > 1 ? height : 1) );
+  argb = grc->gc_driver->mode == GRX_FRAME_MODE_RAM_32BPP_ARGB;
+  if( !argb ){
+    mixed = malloc( dw * 4 );
+    dt = _GrDitherNew( dx,dw );
+    }
+  if( png_pixels == NULL || (!argb && (mixed == NULL || dt == NULL)) ){
     png_destroy_read_struct( &png_ptr,&info_ptr,NULL );
     free( png_pixels );
-    png_pixels = NULL;
+    free( mixed );
+    _GrDitherFree( dt );
     return FALSE;
     }
 
-  for( i=0; i<height; i++ )
-    row_pointers[i] = png_pixels + i * row_bytes;
-
-  png_read_image (png_ptr, row_pointers);
-
-  png_read_end (png_ptr, info_ptr);
-
-  png_destroy_read_struct( &png_ptr,&info_ptr,NULL );
-
-  /* write data to context */
-  maxwidth = (width > grx_get_width()) ? grx_get_width() : width;
-  maxheight = (height > grx_get_height()) ? grx_get_height() : height;
-
-  pColors = malloc( maxwidth * sizeof(GrxColor) );
-  if( pColors == NULL ){
-    free( row_pointers );
-    row_pointers = NULL;
-    free( png_pixels );
-    png_pixels = NULL;
-    return FALSE;
+  if( passes > 1 ){
+    row_pointers = malloc( height * sizeof(png_bytep) );
+    if( row_pointers == NULL ) png_error( png_ptr,"out of memory" );
+    for( y=0; y<height; y++ )
+      row_pointers[y] = png_pixels + (size_t)y * row_bytes;
+    png_read_image( png_ptr,row_pointers );
     }
 
-  for( y=0; y<maxheight; y++ ){
-    pix_ptr = row_pointers[y];
-    if( alpha_present && use_alpha ){
-      memcpy( pColors,grx_get_scanline( 0,maxwidth-1,y,NULL ),
-              sizeof(GrxColor)*maxwidth );
+  /* write data to context, stopping after the last visible row */
+  for( y=0; y<height; y++ ){
+    dy = y0 + y;
+    if( dy > cy2 ) break;
+    if( passes > 1 )
+      pix_ptr = png_pixels + (size_t)y * row_bytes;
+    else{
+      pix_ptr = png_pixels;
+      png_read_row( png_ptr,pix_ptr,NULL );
+      }
+    if( dy < cy1 ) continue;
+    pix_ptr += sx * channels;
+    if( argb ){
+      storeargb( grc,dx,dy,pix_ptr,dw,channels,use_alpha );
+      continue;
       }
-    for( x=0; x<width; x++ ){
-      r = *pix_ptr++;
-      g = *pix_ptr++;
-      b = *pix_ptr++;
-      alpha = 0;
-      if( alpha_present )
-        alpha = *pix_ptr++;
-      if( x < maxwidth ){
-        if( alpha_present && use_alpha ){
-          grx_color_query( pColors[x],&ro,&go,&bo );
-          r = r * (alpha/255.0) + ro * ((255-alpha)/255.0);
-          g = g * (alpha/255.0) + go * ((255-alpha)/255.0);
-          b = b * (alpha/255.0) + bo * ((255-alpha)/255.0);
-          }
-        pColors[x] = grx_color_get( r,g,b );
-        }
+    if( channels == 4 && use_alpha ){
+      under = grx_get_scanline( dx,dx+dw-1,dy,NULL );
+      if( under == NULL ) continue;
+      blendrow( pix_ptr,dw,under,mixed );
+      _GrDitherRow( dt,dy,mixed,4,TRUE );
       }
-    grx_put_scanline( 0,maxwidth-1,y,pColors,GRX_COLOR_MODE_WRITE );
+    else
+      _GrDitherRow( dt,dy,pix_ptr,channels,FALSE );
     }
 
-  if( pColors) free( pColors );
-  if( row_pointers ) free( row_pointers );
-  if( png_pixels ) free( png_pixels );
+  png_destroy_read_struct( &png_ptr,&info_ptr,NULL );
+  free( row_pointers );
+  free( png_pixels );
+  free( mixed );
+  _GrDitherFree( dt );
 
   return TRUE;
 }
 
+/* ARGB contexts keep the alpha channel, premultiplied */
+static void storeargb(GrxContext *grc, int x, int y, png_byte *pix_ptr, int w,
+                      int channels, int use_alpha)
+{
+  guint32 *dp;
+  guint32 r, g, b, alpha;
+
+  dp = (guint32 *)&grc->gc_base_address.plane0[(y + grc->y_offset) *
+                                                grc->gc_line_offset];
+  dp += grc->x_offset + x;
+  for( ; w > 0; w--,pix_ptr+=channels ){
+    r = pix_ptr[0];
+    g = pix_ptr[1];
+    b = pix_ptr[2];
+    alpha = (channels == 4 && use_alpha) ? pix_ptr[3] : 255;
+    if( alpha != 255 ){
+      r = (r * alpha + 127) / 255;
+      g = (g * alpha + 127) / 255;
+      b = (b * alpha + 127) / 255;
+      }
+    *dp++ = (alpha << 24) | (r << 16) | (g << 8) | b;
+    }
+}
+
 static gboolean querypng(FILE *f, int *w, int *h)
 {
   png_struct *png_ptr = NULL;
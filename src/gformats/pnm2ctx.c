@@ -33,6 +33,8 @@
 #include <grx/gformats.h>
 #include <grx/mode.h>
 
+#include "dither.h"
+
 typedef struct{
   int method;  /* 0=file, 1=buffer */
   FILE *file;
@@ -201,7 +203,7 @@ static gboolean _GrLoadContextFromPgm( inputstruct *is, int width,
   int needcoloradjust = 0;
   int maxwidth, maxheight;
   double coloradjust = 255.0;
-  GrxColor *pColors=NULL;
+  _GR_dither *dt=NULL;
   unsigned char *pData=NULL, *pCursor;
   gboolean res = TRUE;
 
@@ -214,25 +216,25 @@ static gboolean _GrLoadContextFromPgm( inputstruct *is, int width,
     }
 
   pData = NULL;
-  pColors = malloc( maxwidth * sizeof(GrxColor) );
-  if(pColors == NULL) { res = FALSE; goto out; }
+  dt = _GrDitherNew( 0,maxwidth );
+  if(dt == NULL) { res = FALSE; goto out; }
   pData = malloc( width * sizeof(char) );
   if(pData == NULL) { res = FALSE; goto out; }
 
   for( y=0; y<maxheight; y++ ){
     if( inputread( pData,1,width,is ) != width ) { res = FALSE; goto out; }
-    pCursor = pData;
-    for( x=0; x<maxwidth; x++ ){
-      if( needcoloradjust )
+    if( needcoloradjust ){
+      pCursor = pData;
+      for( x=0; x<maxwidth; x++ ){
         *pCursor *= coloradjust;
-      pColors[x] = grx_color_get( *pCursor,*pCursor,*pCursor );
-      pCursor += 1;
+        pCursor += 1;
+        }
       }
-    grx_put_scanline( 0,maxwidth-1,y,pColors,GRX_COLOR_MODE_WRITE );
+    _GrDitherRow( dt,y,pData,1,FALSE );
     }
 
 out:
-  if( pColors != NULL ) free( pColors );
+  _GrDitherFree( dt );
   if( pData != NULL ) free( pData );
   return res;
 }
@@ -244,7 +246,7 @@ static gboolean _GrLoadContextFromPpm( inputstruct *is, int width,
   int needcoloradjust = 0;
   int maxwidth, maxheight;
   double coloradjust = 255.0;
-  GrxColor *pColors=NULL;
+  _GR_dither *dt=NULL;
   unsigned char *pRGB=NULL, *pCursor;
   gboolean res = TRUE;
 
@@ -257,28 +259,27 @@ static gboolean _GrLoadContextFromPpm( inputstruct *is, int width,
     }
 
   pRGB = NULL;
-  pColors = malloc( maxwidth * sizeof(GrxColor) );
-  if(pColors == NULL) { res = FALSE; goto out; }
+  dt = _GrDitherNew( 0,maxwidth );
+  if(dt == NULL) { res = FALSE; goto out; }
   pRGB = malloc( width * 3 * sizeof(char) );
   if(pRGB == NULL) { res = FALSE; goto out; }
 
   for( y=0; y<maxheight; y++ ){
     if( inputread( pRGB,3,width,is ) != width ) { res = FALSE; goto out; }
-    pCursor = pRGB;
-    for( x=0; x<maxwidth; x++ ){
-      if( needcoloradjust ){
+    if( needcoloradjust ){
+      pCursor = pRGB;
+      for( x=0; x<maxwidth; x++ ){
         pCursor[0] *= coloradjust;
         pCursor[1] *= coloradjust;
         pCursor[2] *= coloradjust;
+        pCursor += 3;
         }
-      pColors[x] = grx_color_get( pCursor[0],pCursor[1],pCursor[2] );
-      pCursor += 3;
       }
-    grx_put_scanline( 0,maxwidth-1,y,pColors,GRX_COLOR_MODE_WRITE );
+    _GrDitherRow( dt,y,pRGB,3,FALSE );
     }
 
 out:
-  if( pColors != NULL ) free( pColors );
+  _GrDitherFree( dt );
   if( pRGB != NULL ) free( pRGB );
   return res;
 }
@@ -297,7 +298,8 @@ out:
  * the routine loads as much as it can
  *
  * If color mode is not in RGB mode, the routine allocates as
- * many colors as it can
+ * many colors as it can. Contexts with 256 colors or less are dithered
+ * as set by grx_set_image_dither().
  *
  * Returns: %TRUE on success, otherwise %FALSE
  */
@@ -392,7 +394,8 @@ gboolean grx_query_pnm_file(const char *pnmfn, GrxPnmFormat *format, int *width,
  * the routine loads as much as it can
  *
  * If color mode is not in RGB mode, the routine allocates as
- * much colors as it can
+ * much colors as it can. Contexts with 256 colors or less are dithered
+ * as set by grx_set_image_dither().
  *
  * Returns: %TRUE on success, otherwise %FALSE
  */
@@ -18,6 +18,8 @@
 
 #include <glib.h>
 
+#include "libgrx.h"
+
 #if defined(__alpha__) || (GRX_VERSION==GRX_VERSION_GENERIC_X11) && !defined(_AIX)
 #  include <alloca.h>
 #elif defined(_MSC_VER) && defined(_WIN32)
@@ -51,9 +53,9 @@
 #define reset_ALLOC  reset_alloca
 #endif
 
-/* temp buffer for blits etc. */
-G_GNUC_INTERNAL extern void *_GrTempBuffer;
-G_GNUC_INTERNAL extern unsigned  _GrTempBufferBytes;
+/* temp buffer for blits etc., every thread has its own */
+G_GNUC_INTERNAL extern GR_THREAD_LOCAL void *_GrTempBuffer;
+G_GNUC_INTERNAL extern GR_THREAD_LOCAL unsigned  _GrTempBufferBytes;
 #define _GrTempBufferAlloc(b) (                                     \
     ((unsigned)(b) <= _GrTempBufferBytes) ? _GrTempBuffer           \
                                           : _GrTempBufferAlloc_(b) )
@@ -0,0 +1,89 @@
+/*
+ * blend.h ---- coverage blending helpers for the blendspan frame driver routines
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef __BLEND_H_INCLUDED__
+#define __BLEND_H_INCLUDED__
+
+/*
+ * map a coverage value 0..255 to a multiplier 0..256, so that full
+ * coverage reproduces the drawing color exactly after the final shift
+ */
+#define blend_alpha256(a)       ((unsigned int)(a) + ((unsigned int)(a) >> 7))
+
+/*
+ * mix color c over pixel p (both having three 8 bit components in the low
+ * 24 bits) with multiplier a = 0..256. The red and blue components are
+ * processed together, the gaps between them absorb the products.
+ */
+#define blend_888(c,p,a) (                                                  \
+    ((((((GR_int32u)(c)) & 0xff00ffUL) * (a) +                              \
+       (((GR_int32u)(p)) & 0xff00ffUL) * (256 - (a))) >> 8) & 0xff00ffUL) | \
+    ((((((GR_int32u)(c)) & 0x00ff00UL) * (a) +                              \
+       (((GR_int32u)(p)) & 0x00ff00UL) * (256 - (a))) >> 8) & 0x00ff00UL)   \
+)
+
+/*
+ * 16bpp pixels are spread into 32 bits so that every component has five
+ * spare bits above it: the middle component moves to the upper half word.
+ * 'm' is the spread mask built by blend_spread_mask16().
+ */
+#define blend_spread16(p,m)     ((((GR_int32u)(p)) | ((GR_int32u)(p) << 16)) & (m))
+#define blend_pack16(s)         ((GR_int16u)((s) | ((s) >> 16)))
+
+/* mix spread color c over spread pixel p with multiplier a = 0..32 */
+#define blend_spread(c,p,a,m)   ((((c) * (a) + (p) * (32 - (a))) >> 5) & (m))
+
+static INLINE GR_int32u blend_spread_mask16(void)
+{
+    GR_int32u fmask[3];
+    int lo[3], i, mid;
+    for (i = 0; i < 3; i++) {
+        lo[i] = CLRINFO->pos[i] - CLRINFO->prec[i] + 1;
+        fmask[i] = ((1UL << CLRINFO->prec[i]) - 1) << lo[i];
+    }
+    for (mid = 0; mid < 3; mid++) {
+        int below = 0;
+        for (i = 0; i < 3; i++) if (lo[i] < lo[mid]) below++;
+        if (below == 1) break;
+    }
+    for (i = 0; i < 3; i++) fmask[i] <<= (i == mid) ? 16 : 0;
+    return fmask[0] | fmask[1] | fmask[2];
+}
+
+/*
+ * Source-over compositing of premultiplied ARGB pixels (alpha in the upper
+ * 8 bits): d = s + d * (255 - alpha(s)) / 255 for each of the four bytes.
+ * _GrSpanBlend_argb composites n pixels of s onto d, which may be ARGB or
+ * 32bpp with the color in the lower 24 bits. _GrSpanBlend_argb_h is for
+ * destinations with the color in the upper 24 bits. The kernels are picked
+ * for the host CPU on the first call, like the span fills.
+ */
+typedef void (*_GR_spanBlend)(void *d, const void *s, size_t n);
+G_GNUC_INTERNAL extern _GR_spanBlend _GrSpanBlend_argb;
+G_GNUC_INTERNAL extern _GR_spanBlend _GrSpanBlend_argb_h;
+
+/* composite one premultiplied ARGB pixel s over d */
+static INLINE GR_int32u blend_over_argb(GR_int32u s, GR_int32u d)
+{
+    GR_int32u ia = 255 - (s >> 24);
+    GR_int32u rb = (d & 0xff00ffUL) * ia + 0x800080UL;
+    GR_int32u ag = ((d >> 8) & 0xff00ffUL) * ia + 0x800080UL;
+    rb = ((rb + ((rb >> 8) & 0xff00ffUL)) >> 8) & 0xff00ffUL;
+    ag = (ag + ((ag >> 8) & 0xff00ffUL)) & 0xff00ff00UL;
+    return s + (rb | ag);
+}
+
+#endif /* whole file */
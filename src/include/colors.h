@@ -28,6 +28,7 @@
 G_GNUC_INTERNAL extern int _GR_firstFreeColor; /* can't access all colors on all systems */
 G_GNUC_INTERNAL extern int _GR_lastFreeColor;  /* eg. X11 and other windowing systems    */
 G_GNUC_INTERNAL int _GrResetColors(void);      /* like grx_color_info_reset_colors but return true on success */
+G_GNUC_INTERNAL void _GrColorsChanged(void);   /* call after changing the color table directly */
 
 #ifndef C_OPER
 #define C_OPER(color)   (unsigned int)(((GrxColor)(color) >> 24) & 15)
@@ -37,6 +38,7 @@ G_GNUC_INTERNAL int _GrResetColors(void);      /* like grx_color_info_reset_colo
 #define C_OR            (int)(GRX_COLOR_MODE_OR    >> 24)
 #define C_AND           (int)(GRX_COLOR_MODE_AND   >> 24)
 #define C_IMAGE         (int)(GRX_COLOR_MODE_IMAGE >> 24)
+#define C_BLEND         (int)(GRX_COLOR_MODE_BLEND >> 24)
 #define C_COLOR         GRX_COLOR_VALUE_MASK
 
 #endif /* __INCLUDE_COLOR_H__ */
@@ -0,0 +1,49 @@
+/*
+ * damage.h ---- screen damage tracking
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef __INCLUDE_DAMAGE_H__
+#define __INCLUDE_DAMAGE_H__
+
+#include "globals.h"
+#include "libgrx.h"
+#include "grdriver.h"
+
+/*
+ * The areas of the screen that were drawn to since the video driver last
+ * looked. Only tracked when the video mode asks for it (see the 'damaged'
+ * member of GrxVideoModeExt), otherwise drawing only pays for a flag test.
+ */
+G_GNUC_INTERNAL extern struct _GR_damageInfo {
+    gboolean enabled;                           /* video mode wants damage */
+    gboolean notified;                          /* driver was told, not taken yet */
+    gint     count;                             /* number of rects in use */
+    _GR_damageRect rects[GRX_DAMAGE_MAX_RECTS]; /* damaged areas, screen coords */
+} _GrDamageInfo;
+
+#define DMGINFO         (&_GrDamageInfo)
+
+/*
+ * record a box (in the coordinates of context c) that is about to be drawn
+ */
+#define damage_add(c,x1,y1,x2,y2)                                           \
+        if(DMGINFO->enabled && (c)->gc_is_on_screen) {                      \
+        _GrDamageAdd((c),(x1),(y1),(x2),(y2));                              \
+        }
+
+G_GNUC_INTERNAL void _GrDamageAdd(const GrxContext *c,int x1,int y1,int x2,int y2);
+G_GNUC_INTERNAL void _GrDamageInit(GrxVideoMode *md);
+
+#endif /* __INCLUDE_DAMAGE_H__ */
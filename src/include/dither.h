@@ -0,0 +1,35 @@
+/*
+ * dither.h ---- converting image rows to the colors of low depth frames
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef __INCLUDE_DITHER_H__
+#define __INCLUDE_DITHER_H__
+
+#include <glib.h>
+
+/*
+ * The last stage of the image loaders: rows of 8 bit samples are converted
+ * to colors, dithered as set by grx_set_image_dither() if the frame has 256
+ * colors or less, and written to the current context. Rows must be given
+ * from top to bottom.
+ */
+typedef struct _GR_dither _GR_dither;
+
+G_GNUC_INTERNAL _GR_dither *_GrDitherNew(int x, int w);
+G_GNUC_INTERNAL void _GrDitherFree(_GR_dither *d);
+G_GNUC_INTERNAL void _GrDitherRow(_GR_dither *d, int y, const guint8 *pix,
+                                  int channels, int use_alpha);
+
+#endif /* __INCLUDE_DITHER_H__ */
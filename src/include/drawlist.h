@@ -0,0 +1,102 @@
+/*
+ * drawlist.h ---- recorded drawing commands
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef __INCLUDE_DRAWLIST_H__
+#define __INCLUDE_DRAWLIST_H__
+
+#include <glib.h>
+
+#include <grx/draw.h>
+#include <grx/text.h>
+
+#include "libgrx.h"
+
+typedef enum {
+    DRAW_CMD_PIXEL,
+    DRAW_CMD_LINE,
+    DRAW_CMD_BOX,
+    DRAW_CMD_FILLED_BOX,
+    DRAW_CMD_POLYLINE,
+    DRAW_CMD_POLYGON,
+    DRAW_CMD_FILLED_POLYGON,
+    DRAW_CMD_ELLIPSE,
+    DRAW_CMD_FILLED_ELLIPSE,
+    DRAW_CMD_TEXT,
+    DRAW_CMD_BIT_BLT,
+    DRAW_CMD_PIXELS,
+    DRAW_CMD_LINES,
+    DRAW_CMD_FILLED_BOXES,
+} _GR_drawCmdType;
+
+/* no per item colors, every item of a bulk command is drawn with its color */
+#define DRAW_CMD_ONE_COLOR  G_MAXUINT
+
+/*
+ * One recorded call. x1,y1,x2,y2 are the coordinates of pixels, lines and
+ * boxes; ellipses keep the center in x1,y1 and the radii in x2,y2. Points
+ * and strings live in the arrays of the list, referenced by first/count,
+ * so that recording does not allocate for every command.
+ *
+ * A blit keeps its destination in x1,y1 and the source box in two points.
+ * The bulk commands (PIXELS, LINES, FILLED_BOXES) draw count items of one,
+ * two and two points, with the colors from index colors of the color array.
+ */
+typedef struct {
+    _GR_drawCmdType type;
+    GrxColor color;
+    gint     x1, y1, x2, y2;
+    guint    first, count;          /* points, text bytes or bulk items */
+    guint    colors;                /* bulk item colors or DRAW_CMD_ONE_COLOR */
+    GrxTextOptions *options;        /* text only, a reference is held */
+    GrxContext *src;                /* blit only, a reference is held */
+} _GR_drawCmd;
+
+typedef struct {
+    GArray  *cmds;                  /* _GR_drawCmd */
+    GArray  *points;                /* GrxPoint of all point commands */
+    GArray  *colors;                /* GrxColor of bulk command items */
+    GString *text;                  /* NUL terminated strings of all texts */
+} _GR_drawList;
+
+#define draw_list_cmd(l,i)      (&g_array_index((l)->cmds, _GR_drawCmd, (i)))
+#define draw_list_len(l)        ((l)->cmds->len)
+
+G_GNUC_INTERNAL void _GrDrawListInit(_GR_drawList *l);
+G_GNUC_INTERNAL void _GrDrawListClear(_GR_drawList *l);
+G_GNUC_INTERNAL void _GrDrawListFree(_GR_drawList *l);
+
+G_GNUC_INTERNAL _GR_drawCmd *_GrDrawListAdd(_GR_drawList *l, _GR_drawCmdType type,
+                                            gint x1, gint y1, gint x2, gint y2,
+                                            GrxColor c);
+G_GNUC_INTERNAL _GR_drawCmd *_GrDrawListAddPoints(_GR_drawList *l, _GR_drawCmdType type,
+                                                  gint n, const GrxPoint *points,
+                                                  GrxColor c);
+G_GNUC_INTERNAL _GR_drawCmd *_GrDrawListAddBulk(_GR_drawList *l, _GR_drawCmdType type,
+                                                gint n, const GrxPoint *points,
+                                                const GrxColor *colors, GrxColor c);
+G_GNUC_INTERNAL _GR_drawCmd *_GrDrawListAddBitBlt(_GR_drawList *l, gint x, gint y,
+                                                  GrxContext *src, gint x1, gint y1,
+                                                  gint x2, gint y2, GrxColor op);
+G_GNUC_INTERNAL _GR_drawCmd *_GrDrawListAddText(_GR_drawList *l, const gchar *text,
+                                                gint x, gint y,
+                                                GrxTextOptions *options);
+
+G_GNUC_INTERNAL void _GrDrawCmdBounds(const _GR_drawList *l, const _GR_drawCmd *cmd,
+                                      gint *x1, gint *y1, gint *x2, gint *y2);
+G_GNUC_INTERNAL gboolean _GrDrawCmdClipExact(const _GR_drawList *l, const _GR_drawCmd *cmd);
+G_GNUC_INTERNAL void _GrDrawCmdRun(const _GR_drawList *l, const _GR_drawCmd *cmd);
+
+#endif /* __INCLUDE_DRAWLIST_H__ */
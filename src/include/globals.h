@@ -21,9 +21,12 @@
 #include <glib.h>
 
 #include <grx/context.h>
+#include <grx/frame_mode.h>
 #include <grx/mouse.h>
 #include <grx/mode.h>
 
+#include "libgrx.h"
+
 /*
  * global library data structures
  */
@@ -42,10 +45,52 @@ extern  struct _GR_mouseInfo   _GrMouseInfo;
 #define CLRINFO         (&_GrColorInfo)
 #define MOUINFO         (&_GrMouseInfo)
 
-#define CURC            (&(CXTINFO->current))
+/*
+ * The context and frame driver that the drawing functions work on. For every
+ * thread these start out pointing at CXTINFO->current and DRVINFO->fdriver;
+ * the grx_context_*() drawing functions point them at a private copy of
+ * their context while they draw, so threads drawing to different contexts
+ * don't get in each other's way.
+ */
+G_GNUC_INTERNAL extern GR_THREAD_LOCAL GrxContext     *_GrCurrentContext;
+G_GNUC_INTERNAL extern GR_THREAD_LOCAL GrxFrameDriver *_GrCurrentFrameDriver;
+
+#define CURC            (_GrCurrentContext)
 #define SCRN            (&(CXTINFO->screen))
-#define FDRV            (&(DRVINFO->fdriver))
+#define FDRV            (_GrCurrentFrameDriver)
 #define SDRV            (&(DRVINFO->sdriver))
 #define VDRV            ( (DRVINFO->vdriver))
 
+/* library code sees the current context of its own thread */
+#undef  grx_get_current_context
+#define grx_get_current_context()       (CURC)
+#undef  grx_get_current_frame_driver
+#define grx_get_current_frame_driver()  ((const GrxFrameDriver *)(FDRV))
+#undef  grx_frame_mode_get_current
+#define grx_frame_mode_get_current()    (FDRV->mode)
+
+/*
+ * context_bind() makes a copy of a context current for the calling thread
+ * only, context_unbind() goes back to the previous one. They can be nested.
+ */
+typedef struct {
+    GrxContext      context;
+    GrxFrameDriver  fdriver;
+    GrxContext     *save_context;
+    GrxFrameDriver *save_fdriver;
+} _GR_contextBinding;
+
+#define context_bind(b,c) do {                                              \
+        (b)->save_context = CURC;                                           \
+        (b)->save_fdriver = FDRV;                                           \
+        (b)->context = *(c);                                                \
+        (b)->fdriver = *(c)->gc_driver;                                     \
+        CURC = &(b)->context;                                               \
+        FDRV = &(b)->fdriver;                                               \
+} while(0)
+#define context_unbind(b) do {                                              \
+        CURC = (b)->save_context;                                           \
+        FDRV = (b)->save_fdriver;                                           \
+} while(0)
+
 #endif /* __INCLUDE_GLOBALS_H__ */
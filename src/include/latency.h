@@ -0,0 +1,31 @@
+/*
+ * latency.h ---- input latency measurements
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef __INCLUDE_LATENCY_H__
+#define __INCLUDE_LATENCY_H__
+
+#include <glib.h>
+
+/* nothing is measured unless the application asks for it */
+G_GNUC_INTERNAL extern gboolean _GrLatencyEnabled;
+
+/*
+ * record an event taken from the queue: when it was put, when it happened
+ * (0 for events that are not input) and the current time
+ */
+G_GNUC_INTERNAL void _GrLatencyDequeued(gint64 queued, gint64 time, gint64 now);
+
+#endif /* __INCLUDE_LATENCY_H__ */
@@ -140,4 +140,13 @@ typedef unsigned GR_int64 GR_int64u;
 #define INLINE
 #endif
 
+/*
+ * thread local storage, for the per-thread drawing state
+ */
+#ifdef __GNUC__
+#define GR_THREAD_LOCAL __thread __attribute__((tls_model("initial-exec")))
+#else
+#define GR_THREAD_LOCAL _Thread_local
+#endif
+
 #endif  /* whole file */
@@ -20,6 +20,8 @@
 #ifndef __MEMCOPY_H_INCLUDED__
 #define __MEMCOPY_H_INCLUDED__
 
+#include <glib.h>
+
 #ifndef __MEMMODE_H_INCLUDED__
 #include "memmode.h"
 #endif
@@ -57,6 +59,29 @@
 #define NO_16BIT_COPY
 #endif
 
+/*
+ * Long fwdcopy/revcopy rows are handed to kernels picked at run time for
+ * the host CPU: AVX2 or SSE2 on x86-64, NEON on ARM. _GrSpanCopy_* copy
+ * 'bytes' bytes from 's' to 'd' starting at the lowest address,
+ * _GrSpanRevCopy_* start at the highest one, so that overlapping rows are
+ * copied correctly in both directions. Define NO_SIMD_COPY to always use
+ * the inline copies.
+ */
+#if defined(GR_int64) && !defined(NO_64BIT_COPY) && !defined(NO_SIMD_COPY) && \
+    (defined(__x86_64__) || defined(__aarch64__) || defined(__ARM_NEON))
+#define SIMD_COPY
+#define SIMD_COPY_MIN   64      /* bytes */
+typedef void (*_GR_spanCopy)(void *d, const void *s, size_t bytes);
+G_GNUC_INTERNAL extern _GR_spanCopy _GrSpanCopy_set;
+G_GNUC_INTERNAL extern _GR_spanCopy _GrSpanCopy_xor;
+G_GNUC_INTERNAL extern _GR_spanCopy _GrSpanCopy_or;
+G_GNUC_INTERNAL extern _GR_spanCopy _GrSpanCopy_and;
+G_GNUC_INTERNAL extern _GR_spanCopy _GrSpanRevCopy_set;
+G_GNUC_INTERNAL extern _GR_spanCopy _GrSpanRevCopy_xor;
+G_GNUC_INTERNAL extern _GR_spanCopy _GrSpanRevCopy_or;
+G_GNUC_INTERNAL extern _GR_spanCopy _GrSpanRevCopy_and;
+#endif
+
 /* Note:
 **   These functions alter the destination and source pointers and the
 **   counter. Destination and source pointer _must_ point to next copy
@@ -1261,30 +1286,54 @@ while (0)
 #define __INLINE_REV_COPY__(WOP,SF,AP,D,S,C) colcopy_b##WOP##SF(D,-1,S,-1,C)
 #endif
 
+#ifdef SIMD_COPY
+#define __INLINE_FWDCOPY__(WOP,SF,OP,AP,D,S,C) do {                            \
+   if ((GR_PtrInt)(C) >= SIMD_COPY_MIN) {                                     \
+      (*_GrSpanCopy##OP)((void *)(D),(const void *)(S),(size_t)(C));          \
+      ptrinc((D),(C));                                                        \
+      ptrinc((S),(C));                                                        \
+   }                                                                          \
+   else __INLINE_FWD_COPY__(WOP,SF,AP,D,S,C);                                 \
+} while (0)
+#define __INLINE_REVCOPY__(WOP,SF,OP,AP,D,S,C) do {                            \
+   if ((GR_PtrInt)(C) >= SIMD_COPY_MIN) {                                     \
+      ptrinc((D),1-(GR_PtrInt)(C));                                           \
+      ptrinc((S),1-(GR_PtrInt)(C));                                           \
+      (*_GrSpanRevCopy##OP)((void *)(D),(const void *)(S),(size_t)(C));       \
+      ptrinc((D),-1);                                                         \
+      ptrinc((S),-1);                                                         \
+   }                                                                          \
+   else __INLINE_REV_COPY__(WOP,SF,AP,D,S,C);                                 \
+} while (0)
+#else
+#define __INLINE_FWDCOPY__(WOP,SF,OP,AP,D,S,C) __INLINE_FWD_COPY__(WOP,SF,AP,D,S,C)
+#define __INLINE_REVCOPY__(WOP,SF,OP,AP,D,S,C) __INLINE_REV_COPY__(WOP,SF,AP,D,S,C)
+#endif
+
 /* memory -> memory copy */
 #ifndef fwdcopy_set
-#define fwdcopy_set(ap,d,s,c)      __INLINE_FWD_COPY__(_n_set,_n,ap,d,s,c)
+#define fwdcopy_set(ap,d,s,c)      __INLINE_FWDCOPY__(_n_set,_n,_set,ap,d,s,c)
 #endif
 #ifndef fwdcopy_xor
-#define fwdcopy_xor(ap,d,s,c)      __INLINE_FWD_COPY__(_n_xor,_n,ap,d,s,c)
+#define fwdcopy_xor(ap,d,s,c)      __INLINE_FWDCOPY__(_n_xor,_n,_xor,ap,d,s,c)
 #endif
 #ifndef fwdcopy_or
-#define fwdcopy_or(ap,d,s,c)       __INLINE_FWD_COPY__(_n_or,_n,ap,d,s,c)
+#define fwdcopy_or(ap,d,s,c)       __INLINE_FWDCOPY__(_n_or,_n,_or,ap,d,s,c)
 #endif
 #ifndef fwdcopy_and
-#define fwdcopy_and(ap,d,s,c)      __INLINE_FWD_COPY__(_n_and,_n,ap,d,s,c)
+#define fwdcopy_and(ap,d,s,c)      __INLINE_FWDCOPY__(_n_and,_n,_and,ap,d,s,c)
 #endif
 #ifndef revcopy_set
-#define revcopy_set(ap,d,s,c)      __INLINE_REV_COPY__(_n_set,_n,ap,d,s,c)
+#define revcopy_set(ap,d,s,c)      __INLINE_REVCOPY__(_n_set,_n,_set,ap,d,s,c)
 #endif
 #ifndef revcopy_xor
-#define revcopy_xor(ap,d,s,c)      __INLINE_REV_COPY__(_n_xor,_n,ap,d,s,c)
+#define revcopy_xor(ap,d,s,c)      __INLINE_REVCOPY__(_n_xor,_n,_xor,ap,d,s,c)
 #endif
 #ifndef revcopy_or
-#define revcopy_or(ap,d,s,c)       __INLINE_REV_COPY__(_n_or,_n,ap,d,s,c)
+#define revcopy_or(ap,d,s,c)       __INLINE_REVCOPY__(_n_or,_n,_or,ap,d,s,c)
 #endif
 #ifndef revcopy_and
-#define revcopy_and(ap,d,s,c)      __INLINE_REV_COPY__(_n_and,_n,ap,d,s,c)
+#define revcopy_and(ap,d,s,c)      __INLINE_REVCOPY__(_n_and,_n,_and,ap,d,s,c)
 #endif
 
 #define fwdcopy_n_set_n  fwdcopy_set
@@ -1299,28 +1348,28 @@ while (0)
 
 /* memory -> video copy */
 #ifndef fwdcopy_f_set
-#define fwdcopy_f_set(ap,d,s,c)    __INLINE_FWD_COPY__(_f_set,_n,ap,d,s,c)
+#define fwdcopy_f_set(ap,d,s,c)    __INLINE_FWDCOPY__(_f_set,_n,_set,ap,d,s,c)
 #endif
 #ifndef fwdcopy_f_xor
-#define fwdcopy_f_xor(ap,d,s,c)    __INLINE_FWD_COPY__(_f_xor,_n,ap,d,s,c)
+#define fwdcopy_f_xor(ap,d,s,c)    __INLINE_FWDCOPY__(_f_xor,_n,_xor,ap,d,s,c)
 #endif
 #ifndef fwdcopy_f_or
-#define fwdcopy_f_or(ap,d,s,c)     __INLINE_FWD_COPY__(_f_or,_n,ap,d,s,c)
+#define fwdcopy_f_or(ap,d,s,c)     __INLINE_FWDCOPY__(_f_or,_n,_or,ap,d,s,c)
 #endif
 #ifndef fwdcopy_f_and
-#define fwdcopy_f_and(ap,d,s,c)    __INLINE_FWD_COPY__(_f_and,_n,ap,d,s,c)
+#define fwdcopy_f_and(ap,d,s,c)    __INLINE_FWDCOPY__(_f_and,_n,_and,ap,d,s,c)
 #endif
 #ifndef revcopy_f_set
-#define revcopy_f_set(ap,d,s,c)    __INLINE_REV_COPY__(_f_set,_n,ap,d,s,c)
+#define revcopy_f_set(ap,d,s,c)    __INLINE_REVCOPY__(_f_set,_n,_set,ap,d,s,c)
 #endif
 #ifndef revcopy_f_xor
-#define revcopy_f_xor(ap,d,s,c)    __INLINE_REV_COPY__(_f_xor,_n,ap,d,s,c)
+#define revcopy_f_xor(ap,d,s,c)    __INLINE_REVCOPY__(_f_xor,_n,_xor,ap,d,s,c)
 #endif
 #ifndef revcopy_f_or
-#define revcopy_f_or(ap,d,s,c)     __INLINE_REV_COPY__(_f_or,_n,ap,d,s,c)
+#define revcopy_f_or(ap,d,s,c)     __INLINE_REVCOPY__(_f_or,_n,_or,ap,d,s,c)
 #endif
 #ifndef revcopy_f_and
-#define revcopy_f_and(ap,d,s,c)    __INLINE_REV_COPY__(_f_and,_n,ap,d,s,c)
+#define revcopy_f_and(ap,d,s,c)    __INLINE_REVCOPY__(_f_and,_n,_and,ap,d,s,c)
 #endif
 
 #define fwdcopy_f_set_n  fwdcopy_f_set
@@ -1335,28 +1384,28 @@ while (0)
 
 /* video -> memory copy */
 #ifndef fwdcopy_set_f
-#define fwdcopy_set_f(ap,d,s,c)    __INLINE_FWD_COPY__(_n_set,_f,ap,d,s,c)
+#define fwdcopy_set_f(ap,d,s,c)    __INLINE_FWDCOPY__(_n_set,_f,_set,ap,d,s,c)
 #endif
 #ifndef fwdcopy_xor_f
-#define fwdcopy_xor_f(ap,d,s,c)    __INLINE_FWD_COPY__(_n_xor,_f,ap,d,s,c)
+#define fwdcopy_xor_f(ap,d,s,c)    __INLINE_FWDCOPY__(_n_xor,_f,_xor,ap,d,s,c)
 #endif
 #ifndef fwdcopy_or_f
-#define fwdcopy_or_f(ap,d,s,c)     __INLINE_FWD_COPY__(_n_or,_f,ap,d,s,c)
+#define fwdcopy_or_f(ap,d,s,c)     __INLINE_FWDCOPY__(_n_or,_f,_or,ap,d,s,c)
 #endif
 #ifndef fwdcopy_and_f
-#define fwdcopy_and_f(ap,d,s,c)    __INLINE_FWD_COPY__(_n_and,_f,ap,d,s,c)
+#define fwdcopy_and_f(ap,d,s,c)    __INLINE_FWDCOPY__(_n_and,_f,_and,ap,d,s,c)
 #endif
 #ifndef revcopy_set_f
-#define revcopy_set_f(ap,d,s,c)    __INLINE_REV_COPY__(_n_set,_f,ap,d,s,c)
+#define revcopy_set_f(ap,d,s,c)    __INLINE_REVCOPY__(_n_set,_f,_set,ap,d,s,c)
 #endif
 #ifndef revcopy_xor_f
-#define revcopy_xor_f(ap,d,s,c)    __INLINE_REV_COPY__(_n_xor,_f,ap,d,s,c)
+#define revcopy_xor_f(ap,d,s,c)    __INLINE_REVCOPY__(_n_xor,_f,_xor,ap,d,s,c)
 #endif
 #ifndef revcopy_or_f
-#define revcopy_or_f(ap,d,s,c)     __INLINE_REV_COPY__(_n_or,_f,ap,d,s,c)
+#define revcopy_or_f(ap,d,s,c)     __INLINE_REVCOPY__(_n_or,_f,_or,ap,d,s,c)
 #endif
 #ifndef revcopy_and_f
-#define revcopy_and_f(ap,d,s,c)    __INLINE_REV_COPY__(_n_and,_f,ap,d,s,c)
+#define revcopy_and_f(ap,d,s,c)    __INLINE_REVCOPY__(_n_and,_f,_and,ap,d,s,c)
 #endif
 
 #define fwdcopy_n_set_f  fwdcopy_set_f
@@ -1371,28 +1420,28 @@ while (0)
 
 /* video -> video copy */
 #ifndef fwdcopy_f_set_f
-#define fwdcopy_f_set_f(ap,d,s,c)  __INLINE_FWD_COPY__(_f_set,_f,ap,d,s,c)
+#define fwdcopy_f_set_f(ap,d,s,c)  __INLINE_FWDCOPY__(_f_set,_f,_set,ap,d,s,c)
 #endif
 #ifndef fwdcopy_f_xor_f
-#define fwdcopy_f_xor_f(ap,d,s,c)  __INLINE_FWD_COPY__(_f_xor,_f,ap,d,s,c)
+#define fwdcopy_f_xor_f(ap,d,s,c)  __INLINE_FWDCOPY__(_f_xor,_f,_xor,ap,d,s,c)
 #endif
 #ifndef fwdcopy_f_or_f
-#define fwdcopy_f_or_f(ap,d,s,c)   __INLINE_FWD_COPY__(_f_or,_f,ap,d,s,c)
+#define fwdcopy_f_or_f(ap,d,s,c)   __INLINE_FWDCOPY__(_f_or,_f,_or,ap,d,s,c)
 #endif
 #ifndef fwdcopy_f_and_f
-#define fwdcopy_f_and_f(ap,d,s,c)  __INLINE_FWD_COPY__(_f_and,_f,ap,d,s,c)
+#define fwdcopy_f_and_f(ap,d,s,c)  __INLINE_FWDCOPY__(_f_and,_f,_and,ap,d,s,c)
 #endif
 #ifndef revcopy_f_set_f
-#define revcopy_f_set_f(ap,d,s,c)  __INLINE_REV_COPY__(_f_set,_f,ap,d,s,c)
+#define revcopy_f_set_f(ap,d,s,c)  __INLINE_REVCOPY__(_f_set,_f,_set,ap,d,s,c)
 #endif
 #ifndef revcopy_f_xor_f
-#define revcopy_f_xor_f(ap,d,s,c)  __INLINE_REV_COPY__(_f_xor,_f,ap,d,s,c)
+#define revcopy_f_xor_f(ap,d,s,c)  __INLINE_REVCOPY__(_f_xor,_f,_xor,ap,d,s,c)
 #endif
 #ifndef revcopy_f_or_f
-#define revcopy_f_or_f(ap,d,s,c)   __INLINE_REV_COPY__(_f_or,_f,ap,d,s,c)
+#define revcopy_f_or_f(ap,d,s,c)   __INLINE_REVCOPY__(_f_or,_f,_or,ap,d,s,c)
 #endif
 #ifndef revcopy_f_and_f
-#define revcopy_f_and_f(ap,d,s,c)  __INLINE_REV_COPY__(_f_and,_f,ap,d,s,c)
+#define revcopy_f_and_f(ap,d,s,c)  __INLINE_REVCOPY__(_f_and,_f,_and,ap,d,s,c)
 #endif
 
 /*
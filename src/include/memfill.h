@@ -21,6 +21,8 @@
 #ifndef __MEMFILL_H_INCLUDED__
 #define __MEMFILL_H_INCLUDED__
 
+#include <glib.h>
+
 #ifndef __MEMMODE_H_INCLUDED__
 #include "memmode.h"
 #endif
@@ -45,6 +47,27 @@
 #define NO_16BIT_FILL
 #endif
 
+/*
+ * Long row fills are handed to kernels picked at run time for the host
+ * CPU: AVX2 or SSE2 on x86-64, NEON on ARM. They fill 'bytes' bytes at 'p'
+ * with the replicated 64 bit value 'v'. Shorter rows use the inline fills
+ * below. Define NO_SIMD_FILL to always use the inline fills.
+ */
+#if defined(GR_int64) && !defined(NO_64BIT_FILL) && !defined(NO_SIMD_FILL) && \
+    (defined(__x86_64__) || defined(__aarch64__) || defined(__ARM_NEON))
+#define SIMD_FILL
+#define SIMD_FILL_MIN   64      /* bytes */
+typedef void (*_GR_spanFill)(void *p, GR_int64u v, size_t bytes);
+G_GNUC_INTERNAL extern _GR_spanFill _GrSpanFill_n;
+G_GNUC_INTERNAL extern _GR_spanFill _GrSpanFill_xor;
+G_GNUC_INTERNAL extern _GR_spanFill _GrSpanFill_or;
+G_GNUC_INTERNAL extern _GR_spanFill _GrSpanFill_and;
+#define _GrSpanFill_f       _GrSpanFill_n
+#define _GrSpanFill_f_xor   _GrSpanFill_xor
+#define _GrSpanFill_f_or    _GrSpanFill_or
+#define _GrSpanFill_f_and   _GrSpanFill_and
+#endif
+
 #if !defined(CPSIZE_b) && defined(GR_int8)
 #define CPSIZE_b     sizeof(GR_int8)
 #endif
@@ -538,111 +561,125 @@
 } while(0)
 #endif /* !__INLINE_H_REPFILL__ */
 
+#ifdef SIMD_FILL
+#define __INLINE_REPFILL__(P,V,C,FMODE,SZ,KIND) do {                          \
+    if ((unsigned GR_PtrInt)(C) >= SIMD_FILL_MIN / CPSIZE_##SZ) {             \
+        GR_PtrInt _sb_ = (GR_PtrInt)(C) * CPSIZE_##SZ;                        \
+        (*_GrSpanFill##FMODE)((void *)(P),(GR_int64u)(V),(size_t)_sb_);       \
+        ptrinc((P),_sb_);                                                     \
+    }                                                                         \
+    else __INLINE_##KIND##_REPFILL__(P,V,C,FMODE);                            \
+} while (0)
+#else
+#define __INLINE_REPFILL__(P,V,C,FMODE,SZ,KIND)                               \
+        __INLINE_##KIND##_REPFILL__(P,V,C,FMODE)
+#endif
+
 /*
  * repfill_<SIZE>[_<FAR>][_<OPER>](pointer,value,count)
  */
 #ifndef repfill_b
-#define repfill_b(p,v,c)        __INLINE_B_REPFILL__(p,v,c,_n)
+#define repfill_b(p,v,c)        __INLINE_REPFILL__(p,v,c,_n,b,B)
 #endif
 #if defined(__INLINE_W_REPFILL__) && !defined(repfill_w)
-#define repfill_w(p,v,c)        __INLINE_W_REPFILL__(p,v,c,_n)
+#define repfill_w(p,v,c)        __INLINE_REPFILL__(p,v,c,_n,w,W)
 #endif
 #if defined(__INLINE_L_REPFILL__) && !defined(repfill_l)
-#define repfill_l(p,v,c)        __INLINE_L_REPFILL__(p,v,c,_n)
+#define repfill_l(p,v,c)        __INLINE_REPFILL__(p,v,c,_n,l,L)
 #endif
 #if defined(__INLINE_H_REPFILL__) && !defined(repfill_h)
-#define repfill_h(p,v,c)        __INLINE_H_REPFILL__(p,v,c,_n)
+#define repfill_h(p,v,c)        __INLINE_REPFILL__(p,v,c,_n,h,H)
 #endif
 
 #ifndef repfill_b_xor
-#define repfill_b_xor(p,v,c)    __INLINE_B_REPFILL__(p,v,c,_xor)
+#define repfill_b_xor(p,v,c)    __INLINE_REPFILL__(p,v,c,_xor,b,B)
 #endif
 #if defined(__INLINE_W_REPFILL__) && !defined(repfill_w_xor)
-#define repfill_w_xor(p,v,c)    __INLINE_W_REPFILL__(p,v,c,_xor)
+#define repfill_w_xor(p,v,c)    __INLINE_REPFILL__(p,v,c,_xor,w,W)
 #endif
 #if defined(__INLINE_L_REPFILL__) && !defined(repfill_l_xor)
-#define repfill_l_xor(p,v,c)    __INLINE_L_REPFILL__(p,v,c,_xor)
+#define repfill_l_xor(p,v,c)    __INLINE_REPFILL__(p,v,c,_xor,l,L)
 #endif
 #if defined(__INLINE_H_REPFILL__) && !defined(repfill_h_xor)
-#define repfill_h_xor(p,v,c)    __INLINE_H_REPFILL__(p,v,c,_xor)
+#define repfill_h_xor(p,v,c)    __INLINE_REPFILL__(p,v,c,_xor,h,H)
 #endif
 
 #ifndef repfill_b_or
-#define repfill_b_or(p,v,c)     __INLINE_B_REPFILL__(p,v,c,_or)
+#define repfill_b_or(p,v,c)     __INLINE_REPFILL__(p,v,c,_or,b,B)
 #endif
 #if defined(__INLINE_W_REPFILL__) && !defined(repfill_w_or)
-#define repfill_w_or(p,v,c)     __INLINE_W_REPFILL__(p,v,c,_or)
+#define repfill_w_or(p,v,c)     __INLINE_REPFILL__(p,v,c,_or,w,W)
 #endif
 #if defined(__INLINE_L_REPFILL__) && !defined(repfill_l_or)
-#define repfill_l_or(p,v,c)     __INLINE_L_REPFILL__(p,v,c,_or)
+#define repfill_l_or(p,v,c)     __INLINE_REPFILL__(p,v,c,_or,l,L)
 #endif
 #if defined(__INLINE_H_REPFILL__) && !defined(repfill_h_or)
-#define repfill_h_or(p,v,c)     __INLINE_H_REPFILL__(p,v,c,_or)
+#define repfill_h_or(p,v,c)     __INLINE_REPFILL__(p,v,c,_or,h,H)
 #endif
 
 #ifndef repfill_b_and
-#define repfill_b_and(p,v,c)    __INLINE_B_REPFILL__(p,v,c,_and)
+#define repfill_b_and(p,v,c)    __INLINE_REPFILL__(p,v,c,_and,b,B)
 #endif
 #if defined(__INLINE_W_REPFILL__) && !defined(repfill_w_and)
-#define repfill_w_and(p,v,c)    __INLINE_W_REPFILL__(p,v,c,_and)
+#define repfill_w_and(p,v,c)    __INLINE_REPFILL__(p,v,c,_and,w,W)
 #endif
 #if defined(__INLINE_L_REPFILL__) && !defined(repfill_l_and)
-#define repfill_l_and(p,v,c)    __INLINE_L_REPFILL__(p,v,c,_and)
+#define repfill_l_and(p,v,c)    __INLINE_REPFILL__(p,v,c,_and,l,L)
 #endif
 #if defined(__INLINE_H_REPFILL__) && !defined(repfill_h_and)
-#define repfill_h_and(p,v,c)    __INLINE_H_REPFILL__(p,v,c,_and)
+#define repfill_h_and(p,v,c)    __INLINE_REPFILL__(p,v,c,_and,h,H)
 #endif
 
 #ifndef repfill_b_f
-#define repfill_b_f(p,v,c)      __INLINE_B_REPFILL__(p,v,c,_f)
+#define repfill_b_f(p,v,c)      __INLINE_REPFILL__(p,v,c,_f,b,B)
 #endif
 #if defined(__INLINE_W_REPFILL__) && !defined(repfill_w_f)
-#define repfill_w_f(p,v,c)      __INLINE_W_REPFILL__(p,v,c,_f)
+#define repfill_w_f(p,v,c)      __INLINE_REPFILL__(p,v,c,_f,w,W)
 #endif
 #if defined(__INLINE_L_REPFILL__) && !defined(repfill_l_f)
-#define repfill_l_f(p,v,c)      __INLINE_L_REPFILL__(p,v,c,_f)
+#define repfill_l_f(p,v,c)      __INLINE_REPFILL__(p,v,c,_f,l,L)
 #endif
 #if defined(__INLINE_H_REPFILL__) && !defined(repfill_h_f)
-#define repfill_h_f(p,v,c)      __INLINE_H_REPFILL__(p,v,c,_f)
+#define repfill_h_f(p,v,c)      __INLINE_REPFILL__(p,v,c,_f,h,H)
 #endif
 
 #ifndef repfill_b_f_xor
-#define repfill_b_f_xor(p,v,c)  __INLINE_B_REPFILL__(p,v,c,_f_xor)
+#define repfill_b_f_xor(p,v,c)  __INLINE_REPFILL__(p,v,c,_f_xor,b,B)
 #endif
 #if defined(__INLINE_W_REPFILL__) && !defined(repfill_w_f_xor)
-#define repfill_w_f_xor(p,v,c)  __INLINE_W_REPFILL__(p,v,c,_f_xor)
+#define repfill_w_f_xor(p,v,c)  __INLINE_REPFILL__(p,v,c,_f_xor,w,W)
 #endif
 #if defined(__INLINE_L_REPFILL__) && !defined(repfill_l_f_xor)
-#define repfill_l_f_xor(p,v,c)  __INLINE_L_REPFILL__(p,v,c,_f_xor)
+#define repfill_l_f_xor(p,v,c)  __INLINE_REPFILL__(p,v,c,_f_xor,l,L)
 #endif
 #if defined(__INLINE_H_REPFILL__) && !defined(repfill_h_f_xor)
-#define repfill_h_f_xor(p,v,c)  __INLINE_H_REPFILL__(p,v,c,_f_xor)
+#define repfill_h_f_xor(p,v,c)  __INLINE_REPFILL__(p,v,c,_f_xor,h,H)
 #endif
 
 #ifndef repfill_b_f_or
-#define repfill_b_f_or(p,v,c)   __INLINE_B_REPFILL__(p,v,c,_f_or)
+#define repfill_b_f_or(p,v,c)   __INLINE_REPFILL__(p,v,c,_f_or,b,B)
 #endif
 #if defined(__INLINE_W_REPFILL__) && !defined(repfill_w_f_or)
-#define repfill_w_f_or(p,v,c)   __INLINE_W_REPFILL__(p,v,c,_f_or)
+#define repfill_w_f_or(p,v,c)   __INLINE_REPFILL__(p,v,c,_f_or,w,W)
 #endif
 #if defined(__INLINE_L_REPFILL__) && !defined(repfill_l_f_or)
-#define repfill_l_f_or(p,v,c)   __INLINE_L_REPFILL__(p,v,c,_f_or)
+#define repfill_l_f_or(p,v,c)   __INLINE_REPFILL__(p,v,c,_f_or,l,L)
 #endif
 #if defined(__INLINE_H_REPFILL__) && !defined(repfill_h_f_or)
-#define repfill_h_f_or(p,v,c)   __INLINE_H_REPFILL__(p,v,c,_f_or)
+#define repfill_h_f_or(p,v,c)   __INLINE_REPFILL__(p,v,c,_f_or,h,H)
 #endif
 
 #ifndef repfill_b_f_and
-#define repfill_b_f_and(p,v,c)  __INLINE_B_REPFILL__(p,v,c,_f_and)
+#define repfill_b_f_and(p,v,c)  __INLINE_REPFILL__(p,v,c,_f_and,b,B)
 #endif
 #if defined(__INLINE_W_REPFILL__) && !defined(repfill_w_f_and)
-#define repfill_w_f_and(p,v,c)  __INLINE_W_REPFILL__(p,v,c,_f_and)
+#define repfill_w_f_and(p,v,c)  __INLINE_REPFILL__(p,v,c,_f_and,w,W)
 #endif
 #if defined(__INLINE_L_REPFILL__) && !defined(repfill_l_f_and)
-#define repfill_l_f_and(p,v,c)  __INLINE_L_REPFILL__(p,v,c,_f_and)
+#define repfill_l_f_and(p,v,c)  __INLINE_REPFILL__(p,v,c,_f_and,l,L)
 #endif
 #if defined(__INLINE_H_REPFILL__) && !defined(repfill_h_f_and)
-#define repfill_h_f_and(p,v,c)  __INLINE_H_REPFILL__(p,v,c,_f_and)
+#define repfill_h_f_and(p,v,c)  __INLINE_REPFILL__(p,v,c,_f_and,h,H)
 #endif
 
 #define repfill_b_n      repfill_b
@@ -19,6 +19,7 @@
 #define __INCLUDE_MOUSE_H__
 
 #include "globals.h"
+#include "damage.h"
 
 struct _GrxCursor {
     /* <private> */
@@ -34,11 +35,21 @@ struct _GrxCursor {
 
 /*
  * mouse stuff
+ *
+ * mouse_block() and mouse_addblock() announce a box that is about to be drawn
+ * to: the cursor is erased if it is in the way and the box is recorded as
+ * screen damage. Use mouse_block_read() for boxes that are only read.
  */
 #define mouse_block(c,x1,y1,x2,y2) {                                        \
         int __mouse_block_flag = 0;                                         \
         mouse_addblock(c,x1,y1,x2,y2);
+#define mouse_block_read(c,x1,y1,x2,y2) {                                   \
+        int __mouse_block_flag = 0;                                         \
+        mouse_checkblock(c,x1,y1,x2,y2);
 #define mouse_addblock(c,x1,y1,x2,y2)                                       \
+        damage_add(c,x1,y1,x2,y2)                                           \
+        mouse_checkblock(c,x1,y1,x2,y2)
+#define mouse_checkblock(c,x1,y1,x2,y2)                                     \
         if(MOUINFO->docheck && (c)->gc_is_on_screen) {                          \
         __mouse_block_flag |= (*MOUINFO->block)((c),(x1),(y1),(x2),(y2));   \
         }
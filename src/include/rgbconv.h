@@ -0,0 +1,61 @@
+/*
+ * rgbconv.h ---- converting rows of 8 bit RGB samples to frame colors
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#ifndef __INCLUDE_RGBCONV_H__
+#define __INCLUDE_RGBCONV_H__
+
+#include <glib.h>
+
+#include <grx/color.h>
+
+#include "libgrx.h"
+
+#define RGBCONV_CACHE_SIZE  4096    /* color table lookups remembered */
+
+/*
+ * The image loaders convert a lot of pixels with the same color layout, so
+ * the work of grx_color_get() is done up front: RGB and grayscale modes add
+ * up per component tables, color table modes remember the colors already
+ * looked up in a direct mapped cache. The results are the same as calling
+ * grx_color_get() for every pixel.
+ */
+typedef struct {
+    GrxColorPaletteType type;
+    guint    gray_shift;
+    GrxColor lut[3][256];
+    guint32  key[RGBCONV_CACHE_SIZE];   /* 0x1000000 | RGB when valid */
+    GrxColor val[RGBCONV_CACHE_SIZE];
+} _GR_rgbConv;
+
+G_GNUC_INTERNAL _GR_rgbConv *_GrRgbConvNew(void);
+G_GNUC_INTERNAL void _GrRgbConvFree(_GR_rgbConv *cv);
+G_GNUC_INTERNAL GrxColor _GrRgbConvLookup(_GR_rgbConv *cv, guint r, guint g, guint b);
+G_GNUC_INTERNAL void _GrRgbConvRow(_GR_rgbConv *cv, const guint8 *rgb, gint step,
+                                   gint w, GrxColor *dst);
+
+static INLINE GrxColor _GrRgbConvPixel(_GR_rgbConv *cv, guint r, guint g, guint b)
+{
+    switch (cv->type) {
+    case GRX_COLOR_PALETTE_TYPE_RGB:
+        return cv->lut[0][r] | cv->lut[1][g] | cv->lut[2][b];
+    case GRX_COLOR_PALETTE_TYPE_GRAYSCALE:
+        return ((cv->lut[0][r] + cv->lut[1][g] + cv->lut[2][b]) >> 16) >> cv->gray_shift;
+    default:
+        return _GrRgbConvLookup(cv, r, g, b);
+    }
+}
+
+#endif /* __INCLUDE_RGBCONV_H__ */
@@ -25,9 +25,11 @@
 #include "libgrx.h"
 #include "clipping.h"
 #include "mempeek.h"
+#include "damage.h"
 
 #define  MSCURSOR       (MOUINFO->cursor)
 #define  SPECIALMODE    (MOUINFO->cursor_mode != GRX_CURSOR_MODE_NORMAL)
+#define  COMPOSITED     (MOUINFO->composited && DMGINFO->enabled)
 #define  BLOCKED        1
 #define  ERASED         2
 
@@ -61,6 +63,45 @@ static void draw_special(void)
         MOUINFO->docheck = check;
 }
 
+/* the screen area covered by the cursor and the special mode shapes */
+static void cursor_extent(int *x1,int *y1,int *x2,int *y2)
+{
+        *x1 = MSCURSOR->xcord - MSCURSOR->xoffs;
+        *y1 = MSCURSOR->ycord - MSCURSOR->yoffs;
+        *x2 = *x1 + MSCURSOR->xsize - 1;
+        *y2 = *y1 + MSCURSOR->ysize - 1;
+        if(SPECIALMODE) {
+            int cx1,cy1,cx2,cy2;
+            switch(MOUINFO->cursor_mode) {
+              case GRX_CURSOR_MODE_RUBBER:
+              case GRX_CURSOR_MODE_LINE:
+                cx1 = MSCURSOR->xcord;
+                cy1 = MSCURSOR->ycord;
+                cx2 = MOUINFO->x1;
+                cy2 = MOUINFO->y1;
+                break;
+              case GRX_CURSOR_MODE_BOX:
+                cx1 = MSCURSOR->xcord + MOUINFO->x1;
+                cy1 = MSCURSOR->ycord + MOUINFO->y1;
+                cx2 = MSCURSOR->xcord + MOUINFO->x2;
+                cy2 = MSCURSOR->ycord + MOUINFO->y2;
+                break;
+              default:
+                return;
+            }
+            isort(cx1,cx2); *x1 = imin(cx1,*x1); *x2 = imax(*x2,cx2);
+            isort(cy1,cy2); *y1 = imin(cy1,*y1); *y2 = imax(*y2,cy2);
+        }
+}
+
+/* a composited cursor only makes the video driver update the display */
+static void damage_mouse(void)
+{
+        int x1,y1,x2,y2;
+        cursor_extent(&x1,&y1,&x2,&y2);
+        _GrDamageAdd(SCRN,x1,y1,x2,y2);
+}
+
 static void move_mouse(void)
 {
         if((MOUINFO->xpos != MSCURSOR->xcord) ||
@@ -105,7 +146,7 @@ static void enable_mouse_cursor(void)
     if (MOUINFO->displayed) {
         return;
     }
-    MOUINFO->docheck = TRUE;
+    MOUINFO->docheck = !COMPOSITED;
     MOUINFO->blockflag = 0;
 }
 
@@ -126,6 +167,10 @@ static void disable_mouse_cursor(void)
     }
     MOUINFO->displayed = FALSE;
     MOUINFO->docheck = FALSE;
+    if (COMPOSITED) {
+        damage_mouse();
+        return;
+    }
     erase_mouse();
 }
 
@@ -141,6 +186,11 @@ void grx_mouse_set_cursor(GrxCursor *cursor)
         return;
     }
 
+    // a composited cursor can change shape while shown
+    if (COMPOSITED && MOUINFO->displayed && MOUINFO->cursor) {
+        damage_mouse();
+    }
+
     if (MOUINFO->cursor) {
         grx_cursor_unref(MOUINFO->cursor);
         MOUINFO->cursor = NULL;
@@ -153,6 +203,10 @@ void grx_mouse_set_cursor(GrxCursor *cursor)
             grx_cursor_hide(cursor);
         }
         MOUINFO->cursor = grx_cursor_ref(cursor);
+        if (COMPOSITED && MOUINFO->displayed) {
+            grx_cursor_move(cursor, MOUINFO->xpos, MOUINFO->ypos);
+            damage_mouse();
+        }
     }
 }
 
@@ -203,6 +257,54 @@ void grx_mouse_set_cursor_default(GrxColor fill_color, GrxColor border_color)
     grx_cursor_unref(newc);
 }
 
+/**
+ * grx_mouse_set_cursor_composited:
+ * @composited: %TRUE to composite the cursor
+ *
+ * Normally the cursor is drawn on the screen and every drawing function
+ * erases and redraws it when drawing near it, which makes it flicker over
+ * areas that change often. A composited cursor is only added to the picture
+ * when the video driver updates the display, so drawing does not have to
+ * check for it at all and reading the screen never returns cursor pixels.
+ *
+ * This only works with video drivers that copy the screen to the display,
+ * i.e. gtk3 and linuxfb with the "db" flag, the other drivers keep using the
+ * normal cursor. Like grx_mouse_set_cursor_mode(), this can only be changed
+ * while the cursor is not shown.
+ *
+ * Returns: %TRUE if the cursor is composited with the current video mode
+ */
+gboolean grx_mouse_set_cursor_composited(gboolean composited)
+{
+    if (!MOUINFO->displayed) {
+        MOUINFO->composited = composited;
+        MOUINFO->docheck = MOUINFO->enabled && !COMPOSITED;
+    }
+
+    return COMPOSITED;
+}
+
+void _GrMouseCompositeBegin(void)
+{
+    if (!COMPOSITED || !MOUINFO->displayed || !MSCURSOR || MSCURSOR->displayed) {
+        return;
+    }
+    // drawing the cursor into the frame is not a change of the screen
+    DMGINFO->enabled = FALSE;
+    draw_mouse();
+    DMGINFO->enabled = TRUE;
+}
+
+void _GrMouseCompositeEnd(void)
+{
+    if (!COMPOSITED || !MSCURSOR || !MSCURSOR->displayed) {
+        return;
+    }
+    DMGINFO->enabled = FALSE;
+    erase_mouse();
+    DMGINFO->enabled = TRUE;
+}
+
 /**
  * grx_mouse_set_cursor_mode: (skip)
  * @mode: the mode
@@ -250,25 +352,9 @@ static int block(GrxContext *c,int x1,int y1,int x2,int y2)
         my2 = MSCURSOR->ywork + my1 - 1;
         if(SPECIALMODE) {
             int cx1,cy1,cx2,cy2;
-            switch(MOUINFO->cursor_mode) {
-              case GRX_CURSOR_MODE_RUBBER:
-              case GRX_CURSOR_MODE_LINE:
-                cx1 = MSCURSOR->xcord;
-                cy1 = MSCURSOR->ycord;
-                cx2 = MOUINFO->x1;
-                cy2 = MOUINFO->y1;
-                break;
-              case GRX_CURSOR_MODE_BOX:
-                cx1 = MSCURSOR->xcord + MOUINFO->x1;
-                cy1 = MSCURSOR->ycord + MOUINFO->y1;
-                cx2 = MSCURSOR->xcord + MOUINFO->x2;
-                cy2 = MSCURSOR->ycord + MOUINFO->y2;
-                break;
-              default:
-                return(0);
-            }
-            isort(cx1,cx2); mx1 = imin(cx1,mx1); mx2 = imax(mx2,cx2);
-            isort(cy1,cy2); my1 = imin(cy1,my1); my2 = imax(my2,cy2);
+            cursor_extent(&cx1,&cy1,&cx2,&cy2);
+            mx1 = imin(cx1,mx1); mx2 = imax(mx2,cx2);
+            my1 = imin(cy1,my1); my2 = imax(my2,cy2);
         }
         x1 = imax(x1,mx1); y1 = imax(y1,my1);
         x2 = imin(x2,mx2); y2 = imin(y2,my2);
@@ -311,6 +397,22 @@ void _grx_mouse_update_cursor(void)
     if (MOUINFO->blockflag) {
         return;
     }
+    if (COMPOSITED) {
+        if G_UNLIKELY(MOUINFO->enabled && !MOUINFO->displayed) {
+            MOUINFO->displayed = TRUE;
+            grx_cursor_move(MSCURSOR, MOUINFO->xpos, MOUINFO->ypos);
+            damage_mouse();
+        }
+        else if (MOUINFO->displayed &&
+                 (MOUINFO->xpos != MSCURSOR->xcord ||
+                  MOUINFO->ypos != MSCURSOR->ycord))
+        {
+            damage_mouse();
+            grx_cursor_move(MSCURSOR, MOUINFO->xpos, MOUINFO->ypos);
+            damage_mouse();
+        }
+        return;
+    }
     if G_UNLIKELY(MOUINFO->enabled && !MOUINFO->displayed) {
         MOUINFO->displayed = TRUE;
         draw_mouse();
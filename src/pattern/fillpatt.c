@@ -18,8 +18,10 @@
  * Hartmut Schirmer (hsc@techfak.uni-kiel.de)
  */
 
+#include "colors.h"
 #include "globals.h"
 #include "libgrx.h"
+#include "grdriver.h"
 #include "arith.h"
 #include "shapes.h"
 
@@ -35,7 +37,10 @@ void _GrFillPatternExt(int x, int y, int sx, int sy, int width, GrxPixmap *p)
     int cpysize = pattwdt - xpatt;
     GrxColor optype = p->mode;
 
-    if (CURC->gc_is_on_screen) {
+    if (C_OPER(p->mode) == C_BLEND) {
+        bltfun = _GrFrDrvBlendBitBlt;
+    }
+    else if (CURC->gc_is_on_screen) {
         bltfun = CURC->gc_driver->bltr2v;
     }
     else {
@@ -188,6 +188,9 @@ GrxPixmap *grx_pixmap_new_from_bits(const unsigned char *bits,int w,int h,GrxCol
  * operations. NOTE: the pixmap pattern and the original context share the
  * drawing RAM, thus if the context is redrawn the fill pattern changes as well.
  *
+ * A context in #GRX_FRAME_MODE_RAM_32BPP_ARGB gives a pixmap that is
+ * composited over the filled area using its alpha channel.
+ *
  * Returns: (nullable): a new #GrxPixmap or %NULL if there was an error.
  */
 GrxPixmap *grx_pixmap_new_from_context(GrxContext *context)
@@ -206,7 +209,8 @@ GrxPixmap *grx_pixmap_new_from_context(GrxContext *context)
     result->is_pixmap = TRUE;
     result->width = context->x_max + 1;
     result->height = context->y_max + 1;
-    result->mode = 0;
+    result->mode = (context->gc_driver->mode == GRX_FRAME_MODE_RAM_32BPP_ARGB)
+        ? GRX_COLOR_MODE_BLEND : 0;
     if (context->gc_memory_flags & 1 /*MYCONTEXT*/) {
         result->context = grx_context_ref(context);
     }
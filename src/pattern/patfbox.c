@@ -15,9 +15,11 @@
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  */
 
+#include "colors.h"
 #include "globals.h"
 #include "mouse.h"
 #include "libgrx.h"
+#include "grdriver.h"
 #include "arith.h"
 #include "clipping.h"
 #include "shapes.h"
@@ -50,7 +52,10 @@ void grx_draw_filled_box_with_pixmap(int x1, int y1, int x2, int y2, GrxPixmap *
     int xoff = x1 % pwdt;
     int ypos = y1;
     int yoff = ypos % phgt;
-    if (CURC->gc_is_on_screen) {
+    if (C_OPER(p->mode) == C_BLEND) {
+        bltfun = _GrFrDrvBlendBitBlt;
+    }
+    else if (CURC->gc_is_on_screen) {
         bltfun = CURC->gc_driver->bltr2v;
     }
     else {
@@ -19,8 +19,10 @@
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  */
 
+#include "colors.h"
 #include "globals.h"
 #include "libgrx.h"
+#include "grdriver.h"
 #include "clipping.h"
 #include "shapes.h"
 #include "mouse.h"
@@ -31,6 +33,7 @@ void _GrPatternFilledLine(int x1,int y1,int dx,int dy,GrxPixmap *p)
         int sy,ymajor;
         int pw,ph,px,py;
         int points,error;
+        int blend;
 
         if (dx < 0) {
                 x1 += dx; dx = -dx;
@@ -65,8 +68,12 @@ void _GrPatternFilledLine(int x1,int y1,int dx,int dy,GrxPixmap *p)
             error  = dx >> 1;
             ymajor = FALSE;
         }
+        blend = (C_OPER(p->mode) == C_BLEND);
         while(--points >= 0) {
-            (*CURC->gc_driver->drawpixel)(
+            if(blend) _GrFrDrvBlendBitBlt(
+                &CURC->frame, x1, y1, src.c, px, py, 1, 1, p->mode
+            );
+            else (*CURC->gc_driver->drawpixel)(
                 x1, y1, (*src.c->driver->readpixel)(src.c,px,py)
             );
             if(ymajor) {
@@ -21,8 +21,10 @@
 
 #include <grx/pixmap.h>
 
+#include "colors.h"
 #include "globals.h"
 #include "libgrx.h"
+#include "grdriver.h"
 #include "clipping.h"
 #include "mouse.h"
 
@@ -32,6 +34,11 @@ void _GrPatternFilledPlot(int x,int y,GrxPixmap *p)
 
     xp = x % p->width;
     yp = y % p->height;
+    if (C_OPER(p->mode) == C_BLEND) {
+        // composite like the box and scanline fills do
+        _GrFrDrvBlendBitBlt(&CURC->frame, x, y, &p->source, xp, yp, 1, 1, p->mode);
+        return;
+    }
     (*CURC->gc_driver->drawpixel)(x, y,
         (*p->source.driver->readpixel)(&p->source,xp, yp)
     );
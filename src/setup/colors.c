@@ -15,6 +15,7 @@
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "colors.h"
@@ -25,6 +26,182 @@
 
 static void (*DACload)(GrxColor c, GrxColor r, GrxColor g, GrxColor b) = NULL;
 
+/*
+ * Inverse color map for the color table modes. Colors that are already in
+ * the table are found in a hash of their RGB values. The nearest color when
+ * the table is full is searched in a 5-6-5 bit cube: every cell lists the
+ * few colors that can be the nearest one to any point in it, worked out on
+ * first use. This gives the same color as searching the whole table. Both
+ * only hold the defined, read only colors and are built again after the
+ * table changed.
+ */
+#define INVMAP_HASH_SIZE    1024            /* > 2 * the colors of 8bpp modes */
+#define INVMAP_MAX_COLORS   (INVMAP_HASH_SIZE / 2)
+#define INVMAP_CUBE_SIZE    (32 * 64 * 32)
+#define INVMAP_MAX_ERR      1000            /* no nearest color from here on */
+
+static struct {
+        gboolean hash_valid;
+        gboolean cube_valid;
+        gint16   hash[INVMAP_HASH_SIZE];   /* color + 1, 0 for an empty slot */
+        gint32  *cube;                      /* list offset + 1, 0 if not known yet */
+        gint16  *list;                      /* colors of the cells, -1 terminated */
+        int      list_len;
+        int      list_size;
+} invmap;
+
+void _GrColorsChanged(void)
+{
+        invmap.hash_valid = FALSE;
+        invmap.cube_valid = FALSE;
+}
+
+static INLINE guint invmap_slot(GrxColor r, GrxColor g, GrxColor b)
+{
+        return ((((r << 16) | (g << 8) | b) * 0x9E3779B1u) >> 22) & (INVMAP_HASH_SIZE - 1);
+}
+
+static INLINE int usable_color(int i)
+{
+        return CLRINFO->ctable[i].defined && !CLRINFO->ctable[i].writable;
+}
+
+/* the first usable color with exactly this RGB value or -1 */
+static int invmap_exact(GrxColor r, GrxColor g, GrxColor b)
+{
+        guint h;
+        int i;
+        if (!invmap.hash_valid) {
+            memset(invmap.hash, 0, sizeof(invmap.hash));
+            for (i = 0; i < (int)CLRINFO->ncolors; i++) {
+                if (!usable_color(i)) continue;
+                h = invmap_slot(CLRINFO->ctable[i].r,CLRINFO->ctable[i].g,CLRINFO->ctable[i].b);
+                while (invmap.hash[h]) {
+                    int j = invmap.hash[h] - 1;
+                    if ((CLRINFO->ctable[j].r == CLRINFO->ctable[i].r) &&
+                        (CLRINFO->ctable[j].g == CLRINFO->ctable[i].g) &&
+                        (CLRINFO->ctable[j].b == CLRINFO->ctable[i].b)) break;
+                    h = (h + 1) & (INVMAP_HASH_SIZE - 1);
+                }
+                if (!invmap.hash[h]) invmap.hash[h] = i + 1;
+            }
+            invmap.hash_valid = TRUE;
+        }
+        for (h = invmap_slot(r,g,b); invmap.hash[h]; h = (h + 1) & (INVMAP_HASH_SIZE - 1)) {
+            i = invmap.hash[h] - 1;
+            if ((CLRINFO->ctable[i].r == r) &&
+                (CLRINFO->ctable[i].g == g) &&
+                (CLRINFO->ctable[i].b == b)) return i;
+        }
+        return -1;
+}
+
+static GR_int32u color_err(int i, GrxColor r, GrxColor g, GrxColor b)
+{
+        int dr = (int)r - CLRINFO->ctable[i].r;
+        int dg = (int)g - CLRINFO->ctable[i].g;
+        int db = (int)b - CLRINFO->ctable[i].b;
+        return dr * dr + dg * dg + db * db;
+}
+
+/* a newly allocated read only color */
+static void invmap_add(int i)
+{
+        guint h;
+        invmap.cube_valid = FALSE;
+        if (!invmap.hash_valid) return;
+        h = invmap_slot(CLRINFO->ctable[i].r,CLRINFO->ctable[i].g,CLRINFO->ctable[i].b);
+        while (invmap.hash[h]) h = (h + 1) & (INVMAP_HASH_SIZE - 1);
+        invmap.hash[h] = i + 1;
+}
+
+/* squared distances from the cell [lo,hi] to the value c: nearest, farthest */
+static INLINE GR_int32u dist_min(int c, int lo, int hi)
+{
+        int d = (c < lo) ? (lo - c) : (c > hi) ? (c - hi) : 0;
+        return d * d;
+}
+
+static INLINE GR_int32u dist_max(int c, int lo, int hi)
+{
+        int d = imax(iabs(c - lo), iabs(c - hi));
+        return d * d;
+}
+
+static int invmap_list_add(gint16 i)
+{
+        if (invmap.list_len == invmap.list_size) {
+            int size = invmap.list_size ? 2 * invmap.list_size : 4096;
+            gint16 *list = realloc(invmap.list, size * sizeof(gint16));
+            if (!list) return FALSE;
+            invmap.list = list;
+            invmap.list_size = size;
+        }
+        invmap.list[invmap.list_len++] = i;
+        return TRUE;
+}
+
+/* lists the colors which may be nearest to some point of the cell */
+static int invmap_cell(guint cell)
+{
+        int lo[3], hi[3];
+        GR_int32u limit = INVMAP_MAX_ERR - 1;
+        int i, start = invmap.list_len;
+        lo[0] = (cell >> 11) << 3;        hi[0] = lo[0] + 7;
+        lo[1] = ((cell >> 5) & 63) << 2;  hi[1] = lo[1] + 3;
+        lo[2] = (cell & 31) << 3;         hi[2] = lo[2] + 7;
+        /* no color is farther than the best worst case */
+        for (i = 0; i < (int)CLRINFO->ncolors; i++) {
+            if (usable_color(i)) {
+                GR_int32u d = dist_max(CLRINFO->ctable[i].r,lo[0],hi[0]) +
+                              dist_max(CLRINFO->ctable[i].g,lo[1],hi[1]) +
+                              dist_max(CLRINFO->ctable[i].b,lo[2],hi[2]);
+                if (d < limit) limit = d;
+            }
+        }
+        for (i = 0; i < (int)CLRINFO->ncolors; i++) {
+            if (usable_color(i)) {
+                GR_int32u d = dist_min(CLRINFO->ctable[i].r,lo[0],hi[0]) +
+                              dist_min(CLRINFO->ctable[i].g,lo[1],hi[1]) +
+                              dist_min(CLRINFO->ctable[i].b,lo[2],hi[2]);
+                if ((d <= limit) && !invmap_list_add(i)) break;
+            }
+        }
+        if ((i < (int)CLRINFO->ncolors) || !invmap_list_add(-1)) {
+            invmap.list_len = start;
+            return FALSE;
+        }
+        invmap.cube[cell] = start + 1;
+        return TRUE;
+}
+
+/* the usable color nearest to this RGB value, -1 if none is near enough */
+static int invmap_nearest(GrxColor r, GrxColor g, GrxColor b)
+{
+        guint cell = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+        GR_int32u err, minerr = INVMAP_MAX_ERR;
+        const gint16 *lp;
+        int best = -1;
+        if (!invmap.cube) {
+            invmap.cube = malloc(INVMAP_CUBE_SIZE * sizeof(invmap.cube[0]));
+            if (!invmap.cube) return -2;
+            invmap.cube_valid = FALSE;
+        }
+        if (!invmap.cube_valid) {
+            memset(invmap.cube, 0, INVMAP_CUBE_SIZE * sizeof(invmap.cube[0]));
+            invmap.list_len = 0;
+            invmap.cube_valid = TRUE;
+        }
+        if (!invmap.cube[cell] && !invmap_cell(cell)) return -2;
+        for (lp = &invmap.list[invmap.cube[cell] - 1]; *lp >= 0; lp++) {
+            if ((err = color_err(*lp,r,g,b)) < minerr) {
+                best = *lp;
+                if ((minerr = err) == 0) break;
+            }
+        }
+        return best;
+}
+
 static void load_color(GrxColor c, GrxColor r, GrxColor g, GrxColor b)
 {
         CLRINFO->ctable[c].r = (r &= CLRINFO->mask[0]);
@@ -96,6 +273,7 @@ int _GrResetColors(void)
             firsttime = FALSE;
         }
         sttzero(CLRINFO);
+        _GrColorsChanged();
         DACload = DRVINFO->actmode.extended_info->load_color;
         CLRINFO->black   = GRX_COLOR_NONE;
         CLRINFO->white   = GRX_COLOR_NONE;
@@ -236,6 +414,14 @@ GrxColor grx_color_get(unsigned char r, unsigned char g, unsigned char b)
             int free_ = (-1),allfree = (-1),best = (-1);
             int ndef = (int)CLRINFO->ncolors - (int)CLRINFO->nfree;
             DBGPRINTF(DBG_COLOR,("Allocating color: r=%d, g=%d, b=%d\n",r,g,b));
+            if(CLRINFO->ncolors <= INVMAP_MAX_COLORS) {
+                if((best = invmap_exact(r,g,b)) >= 0) goto foundbest;
+                /* a full table gets the nearest color without searching */
+                if((CLRINFO->nfree == 0) && ((best = invmap_nearest(r,g,b)) > -2)) {
+                    goto foundbest;
+                }
+                best = -1;
+            }
             for(i = 0; i < (int)CLRINFO->ncolors; i++) {
                 if(CLRINFO->ctable[i].defined) {
                     if(!CLRINFO->ctable[i].writable) {
@@ -282,6 +468,7 @@ GrxColor grx_color_get(unsigned char r, unsigned char g, unsigned char b)
                 CLRINFO->ctable[free_].nused    = 1;
                 CLRINFO->nfree--;
                 load_color(free_,r,g,b);
+                invmap_add(free_);
                 res = free_;
                 goto done;
             }
@@ -326,10 +513,13 @@ GrxColorCell grx_color_cell_get(void)
                 }
             }
             if(free_ >= 0) {
+                /* an unused read-only cell may still be cached for lookups */
+                int reused = CLRINFO->ctable[free_].defined;
                 CLRINFO->ctable[free_].defined  = TRUE;
                 CLRINFO->ctable[free_].writable = TRUE;
                 CLRINFO->ctable[free_].nused    = 1;
                 CLRINFO->nfree--;
+                if(reused) _GrColorsChanged();
                 load_color(free_,0,0,0);
                 return((GrxColor)(free_));
             }
@@ -359,6 +549,7 @@ void grx_color_put(GrxColor c)
                 CLRINFO->ctable[(int)(c)].defined  = FALSE;
                 CLRINFO->ctable[(int)(c)].writable = FALSE;
                 CLRINFO->ctable[(int)(c)].nused    = 0;
+                _GrColorsChanged();
             }
 }
 
@@ -381,6 +572,7 @@ void grx_color_cell_put(GrxColor c)
                 CLRINFO->ctable[(int)(c)].defined  = FALSE;
                 CLRINFO->ctable[(int)(c)].writable = FALSE;
                 CLRINFO->ctable[(int)(c)].nused    = 0;
+                _GrColorsChanged();
             }
         }
         GRX_LEAVE();
@@ -411,6 +603,7 @@ void grx_color_cell_set(GrxColor c,unsigned char r,unsigned char g,unsigned char
                 CLRINFO->ctable[(int)(c)].writable = TRUE;
                 CLRINFO->ctable[(int)(c)].nused    = 1;
                 CLRINFO->nfree--;
+                _GrColorsChanged();
             }
             if(CLRINFO->ctable[(int)(c)].writable) load_color(
                 (int)(c),
@@ -478,6 +671,7 @@ void grx_color_info_restore_colors(void *buffer)
         colorsave *cp = (colorsave *)buffer;
         if((cp->magic == CSAVE_MAGIC) && (cp->nc == grx_color_info_n_colors())) {
             sttcopy(CLRINFO,&cp->info);
+            _GrColorsChanged();
             grx_color_info_refresh_colors();
         }
 }
@@ -249,6 +249,10 @@ void grx_context_unref(GrxContext *ctx)
  * (For efficiency reasons – it is used quite frequently, and this way no
  * pointer dereferencing is necessary.) The context stores all relevant
  * information about the video organization, coordinate limits, etc...
+ *
+ * There is only one current context, so this and the drawing functions that
+ * use it should only be called from the main thread. Other threads can use
+ * the grx_context_draw_*() functions instead.
  */
 void grx_set_current_context(const GrxContext *context)
 {
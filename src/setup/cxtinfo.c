@@ -49,3 +49,6 @@ struct _GR_contextInfo _GrContextInfo = {
         .root = NULL,
     },
 };
+
+GR_THREAD_LOCAL GrxContext     *_GrCurrentContext     = &_GrContextInfo.current;
+GR_THREAD_LOCAL GrxFrameDriver *_GrCurrentFrameDriver = &_GrDriverInfo.fdriver;
@@ -19,6 +19,7 @@
 #include <grx/extents.h>
 #include <grx/mode.h>
 
+#include "globals.h"
 #include "libgrx.h"
 
 /**
@@ -0,0 +1,181 @@
+/*
+ * damage.c - screen damage tracking
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <glib.h>
+#include <string.h>
+
+#include <grx/context.h>
+#include <grx/mode.h>
+
+#include "globals.h"
+#include "libgrx.h"
+#include "arith.h"
+#include "damage.h"
+
+struct _GR_damageInfo _GrDamageInfo;
+
+static int area(int x1, int y1, int x2, int y2)
+{
+    return (x2 - x1 + 1) * (y2 - y1 + 1);
+}
+
+static void add_rect(int x1, int y1, int x2, int y2)
+{
+    _GR_damageRect *r, *best;
+    int i, grow, best_grow;
+
+    // already covered or overlapping: grow that rect
+    for (i = 0; i < DMGINFO->count; i++) {
+        r = &DMGINFO->rects[i];
+        if (x1 <= r->x2 + 1 && x2 >= r->x1 - 1 &&
+            y1 <= r->y2 + 1 && y2 >= r->y1 - 1)
+        {
+            r->x1 = imin(r->x1, x1);
+            r->y1 = imin(r->y1, y1);
+            r->x2 = imax(r->x2, x2);
+            r->y2 = imax(r->y2, y2);
+            return;
+        }
+    }
+
+    if (DMGINFO->count < GRX_DAMAGE_MAX_RECTS) {
+        r = &DMGINFO->rects[DMGINFO->count++];
+        r->x1 = x1;
+        r->y1 = y1;
+        r->x2 = x2;
+        r->y2 = y2;
+        return;
+    }
+
+    // out of rects: merge with the one that grows the least
+    best = NULL;
+    best_grow = 0;
+    for (i = 0; i < DMGINFO->count; i++) {
+        r = &DMGINFO->rects[i];
+        grow = area(imin(r->x1, x1), imin(r->y1, y1),
+                    imax(r->x2, x2), imax(r->y2, y2)) -
+               area(r->x1, r->y1, r->x2, r->y2);
+        if (!best || grow < best_grow) {
+            best = r;
+            best_grow = grow;
+        }
+    }
+    best->x1 = imin(best->x1, x1);
+    best->y1 = imin(best->y1, y1);
+    best->x2 = imax(best->x2, x2);
+    best->y2 = imax(best->y2, y2);
+}
+
+void _GrDamageAdd(const GrxContext *c, int x1, int y1, int x2, int y2)
+{
+    isort(x1, x2);
+    isort(y1, y2);
+    x1 = imax(x1 + c->x_offset, 0);
+    y1 = imax(y1 + c->y_offset, 0);
+    x2 = imin(x2 + c->x_offset, SCRN->x_max);
+    y2 = imin(y2 + c->y_offset, SCRN->y_max);
+    if (x1 > x2 || y1 > y2) {
+        return;
+    }
+
+    add_rect(x1, y1, x2, y2);
+
+    if (!DMGINFO->notified) {
+        DMGINFO->notified = TRUE;
+        (*DRVINFO->actmode.extended_info->damaged)();
+    }
+}
+
+void _GrDamageInit(GrxVideoMode *md)
+{
+    DMGINFO->count = 0;
+    DMGINFO->notified = FALSE;
+    DMGINFO->enabled = (md->extended_info->damaged != NULL) &&
+                       (md->extended_info->mode != GRX_FRAME_MODE_TEXT);
+    if (DMGINFO->enabled) {
+        // the whole frame is new
+        _GrDamageAdd(SCRN, 0, 0, SCRN->x_max, SCRN->y_max);
+    }
+}
+
+/*
+ * _GrDamageTake:
+ * @rects: array of at least GRX_DAMAGE_MAX_RECTS elements
+ *
+ * Moves the damaged areas of the screen to @rects. The screen is clean
+ * afterwards, so the next drawing operation notifies the video driver again.
+ *
+ * Returns: the number of rects
+ */
+int _GrDamageTake(_GR_damageRect *rects)
+{
+    int n = DMGINFO->count;
+
+    memcpy(rects, DMGINFO->rects, n * sizeof(*rects));
+    DMGINFO->count = 0;
+    DMGINFO->notified = FALSE;
+
+    return n;
+}
+
+/**
+ * grx_present_screen:
+ *
+ * Makes everything drawn on the screen so far visible right away.
+ *
+ * Some video drivers draw to a buffer in system memory and copy the changed
+ * areas to the display when the main loop is idle (e.g. linuxfb with the "db"
+ * flag). Call this at the end of a frame to show it without waiting, e.g. in
+ * a loop that does not return to the main loop. Does nothing for video drivers
+ * that draw directly to the display, except marking the end of a frame for
+ * the latency measurements (see grx_latency_set_enabled()).
+ */
+void grx_present_screen(void)
+{
+    GrxVideoModeExt *ext = DRVINFO->actmode.extended_info;
+
+    if (ext && ext->present) {
+        (*ext->present)();
+    }
+    else {
+        _GrLatencyPresented();
+    }
+}
+
+/**
+ * grx_context_mark_dirty:
+ * @context: (nullable): the context or %NULL for the current context
+ * @x1: the left X coordinate
+ * @y1: the top Y coordinate
+ * @x2: the right X coordinate
+ * @y2: the bottom Y coordinate
+ *
+ * Tells the video driver that an area of a screen context changed.
+ *
+ * Video drivers that have to copy the frame buffer to show it (e.g. gtk3) only
+ * update the areas that the drawing functions touched. This is only needed
+ * after changing screen pixels without the library knowing about it, i.e.
+ * when writing to the frame memory directly or when using the
+ * grx_fast_draw_pixel() macro. It does nothing for contexts that are not on
+ * the screen.
+ */
+void grx_context_mark_dirty(GrxContext *context, gint x1, gint y1, gint x2, gint y2)
+{
+    if (!context) {
+        context = CURC;
+    }
+    damage_add(context, x1, y1, x2, y2);
+}
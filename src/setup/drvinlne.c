@@ -18,6 +18,7 @@
 #include <grx/extents.h>
 #include <grx/mode.h>
 
+#include "globals.h"
 #include "libgrx.h"
 
 /**
@@ -55,6 +55,7 @@ gint grx_frame_mode_get_bpp(GrxFrameMode mode)
     case GRX_FRAME_MODE_LFB_32BPP_HIGH:
     case GRX_FRAME_MODE_RAM_32BPP_LOW:
     case GRX_FRAME_MODE_RAM_32BPP_HIGH:
+    case GRX_FRAME_MODE_RAM_32BPP_ARGB:
         return 32;
     default:
         return -1;
@@ -57,7 +57,9 @@ static const char *nxtoken(const char *p, char *token)
  *
  * - "<name>" is the name of a video driver plugin.
  * - "<flag>" is "fs" for fullscreen or "ww" for windowed (not supported by all
- *   drivers)
+ *   drivers) or "db" to draw to a back buffer in system memory (linuxfb only)
+ *   or "it" to read input devices on a separate thread (linuxfb only).
+ *   Several flags are separated by commas, e.g. "linuxfb::db,it".
  * - "<width>" is the default width
  * - "<height>" is the default height
  * - "<colors>" is the default color depth. "K" and "M" suffixes are recognized.
@@ -125,8 +127,8 @@ int grx_set_driver(const char *drvspec, GError **error)
                 }
                 strcpy(name,t);
             }
-            for (p2 = name; (p2 = strchr(p,':')) != NULL; p2++) {
-                if (p[1] == ':') {
+            for (p2 = name; (p2 = strchr(p2,':')) != NULL; p2++) {
+                if (p2[1] == ':') {
                     strcpy(options, &p2[2]);
                     *p2 = '\0';
                     break;
@@ -29,6 +29,7 @@
 #include "memfill.h"
 #include "memcopy.h"
 #include "grdriver.h"
+#include "damage.h"
 #include "util.h"
 #include "../mouse/input.h"
 
@@ -102,6 +103,8 @@ static int buildframedriver(GrxVideoMode *mp,GrxFrameDriver *drv)
             MERGE(bltr2v);
             MERGE(getindexedscanline);
             MERGE(putscanline);
+            /* optional, callers fall back to a generic routine */
+            if(d2->blendspan || !d1) drv->blendspan = d2->blendspan;
             if(compl) {
                 memcpy(drv,d2,offsetof(GrxFrameDriver,readpixel));
                 goto done; /* TRUE */
@@ -428,6 +431,7 @@ int grx_set_mode(GrxGraphicsMode which, GError **error, ...)
                 DRVINFO->mcode   = which;
                 DRVINFO->vposx   = 0;
                 DRVINFO->vposy   = 0;
+                _GrDamageInit(&DRVINFO->actmode);
                 g_debug ("grx_color_info_reset_colors ...");
                 if ( !_GrResetColors() ) {
                     res = FALSE;
@@ -15,240 +15,354 @@
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  */
 
-#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <grx/draw_nc.h>
 
 #include "globals.h"
 #include "libgrx.h"
-#include "memfill.h"
+#include "arith.h"
 #include "mouse.h"
 #include "shapes.h"
 
-static ScanFillFunc _filler;
-static GrFillArg _fa;
-static int lx, ly, mx, my, lxo, lyo;
-static GrxColor _border;
-static jmp_buf error;
-
-typedef unsigned char element;       /* for 1bit/pixel images */
-typedef unsigned short line_index;   /* start index table */
-static element **done  = NULL;       /* bitmap of already processed pixel */
-static element **start = NULL;       /* pixel that need to be processed */
-static unsigned elements;            /* no. bytes in each bitmap line */
-static line_index *start_flg = NULL; /* !=0: index+1 of first start element !=0 */
-                                     /* ==0: nothing to do */
-
-#define bits_per_element  (sizeof(element)*8)
-#define offset_div        (bits_per_element)
-#define calc_bit(x)       ( ((element)1) << ((x)&(bits_per_element-1)))
-#define calc_high_bits(x) ( (~((element)0)) << ((x)&(bits_per_element-1)))
-#define calc_ofs(x)       ((x) / offset_div)
-
-/* -------- internal line buffer functions
-**
-**  (x,y) scaled to (0..mx,0..my)
-*/
-
-static INLINE
-element *generate_line(element **buf, int y) {
-  if (buf[y] == NULL)
-    if ( (buf[y] = calloc(sizeof(element),elements)) == NULL)
-      longjmp(error,1);
-  return buf[y];
-}
-
-static INLINE
-void mark_line( element **buf, int x1, int x2, int y) {
-  element *l = generate_line(buf,y);
-  element *anf, *ende;
-  int start_bit, stop_bit;
-
-  anf  = &l[calc_ofs(x1)];
-  ende = &l[calc_ofs(x2)];
-  start_bit = calc_high_bits(x1);
-  if (anf != ende) {
-    *(anf++) |= start_bit;
-    if (anf != ende) {
-      GR_repl cv = ~((GR_repl)0);
-      unsigned w = (ende-anf)*sizeof(element);
-      repfill_b(anf,cv,w);
-    }
-    start_bit = ~0;
-  }
-  /* start_bit rejects all invalid low bits, let stop_bit discard
-     all invalid high bits, but make sure stop_bit won't get zero */
-  stop_bit = ~calc_high_bits(x2+1);
-  if (stop_bit) start_bit &= stop_bit;
-  *ende |= start_bit;
-}
-
-static INLINE
-void set_pix(element **buf, int x, int y) {
-  element *l = generate_line(buf,y);
-  l[calc_ofs(x)] |= calc_bit(x);
-}
-
-static INLINE
-int test_pix(element **buf, int x, int y) {
-  element *l = buf[y];
-  if (l != NULL)
-    return (l[calc_ofs(x)] & calc_bit(x)) != 0;
-  return FALSE;
-}
-
-static INLINE
-int test_screen(int x, int y) {
-  return (grx_fast_get_pixel_at(x+lx,y+ly) == _border);
-}
-
-static INLINE
-int test_pixel(int x, int y) {
-  if (test_pix(done,x,y)) return TRUE;
-  if (test_screen(x,y)) {
-    set_pix(done,x,y);
-    return TRUE;
-  }
-  return FALSE;
-}
-
-static INLINE
-void SetStartFlag(int x, int y) {
-    int _x = calc_ofs(x);
-    if (   !start_flg[y]
-        || _x<start_flg[y] ) start_flg[y] = _x+1;
-}
-
-/* -------- screen & buffer fill functions
-**
-**  (x,y) scaled to (0..mx,0..my)
-**  (0,0) maps to (lx,ly) on screen
-*/
-
-static void fill(int x, int y) {
-  int sx;
-
-  sx = x;
-  while ( sx > 0 && !test_pixel(sx-1,y))
-    --sx;
-  while ( x < mx && !test_pixel(x+1,y))
-    ++x;
-  (*_filler)(sx+lxo,y+lyo,x-sx+1,_fa);
-  mark_line( done, sx, x, y);
-  if (y>0)  { mark_line( start, sx, x, y-1);
-              SetStartFlag(sx,y-1);          }
-  if (y<my) { mark_line( start, sx, x, y+1);
-              SetStartFlag(sx,y+1);          }
-}
-
-/* -------- find fill area
-**
-**  (x,y) scaled to (0..mx,0..my)
-*/
-
-static void work(void) {
-  int top;
-  element *s, *d;
-  int rescan, dir = 1;
-
-  top = 0;
-  do {
-    rescan = 0;
-    while (0 <= top && top <= my) {
-ThisLine:
-      if ( (s=start[top]) != NULL && start_flg[top]) {
-        unsigned i;
-        if ( (d=done[top]) != NULL) {
-          i= start_flg[top]-1; /* start_flg[top] > 1 here */
-          s += i; d += i;
-          for ( ; i < elements ; ++i)
-             *(s++) &= ~*(d++);
-          s = start[top];
-        }
-        i=start_flg[top]-1; start_flg[top] = 0;
-        for ( s += i; i < elements ; ++i, ++s)
-          if (*s) {
-            element b = 1;
-            int x = i*offset_div;
-            do {
-              while ( !(*s&b)) { ++x; b <<= 1; }
-              if (test_screen(x,top)) {
-                set_pix(done,x,top);
-                *s ^= b;
-              } else {
-                SetStartFlag(x,top);
-                fill(x,top);
-                rescan = 1;
-                goto ThisLine;
-              }
-            } while (*s);
-          }
-      }
-      top += dir;
-    }
-    dir = -dir;
-    top += dir;
-  } while (rescan);
-}
+/*
+ * Scanline flood fill. Every filled run is pushed on a span stack, popping
+ * it scans the rows above or below for the runs that still have to be
+ * filled. Rows are read from the frame driver in chunks and the border is
+ * searched for two pixels at a time. Filled pixels are remembered in one
+ * bitmap covering the clip box, so fill colors equal to the border color
+ * (or patterns containing it) do not confuse the search.
+ *
+ * The span stack has a fixed size. When it runs full the spans that do not
+ * fit are dropped and the bitmap is swept afterwards for filled runs that
+ * may still have unfilled neighbors.
+ */
 
-void _GrFloodFill(int x,int y,GrxColor border,GrFiller *f,GrFillArg fa) {
-  int _x, _y;
+#define FLOOD_STACK_SIZE  512       /* entries of the span stack */
+#define FLOOD_CHUNK       32        /* pixels read from the frame at once */
+#define FLOOD_ROWS        4         /* rows kept in the row cache */
+
+typedef unsigned long fword;        /* bitmap word */
+#define FWORD_BITS        (sizeof(fword) * 8)
 
-  lx = CURC->x_clip_low;
-  mx = CURC->x_clip_high;
-  ly = CURC->y_clip_low;
-  my = CURC->y_clip_high;
-  lxo = lx + CURC->x_offset;
-  lyo = ly + CURC->y_offset;
+typedef struct {
+  int y, x1, x2, dy;                /* filled run and direction to scan */
+} span;
 
-  if ( x < lx || y < ly || x > mx || y > my || grx_fast_get_pixel_at(x,y) == border)
+typedef struct {
+  GrxColor *pix;                    /* pixels of row y, index x - lx */
+  int y, x1, x2;                    /* row and columns in pix[] */
+} cached_row;
+
+typedef struct {
+  int lx, ly, mx, my;               /* clip box */
+  GrxColor border;
+  GrFiller *f;
+  GrFillArg fa;
+  fword *done;                      /* filled pixels, one bit each */
+  int words;                        /* bitmap words per row */
+  cached_row rows[FLOOD_ROWS];      /* row cache, indexed by y % FLOOD_ROWS */
+  int error;                        /* reading the frame failed */
+  int overflow;                     /* spans were dropped */
+  int sp;                           /* span stack pointer */
+  span stack[FLOOD_STACK_SIZE];
+} flood;
+
+/* -------- bitmap of the filled pixels, (x,y) relative to (lx,ly) -------- */
+
+static fword *done_row(flood *fl, int y) {
+  return &fl->done[(size_t)y * fl->words];
+}
+
+static void mark_done(flood *fl, int y, int x1, int x2) {
+  fword *d = done_row(fl,y);
+  int w1 = x1 / FWORD_BITS, w2 = x2 / FWORD_BITS;
+  fword m1 = ~(fword)0 << (x1 % FWORD_BITS);
+  fword m2 = ~(fword)0 >> (FWORD_BITS - 1 - (x2 % FWORD_BITS));
+  if (w1 == w2) {
+    d[w1] |= m1 & m2;
     return;
+  }
+  d[w1++] |= m1;
+  while (w1 < w2) d[w1++] = ~(fword)0;
+  d[w2] |= m2;
+}
 
-  _border = border;
-  _filler = f->scan;
-  _fa = fa;
-  mx -= lx; _x = x - lx;
-  my -= ly; _y = y - ly;
-  done      = calloc(sizeof(element *),  (size_t)(my+1));
-  start     = calloc(sizeof(element *),  (size_t)(my+1));
-  start_flg = calloc(sizeof(line_index), (size_t)(my+1));
-  if (done==NULL || start==NULL || start_flg==NULL) {
-/*  ERR = grNoFloodMem; */
-    goto FreeMem;
+/* index of the lowest set bit of b, b must not be 0 */
+static INLINE int lowest_bit(fword b) {
+#if defined(__GNUC__)
+  return __builtin_ctzl(b);
+#else
+  int n = 0;
+  while (!(b & 0xff)) { b >>= 8; n += 8; }
+  while (!(b & 1)) { b >>= 1; n++; }
+  return n;
+#endif
+}
+
+/* first x in [x,lim] whose bit equals val, lim+1 if none */
+static int scan_done(flood *fl, int y, int x, int lim, int val) {
+  fword *d = done_row(fl,y);
+  fword inv = val ? 0 : ~(fword)0;
+  int w = x / FWORD_BITS;
+  fword b;
+  if (x > lim) return lim + 1;
+  b = (d[w] ^ inv) & (~(fword)0 << (x % FWORD_BITS));
+  while (!b) {
+    if (++w * (int)FWORD_BITS > lim) return lim + 1;
+    b = d[w] ^ inv;
   }
+  x = w * FWORD_BITS + lowest_bit(b);
+  return (x > lim) ? lim + 1 : x;
+}
 
-  if (setjmp(error) == 0) {
-    elements = calc_ofs(mx + bits_per_element) + 1;
+/* -------- pixels of the frame, (x,y) relative to (lx,ly) -------- */
 
-    mouse_block(CURC,lx,ly,mx,my);
-    set_pix(start, _x, _y);
-    SetStartFlag(_x,_y);
-    work();
-    mouse_unblock();
+/*
+ * Returns the cached pixels of row y, making sure that x1..x2 are in it.
+ * Pixels filled since they were read are never looked at again, so the
+ * cache does not have to be updated when filling.
+ */
+static GrxColor *fetch(flood *fl, int y, int x1, int x2) {
+  const GrxColor *p;
+  int w;
+  cached_row *r = &fl->rows[y % FLOOD_ROWS];
+  if (y != r->y) {
+    r->y  = y;
+    r->x1 = 0;
+    r->x2 = -1;
+  }
+  if (x1 >= r->x1 && x2 <= r->x2) return r->pix;
+  /* read whole chunks and keep the cached columns contiguous */
+  x1 = x1 / FLOOD_CHUNK * FLOOD_CHUNK;
+  x2 = imin((x2 / FLOOD_CHUNK + 1) * FLOOD_CHUNK - 1, fl->mx - fl->lx);
+  if (r->x1 <= r->x2) {
+    if (x2 <= r->x2) x2 = r->x1 - 1;
+    else if (x1 >= r->x1) x1 = r->x2 + 1;
+    else {
+      /* both sides missing, read everything again */
+      r->x2 = -1;
+    }
+  }
+  w = x2 - x1 + 1;
+  p = (*CURC->gc_driver->getindexedscanline)(
+      &CURC->frame,
+      x1 + fl->lx + CURC->x_offset,
+      y + fl->ly + CURC->y_offset,
+      w,
+      NULL
+  );
+  if (p == NULL) {
+    fl->error = TRUE;
+    return NULL;
+  }
+  memcpy(&r->pix[x1], p, w * sizeof(GrxColor));
+  if (r->x1 > r->x2) {
+    r->x1 = x1;
+    r->x2 = x2;
   } else {
-    /* generate_line() called longjmp() : out of memory error */
-/*  ERR = grNoFloodMem; */
+    r->x1 = imin(r->x1, x1);
+    r->x2 = imax(r->x2, x2);
+  }
+  return r->pix;
+}
+
+/* first i in [0,n) where (p[i] == c) equals val, n if none */
+static int scan_color(const GrxColor *p, int n, GrxColor c, int val) {
+  int i = 0;
+#ifdef GR_int64
+  if (sizeof(GrxColor) == 4) {
+    GR_int64u cc = ((GR_int64u)c << 32) | c;
+    for ( ; i + 2 <= n; i += 2) {
+      GR_int64u v;
+      memcpy(&v, &p[i], 8);
+      v ^= cc;
+      if (val ? (!(GR_int32u)v || !(v >> 32)) : (v != 0)) break;
+    }
   }
+#endif
+  for ( ; i < n; ++i)
+    if ((p[i] == c) == val) break;
+  return i;
+}
 
-FreeMem:
-  if (done != NULL) {
+/* first x in [x,lim] with (pixel == border) equal to val, lim+1 if none */
+static int scan_border(flood *fl, int y, int x, int lim, int val) {
+  while (x <= lim) {
+    int x2 = imin(lim, x + FLOOD_CHUNK - 1);
+    GrxColor *pix = fetch(fl,y,x,x2);
     int i;
-    for (i=my; i >= 0; --i)
-      if (done[i] != NULL)
-        free(done[i]);
-    free(done);
-    done = NULL;
+    if (pix == NULL) return lim + 1;
+    i = scan_color(&pix[x], x2 - x + 1, fl->border, val);
+    if (x + i <= x2) return x + i;
+    x = x2 + 1;
+  }
+  return lim + 1;
+}
+
+/* first x in [x,lim] that still has to be filled, lim+1 if none */
+static int next_open(flood *fl, int y, int x, int lim) {
+  while (x <= lim) {
+    int x2 = scan_done(fl,y,x,lim,FALSE);
+    if (x2 > lim) break;
+    x = scan_border(fl,y,x2,lim,FALSE);
+    if (x > lim || x == x2) {
+      /* not filled yet and not border, unless a read failed */
+      return fl->error ? lim + 1 : x;
+    }
   }
-  if (start != NULL) {
+  return lim + 1;
+}
+
+/* last x of the open run starting at x */
+static int run_end(flood *fl, int y, int x) {
+  int lim = fl->mx - fl->lx;
+  lim = scan_done(fl,y,x,lim,TRUE) - 1;
+  return scan_border(fl,y,x,lim,TRUE) - 1;
+}
+
+/* first x of the open run ending at x */
+static int run_start(flood *fl, int y, int x) {
+  while (x > 0) {
+    int x1 = imax(0, x - FLOOD_CHUNK);
+    GrxColor *pix = fetch(fl,y,x1,x - 1);
     int i;
-    for (i=my; i >= 0; --i)
-      if (start[i] != NULL)
-        free(start[i]);
-    free(start);
-    start = NULL;
+    if (pix == NULL) break;
+    for (i = x - 1; i >= x1; --i) {
+      if (pix[i] == fl->border) return i + 1;
+      if (done_row(fl,y)[i / FWORD_BITS] & ((fword)1 << (i % FWORD_BITS)))
+        return i + 1;
+    }
+    x = x1;
+  }
+  return x;
+}
+
+/* -------- the fill itself -------- */
+
+static void push(flood *fl, int y, int x1, int x2, int dy) {
+  span *s;
+  if (y + dy < 0 || y + dy > fl->my - fl->ly) return;
+  if (fl->sp == FLOOD_STACK_SIZE) {
+    fl->overflow = TRUE;
+    return;
+  }
+  s = &fl->stack[fl->sp++];
+  s->y = y; s->x1 = x1; s->x2 = x2; s->dy = dy;
+}
+
+static void fill_run(flood *fl, int y, int x1, int x2) {
+  mark_done(fl,y,x1,x2);
+  (*fl->f->scan)(
+      x1 + fl->lx + CURC->x_offset,
+      y + fl->ly + CURC->y_offset,
+      x2 - x1 + 1,
+      fl->fa
+  );
+}
+
+/* fill the open runs in the row next to a filled run */
+static void scan_span(flood *fl, span *s) {
+  int y = s->y + s->dy;
+  int x = s->x1;
+  for ( ; ; ) {
+    int x1, x2;
+    x = next_open(fl,y,x,s->x2);
+    if (x > s->x2) break;
+    x1 = (x == s->x1) ? run_start(fl,y,x) : x;
+    x2 = run_end(fl,y,x);
+    if (fl->error) break;
+    fill_run(fl,y,x1,x2);
+    push(fl,y,x1,x2,s->dy);
+    /* the row we came from is filled below the parent run */
+    if (x1 < s->x1) push(fl,y,x1,s->x1 - 1,-s->dy);
+    if (x2 > s->x2) push(fl,y,s->x2 + 1,x2,-s->dy);
+    x = x2 + 2;
+  }
+}
+
+static void drain(flood *fl) {
+  while (fl->sp > 0 && !fl->error) {
+    span s = fl->stack[--fl->sp];
+    scan_span(fl,&s);
   }
-  if (start_flg != NULL) {
-    free(start_flg);
-    start_flg = NULL;
+}
+
+/* push every filled run again after spans have been dropped */
+static void sweep(flood *fl) {
+  int y, x, lim = fl->mx - fl->lx;
+  for (y = 0; y <= fl->my - fl->ly && !fl->error; ++y) {
+    for (x = 0; ; ) {
+      int x2;
+      x = scan_done(fl,y,x,lim,TRUE);
+      if (x > lim) break;
+      x2 = scan_done(fl,y,x,lim,FALSE) - 1;
+      if (fl->sp > FLOOD_STACK_SIZE - 2) drain(fl);
+      push(fl,y,x,x2,1);
+      push(fl,y,x,x2,-1);
+      x = x2 + 1;
+    }
+  }
+  drain(fl);
+}
+
+void _GrFloodFill(int x,int y,GrxColor border,GrFiller *f,GrFillArg fa) {
+  flood *fl;
+  GrxColor *pix, *row;
+  int w, h, i, x1, x2;
+
+  if ( x < CURC->x_clip_low || y < CURC->y_clip_low ||
+       x > CURC->x_clip_high || y > CURC->y_clip_high )
+    return;
+
+  fl = malloc(sizeof(*fl));
+  if (fl == NULL) return;
+  fl->lx = CURC->x_clip_low;
+  fl->ly = CURC->y_clip_low;
+  fl->mx = CURC->x_clip_high;
+  fl->my = CURC->y_clip_high;
+  fl->border = border;
+  fl->f = f;
+  fl->fa = fa;
+  w = fl->mx - fl->lx + 1;
+  h = fl->my - fl->ly + 1;
+  fl->words = (w + FWORD_BITS - 1) / FWORD_BITS;
+  fl->done = calloc((size_t)fl->words * h, sizeof(fword));
+  pix = malloc((size_t)w * FLOOD_ROWS * sizeof(GrxColor));
+  fl->error = FALSE;
+  fl->overflow = FALSE;
+  fl->sp = 0;
+  if (fl->done == NULL || pix == NULL) {
+    goto FreeMem;
+  }
+  for (i = 0; i < FLOOD_ROWS; ++i) {
+    fl->rows[i].pix = pix + i * w;
+    fl->rows[i].y = -1;
   }
+
+  x -= fl->lx;
+  y -= fl->ly;
+  mouse_block(CURC,fl->lx,fl->ly,fl->mx,fl->my);
+  row = fetch(fl,y,x,x);
+  if (row != NULL && row[x] != border) {
+    x1 = run_start(fl,y,x);
+    x2 = run_end(fl,y,x);
+    if (!fl->error) {
+      fill_run(fl,y,x1,x2);
+      push(fl,y,x1,x2,1);
+      push(fl,y,x1,x2,-1);
+      drain(fl);
+      while (fl->overflow && !fl->error) {
+        fl->overflow = FALSE;
+        sweep(fl);
+      }
+    }
+  }
+  mouse_unblock();
+
+FreeMem:
+  free(fl->done);
+  free(pix);
+  free(fl);
 }
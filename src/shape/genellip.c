@@ -63,9 +63,9 @@ static int sintab[PQUART + 1] = {
     16384
 };
 
-static int last_xs = 0,last_ys = 0;
-static int last_xe = 0,last_ye = 0;
-static int last_xc = 0,last_yc = 0;
+static GR_THREAD_LOCAL int last_xs = 0,last_ys = 0;
+static GR_THREAD_LOCAL int last_xe = 0,last_ye = 0;
+static GR_THREAD_LOCAL int last_xc = 0,last_yc = 0;
 
 static void GrSinCos(int n,int cx,int cy,int rx,int ry,GrxPoint *pt)
 {
@@ -15,6 +15,8 @@
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
  */
 
+#include <stdlib.h>
+
 #include <grx/draw.h>
 #include <grx/extents.h>
 
@@ -27,75 +29,79 @@
 #include "mouse.h"
 #include "polyedge.h"
 
-typedef enum {
-    inactive,                           /* not reached yet */
-    active,                             /* currently contributes point */
-    passed                              /* above current scan line */
-} edgestat;
+/*
+ * The polygon is filled with a sorted edge table and an active edge table:
+ * edges enter the active table on the row where they start and leave it
+ * after their last row, so every row only looks at the edges crossing it.
+ * The active table is kept in X order by an insertion sort, which is cheap
+ * because the order rarely changes from one row to the next.
+ */
 
 typedef struct {
-    edgestat status;                    /* status of this edge */
     polyedge e;                         /* the edge data */
+    int x1,x2;                          /* pixels covered in the current row */
 } edge;
 
-typedef struct _scan {
-    struct _scan *next;                 /* next segment/point in the list */
-    int    x1,x2;                       /* endpoints of this filled segment */
+typedef struct {
+    int x1,x2;                          /* endpoints of a filled segment */
 } scan;
 
-#define add_scanpoint(List,Scp,X1,X2) {                         \
-    scan *prev = NULL;                                          \
-    scan *work = List;                                          \
-    while(work != NULL) {                                       \
-        if(work->x1 > X1) break;                                \
-        prev = work;                                            \
-        work = work->next;                                      \
-    }                                                           \
-    Scp->x1   = X1;                                             \
-    Scp->x2   = X2;                                             \
-    Scp->next = work;                                           \
-    if(prev) prev->next = Scp;                                  \
-    else     List       = Scp;                                  \
+typedef struct {
+    int y;                              /* the row being filled */
+    int x1,x2;                          /* the pending segment */
+    int valid;                          /* x1/x2 hold a segment */
+    GrFiller *f;
+    GrFillArg c;
+} scanrow;
+
+/* edges by starting row; ties keep the order of the edge array */
+static int cmp_edge_y(const void *a,const void *b)
+{
+        const edge *ea = *(const edge **)a;
+        const edge *eb = *(const edge **)b;
+        if(ea->e.y != eb->e.y) return (ea->e.y < eb->e.y) ? -1 : 1;
+        return (ea < eb) ? -1 : (ea > eb);
 }
 
-#define add_scansegment(List,Scp,X1,X2) {                       \
-    scan *prev   = NULL;                                        \
-    scan *work   = List;                                        \
-    int  overlap = FALSE;                                       \
-    while(work != NULL) {                                       \
-        if((work->x1 <= X2) && (X1 <= work->x2)) {              \
-            overlap = TRUE;                                     \
-            if(X1 < work->x1) work->x1 = X1;                    \
-            if(X2 > work->x2) {                                 \
-                prev = work;                                    \
-                while((work = work->next) != NULL) {            \
-                    if(work->x1 > X2) break;                    \
-                    if(work->x2 > X2) X2 = work->x2;            \
-                }                                               \
-                prev->x2   = X2;                                \
-                prev->next = work;                              \
-            }                                                   \
-            break;                                              \
-        }                                                       \
-        if(work->x1 > X2) break;                                \
-        prev = work;                                            \
-        work = work->next;                                      \
-    }                                                           \
-    if(!overlap) {                                              \
-        Scp->x1   = X1;                                         \
-        Scp->x2   = X2;                                         \
-        Scp->next = work;                                       \
-        if(prev) prev->next = Scp;                              \
-        else     List       = Scp;                              \
-    }                                                           \
+/* X order of the active edges, same tie rule */
+#define edge_before(a,b) \
+    (((a)->x1 < (b)->x1) || (((a)->x1 == (b)->x1) && ((a) < (b))))
+
+static void fill_segment(scanrow *r)
+{
+        int x1 = r->x1;
+        int x2 = r->x2;
+        clip_ordxrange_(CURC,x1,x2,return,CLIP_EMPTY_MACRO_ARG);
+        (*r->f->scan)(
+            (x1 + CURC->x_offset),
+            (r->y + CURC->y_offset),
+            (x2 - x1 + 1),
+            r->c
+        );
+}
+
+/* segments must come in ascending x1 order, overlapping ones are merged */
+static void add_segment(scanrow *r,int x1,int x2)
+{
+        if(r->valid) {
+            if(x1 <= r->x2 + 1) {
+                if(x2 > r->x2) r->x2 = x2;
+                return;
+            }
+            fill_segment(r);
+        }
+        r->x1    = x1;
+        r->x2    = x2;
+        r->valid = TRUE;
 }
 
 void _GrScanPolygon(int n,GrxPoint *pt,GrFiller *f,GrFillArg c)
 {
-        edge *edges,*ep;
-        scan *scans,*sp,*points,*segments;
+        edge *edges,*ep,**et,**aet;
+        scan *hsegs;
+        scanrow row;
         int  xmin,xmax,ymin,ymax;
-        int  ypos,nedges;
+        int  ypos,nedges,nactive,nhseg,next,i,j,k,pending,px;
         if((n > 1) && (pt[0].x == pt[n-1].x) && (pt[0].y == pt[n-1].y)) {
             n--;
         }
@@ -104,8 +110,10 @@ void _GrScanPolygon(int n,GrxPoint *pt,GrFiller *f,GrFillArg c)
         }
         setup_ALLOC();
         edges = (edge *)ALLOC(sizeof(edge) * (n + 2));
-        scans = (scan *)ALLOC(sizeof(scan) * (n + 8));
-        if(edges && scans) {
+        et    = (edge **)ALLOC(sizeof(edge *) * (n + 2));
+        aet   = (edge **)ALLOC(sizeof(edge *) * (n + 2));
+        hsegs = (scan *)ALLOC(sizeof(scan) * (n + 2));
+        if(edges && et && aet && hsegs) {
             /*
              * Build the edge table. Store only those edges which are in the
              * valid Y region. Clip them in Y if necessary. Store them with
@@ -134,8 +142,7 @@ void _GrScanPolygon(int n,GrxPoint *pt,GrFiller *f,GrFillArg c)
                 if(xmin > ep->e.x)     xmin = ep->e.x;
                 if(xmax < ep->e.xlast) xmax = ep->e.xlast;
                 setup_edge(&ep->e);
-                ep->status = inactive;
-                nedges++;
+                et[nedges++] = ep;
                 ep++;
             }
             if((nedges > 0) && (xmin <= grx_get_clip_box_max_x()) && (xmax >= grx_get_clip_box_min_x())) {
@@ -143,81 +150,94 @@ void _GrScanPolygon(int n,GrxPoint *pt,GrFiller *f,GrFillArg c)
                 if(ymin < grx_get_clip_box_min_y())  ymin = grx_get_clip_box_min_y();
                 if(xmax > grx_get_clip_box_max_x()) xmax = grx_get_clip_box_max_x();
                 if(ymax > grx_get_clip_box_max_y()) ymax = grx_get_clip_box_max_y();
+                qsort(et,nedges,sizeof(edge *),cmp_edge_y);
+                row.f   = f;
+                row.c   = c;
+                nactive = 0;
+                next    = 0;
                 mouse_block(CURC,xmin,ymin,xmax,ymax);
                 /*
                  * Scan for every row between ymin and ymax.
-                 * Build a linked list of disjoint segments to fill. Rules:
+                 * Build the sorted list of disjoint segments to fill. Rules:
                  *   (1) a horizontal edge in the row contributes a segment
-                 *   (2) any other edge crossing the row contributes a point
+                 *   (2) any other edge crossing the row contributes a point,
+                 *       an edge ending in the row contributes two
                  *   (3) every segment between even and odd points is filled
                  */
                 for(ypos = ymin; ypos <= ymax; ypos++) {
-                    sp       = scans;
-                    points   = NULL;
-                    segments = NULL;
-                    for(n = nedges,ep = edges; --n >= 0; ep++) {
-                        switch(ep->status) {
-                          case inactive:
-                            if(ep->e.y != ypos) break;
-                            if(ep->e.dy == 0) {
-                                ep->status = passed;
-                                xmin = ep->e.x;
-                                xmax = ep->e.xlast;
-                                isort(xmin,xmax);
-                                add_scansegment(segments,sp,xmin,xmax);
-                                sp++;
-                                break;
-                            }
-                            ep->status = active;
-                          case active:
-                            xmin = xmax = ep->e.x;
-                            if(ep->e.ylast == ypos) {
-                                ep->status = passed;
-                                xmax = ep->e.xlast;
-                                isort(xmin,xmax);
-                                add_scanpoint(points,sp,xmin,xmax);
-                                sp++;
+                    nhseg = 0;
+                    while((next < nedges) && (et[next]->e.y <= ypos)) {
+                        ep = et[next++];
+                        if(ep->e.dy == 0) {
+                            xmin = ep->e.x;
+                            xmax = ep->e.xlast;
+                            isort(xmin,xmax);
+                            for(j = nhseg++; (j > 0) && (hsegs[j-1].x1 > xmin); j--) {
+                                hsegs[j] = hsegs[j-1];
                             }
-                            else if(ep->e.xmajor) {
-                                xstep_edge(&ep->e);
-                                xmax = ep->e.x - ep->e.xstep;
-                                isort(xmin,xmax);
+                            hsegs[j].x1 = xmin;
+                            hsegs[j].x2 = xmax;
+                            continue;
+                        }
+                        aet[nactive++] = ep;
+                    }
+                    for(i = 0; i < nactive; i++) {
+                        ep = aet[i];
+                        xmin = xmax = ep->e.x;
+                        if(ep->e.ylast == ypos) {
+                            xmax = ep->e.xlast;
+                        }
+                        else if(ep->e.xmajor) {
+                            xstep_edge(&ep->e);
+                            xmax = ep->e.x - ep->e.xstep;
+                        }
+                        else {
+                            ystep_edge(&ep->e);
+                        }
+                        isort(xmin,xmax);
+                        ep->x1 = xmin;
+                        ep->x2 = xmax;
+                        for(j = i; (j > 0) && edge_before(ep,aet[j-1]); j--) {
+                            aet[j] = aet[j-1];
+                        }
+                        aet[j] = ep;
+                    }
+                    row.y     = ypos;
+                    row.valid = FALSE;
+                    pending   = FALSE;
+                    px        = 0;
+                    for(i = j = k = 0; i < nactive; i++) {
+                        int npts;
+                        ep   = aet[i];
+                        npts = (ep->e.ylast == ypos) ? 2 : 1;
+                        while(--npts >= 0) {
+                            if(!pending) {
+                                pending = TRUE;
+                                px = ep->x1;
+                                continue;
                             }
-                            else {
-                                ystep_edge(&ep->e);
+                            pending = FALSE;
+                            while((k < nhseg) && (hsegs[k].x1 <= px)) {
+                                add_segment(&row,hsegs[k].x1,hsegs[k].x2);
+                                k++;
                             }
-                            add_scanpoint(points,sp,xmin,xmax);
-                            sp++;
-                            break;
-                          default:
-                            break;
+                            add_segment(&row,px,ep->x2);
                         }
+                        if(ep->e.ylast != ypos) aet[j++] = ep;
                     }
-                    while(points != NULL) {
-                        scan *nextpt = points->next;
-                        if(!nextpt) break;
-                        xmin   = points->x1;
-                        xmax   = nextpt->x2;
-                        points = nextpt->next;
-                        add_scansegment(segments,nextpt,xmin,xmax);
-                    }
-                    while(segments != NULL) {
-                        xmin     = segments->x1;
-                        xmax     = segments->x2;
-                        segments = segments->next;
-                        clip_ordxrange_(CURC,xmin,xmax,continue,CLIP_EMPTY_MACRO_ARG);
-                        (*f->scan)(
-                            (xmin + CURC->x_offset),
-                            (ypos + CURC->y_offset),
-                            (xmax - xmin + 1),
-                            c
-                        );
+                    nactive = j;
+                    while(k < nhseg) {
+                        add_segment(&row,hsegs[k].x1,hsegs[k].x2);
+                        k++;
                     }
+                    if(row.valid) fill_segment(&row);
                 }
                 mouse_unblock();
             }
         }
         if (edges) FREE(edges);
-        if (scans) FREE(scans);
+        if (et) FREE(et);
+        if (aet) FREE(aet);
+        if (hsegs) FREE(hsegs);
         reset_ALLOC();
 }
@@ -25,47 +25,76 @@
 #include <grx/text.h>
 
 #include <string.h>
+#include "globals.h"
+#include "mouse.h"
 #include "libgrx.h"
+#include "grdriver.h"
+#include "allocate.h"
+#include "clipping.h"
 #include "text.h"
 
-/**
- * grx_draw_text:
- * @text: The text to draw
- * @x: The x coordinate
- * @y: The y coordinate
- * @options: #GrxTextOptions to control how the text is drawn
- *
- * Draws the text at the specified coordinates using @options.
- *
- * The position of the text relative to the coordinates will depend on the
- * alignment given in @options.
- */
-void grx_draw_text(const gchar *text, gint x, gint y, GrxTextOptions *options)
+/* position of one glyph bitmap in a laid out string */
+typedef struct {
+    const GrxGlyph *glyph;  /* pinned until the string is drawn */
+    gint x, y;      /* top left corner relative to the starting pen position */
+} GlyphPos;
+
+/* draws the text with the lock of the font held and its glyphs pinned */
+static void draw_text(const gchar *text, gint x, gint y, GrxTextOptions *options)
 {
-    FT_GlyphSlot slot;
-    GrxContext ctx;
-    GrxFrameMemory mem;
+    const GrxGlyph *glyph;
+    _GR_blendSpan blendspan;
+    GlyphPos *layout;
     gint x_offset, y_offset;
+    gint pen_x, pen_y;
+    gint x1, y1, x2, y2;
+    gint i, n;
     gunichar c;
-    FT_UInt index;
-    FT_Error ret;
 
-    g_return_if_fail(text != NULL);
-    g_return_if_fail(options != NULL);
-    g_return_if_fail(options->font != NULL);
+    // The string is laid out once using the glyph cache of the font. This
+    // gives the width for the alignment and the bounding box of all of the
+    // glyphs, so clipping and mouse blocking only have to be done once for
+    // the whole string instead of once per glyph.
 
-    slot = options->font->face->glyph;
+    // each character takes at least one byte, so this is always big enough
+    layout = _GrTempBufferAlloc(strlen(text) * sizeof(*layout));
+    if (!layout) {
+        return;
+    }
+
+    n = 0;
+    pen_x = pen_y = 0;
+    x1 = y1 = G_MAXINT;
+    x2 = y2 = G_MININT;
+    for (; (c = g_utf8_get_char(text)) != '\0'; text = g_utf8_next_char(text)) {
+        glyph = grx_font_lookup_glyph(options->font, c);
+        if (!glyph) {
+            continue;
+        }
+        if (glyph->bitmap && (glyph->pixel_mode == FT_PIXEL_MODE_MONO ||
+                              glyph->pixel_mode == FT_PIXEL_MODE_GRAY)) {
+            layout[n].glyph = glyph;
+            layout[n].x = pen_x + glyph->left;
+            layout[n].y = pen_y - glyph->top;
+            x1 = MIN(x1, layout[n].x);
+            y1 = MIN(y1, layout[n].y);
+            x2 = MAX(x2, layout[n].x + glyph->width - 1);
+            y2 = MAX(y2, layout[n].y + glyph->rows - 1);
+            n++;
+        }
+        pen_x += glyph->advance_x;
+        pen_y += glyph->advance_y;
+    }
 
-    // FIXME: we are iterating the text multiple times here
     switch (options->h_align) {
     case GRX_TEXT_HALIGN_LEFT:
         x_offset = 0;
         break;
     case GRX_TEXT_HALIGN_CENTER:
-        x_offset = grx_font_get_text_width(options->font, text) / 2;
+        x_offset = pen_x / 2;
         break;
     case GRX_TEXT_HALIGN_RIGHT:
-        x_offset = grx_font_get_text_width(options->font, text);
+        x_offset = pen_x;
         break;
     default:
         g_return_if_reached();
@@ -88,30 +117,122 @@ void grx_draw_text(const gchar *text, gint x, gint y, GrxTextOptions *options)
         g_return_if_reached();
     }
 
-    for (; (c = g_utf8_get_char(text)) != '\0'; text = g_utf8_next_char(text)) {
-        index = FT_Get_Char_Index(options->font->face, c);
-        ret = FT_Load_Glyph(options->font->face, index, FT_LOAD_DEFAULT);
-        if (ret) {
-            continue;
-        }
-        // ret = FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL);
-        // if (ret) {
-        //     continue;
-        // }
-        if (slot->format != FT_GLYPH_FORMAT_BITMAP) {
-            continue;
-        }
-        if (slot->bitmap.pixel_mode != FT_PIXEL_MODE_MONO) {
+    if (n == 0) {
+        return;
+    }
+
+    x -= x_offset;
+    y += y_offset;
+    x1 += x;
+    y1 += y;
+    x2 += x;
+    y2 += y;
+    clip_ordbox(CURC, x1, y1, x2, y2);
+    mouse_block(CURC, x1, y1, x2, y2);
+
+    blendspan = FDRV->blendspan ? FDRV->blendspan : _GrFrDrvGenericBlendSpan;
+
+    // the glyph bitmaps are written straight to the frame
+    for (i = 0; i < n; i++) {
+        gint gx1, gy1;
+
+        glyph = layout[i].glyph;
+        x1 = gx1 = x + layout[i].x;
+        y1 = gy1 = y + layout[i].y;
+        x2 = gx1 + glyph->width - 1;
+        y2 = gy1 + glyph->rows - 1;
+        clip_ordbox_(CURC, x1, y1, x2, y2, continue, CLIP_EMPTY_MACRO_ARG);
+        if (glyph->pixel_mode == FT_PIXEL_MODE_GRAY) {
+            // anti-aliased glyphs are blended into the frame one row at a
+            // time, with the coverage map as the per pixel weight
+            const guint8 *cov = &glyph->bitmap[(y1 - gy1) * glyph->pitch + (x1 - gx1)];
+            gint row;
+
+            if (options->bg_color != GRX_COLOR_NONE) {
+                (*FDRV->drawblock)(
+                    x1 + CURC->x_offset,
+                    y1 + CURC->y_offset,
+                    x2 - x1 + 1,
+                    y2 - y1 + 1,
+                    options->bg_color
+                );
+            }
+            for (row = y1; row <= y2; row++, cov += glyph->pitch) {
+                (*blendspan)(
+                    x1 + CURC->x_offset,
+                    row + CURC->y_offset,
+                    x2 - x1 + 1,
+                    cov,
+                    options->fg_color
+                );
+            }
             continue;
         }
-        mem.plane0 = slot->bitmap.buffer;
-        grx_context_new_full(GRX_FRAME_MODE_RAM_1BPP, slot->bitmap.pitch * 8,
-                             slot->bitmap.rows, &mem, &ctx);
-        grx_bit_blt_1bpp(x + slot->bitmap_left - x_offset,
-                         y - slot->bitmap_top + y_offset,  &ctx, 0, 0,
-                         slot->bitmap.width, slot->bitmap.rows,
-                         options->fg_color, options->bg_color);
-        x += slot->advance.x >> 6;
-        y += slot->advance.y >> 6;
+        (*FDRV->drawbitmap)(
+            x1 + CURC->x_offset,
+            y1 + CURC->y_offset,
+            x2 - x1 + 1,
+            y2 - y1 + 1,
+            glyph->bitmap,
+            glyph->pitch,
+            (x1 - gx1) + ((y1 - gy1) * (glyph->pitch << 3)),
+            options->fg_color,
+            options->bg_color
+        );
     }
+
+    mouse_unblock();
+}
+
+/**
+ * grx_draw_text:
+ * @text: The text to draw
+ * @x: The x coordinate
+ * @y: The y coordinate
+ * @options: #GrxTextOptions to control how the text is drawn
+ *
+ * Draws the text at the specified coordinates using @options.
+ *
+ * The position of the text relative to the coordinates will depend on the
+ * alignment given in @options.
+ */
+void grx_draw_text(const gchar *text, gint x, gint y, GrxTextOptions *options)
+{
+    g_return_if_fail(text != NULL);
+    g_return_if_fail(options != NULL);
+    g_return_if_fail(options->font != NULL);
+
+    g_mutex_lock(&options->font->lock);
+    // the layout keeps pointers to the cached glyphs, so glyphs that are
+    // evicted by a later character of the string must stay around until
+    // they are drawn
+    grx_font_pin_glyphs(options->font);
+    draw_text(text, x, y, options);
+    grx_font_unpin_glyphs(options->font);
+    g_mutex_unlock(&options->font->lock);
+}
+
+/**
+ * grx_context_draw_text:
+ * @context: the context to draw on
+ * @text: The text to draw
+ * @x: The x coordinate
+ * @y: The y coordinate
+ * @options: #GrxTextOptions to control how the text is drawn
+ *
+ * Draws the text on @context. Also see grx_draw_text().
+ *
+ * Unlike grx_draw_text(), this can be called from any thread. Threads drawing
+ * with the same font take turns.
+ */
+void grx_context_draw_text(GrxContext *context, const gchar *text, gint x, gint y,
+                           GrxTextOptions *options)
+{
+    _GR_contextBinding b;
+
+    g_return_if_fail(context != NULL);
+
+    context_bind(&b, context);
+    grx_draw_text(text, x, y, options);
+    context_unbind(&b);
 }
@@ -50,6 +50,7 @@ gint grx_font_dump(GrxFont *font, GrxContext *context, gint start, GrxColor fg,
     GrxContext ctx;
     GrxFrameMemory mem;
     gint i, x, y, x0, y0, x1, y1, height, width, ascender;
+    gint next = -1;
 
     g_return_val_if_fail(font != NULL, 0);
     g_return_val_if_fail(context != NULL, 0);
@@ -58,6 +59,8 @@ gint grx_font_dump(GrxFont *font, GrxContext *context, gint start, GrxColor fg,
     ascender = metrics.ascender >> 6;
 
     grx_context_get_clip_box(context, &x0, &y0, &x1, &y1);
+    // the glyph slot of the face is shared with the glyph cache
+    g_mutex_lock(&font->lock);
     for (i = start, x = 0, y = 0; i < font->face->num_glyphs; i++) {
         height = metrics.height >> 6;
         width = metrics.max_advance >> 6;
@@ -67,7 +70,8 @@ gint grx_font_dump(GrxFont *font, GrxContext *context, gint start, GrxColor fg,
         }
         if (y + height > y1) {
             // we ran out of room
-            return i;
+            next = i;
+            break;
         }
         ret = FT_Load_Glyph(font->face, i, FT_LOAD_DEFAULT);
         if (ret) {
@@ -89,6 +93,7 @@ gint grx_font_dump(GrxFont *font, GrxContext *context, gint start, GrxColor fg,
         x += slot->advance.x >> 6;
         y += slot->advance.y >> 6;
     }
+    g_mutex_unlock(&font->lock);
 
-    return -1;
+    return next;
 }
@@ -0,0 +1,188 @@
+/*
+ * glyphcache.c - per-font cache of rendered glyphs
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <glib.h>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <grx/text.h>
+
+#include <string.h>
+#include "libgrx.h"
+#include "text.h"
+
+/*
+ * Loading a glyph with freetype is expensive (especially on targets without
+ * an FPU) and the same glyphs are drawn and measured over and over again, so
+ * every font keeps a small cache of glyphs. The cache is 2-way set
+ * associative: a code point always goes to the same set, so the size of the
+ * cache is bounded and a lookup is at most two compares, but two code points
+ * that collide (e.g. U+0041 and U+0141 in Latin text) can both stay cached.
+ * The most recently used glyph of a set is kept in the first way and the
+ * other one is evicted on a miss.
+ */
+
+#define GLYPH_WAYS      2
+#define GLYPH_SET(c)    ((c) & (GRX_GLYPH_CACHE_SIZE / GLYPH_WAYS - 1))
+
+static GrxGlyph *load_glyph(GrxFont *font, gunichar c)
+{
+    FT_GlyphSlot slot;
+    GrxGlyph *glyph;
+    FT_UInt index;
+    FT_Error ret;
+    gint pitch, size;
+
+    index = FT_Get_Char_Index(font->face, c);
+    // outline glyphs of scalable fonts are rendered to 8 bit coverage maps
+    ret = FT_Load_Glyph(font->face, index, FT_LOAD_DEFAULT | FT_LOAD_RENDER);
+    if (ret) {
+        // remember the failure so that we don't try again on every call
+        glyph = g_malloc0(sizeof(*glyph));
+        glyph->c = c;
+        glyph->loaded = FALSE;
+        glyph->next = NULL;
+        return glyph;
+    }
+
+    slot = font->face->glyph;
+    size = 0;
+    pitch = 0;
+    if (slot->format == FT_GLYPH_FORMAT_BITMAP) {
+        pitch = ABS(slot->bitmap.pitch);
+        size = pitch * slot->bitmap.rows;
+    }
+
+    // the bitmap is allocated in the same chunk as the glyph
+    glyph = g_malloc(sizeof(*glyph) + size);
+    glyph->c = c;
+    glyph->loaded = TRUE;
+    glyph->pixel_mode = slot->bitmap.pixel_mode;
+    glyph->left = slot->bitmap_left;
+    glyph->top = slot->bitmap_top;
+    glyph->advance_x = slot->advance.x >> 6;
+    glyph->advance_y = slot->advance.y >> 6;
+    glyph->width = slot->bitmap.width;
+    glyph->rows = slot->bitmap.rows;
+    glyph->pitch = pitch;
+    glyph->bitmap = NULL;
+    glyph->next = NULL;
+    if (size) {
+        glyph->bitmap = (guint8 *)(glyph + 1);
+        if (slot->bitmap.pitch < 0) {
+            // flip bottom-up bitmaps so that rows always go down
+            for (gint i = 0; i < glyph->rows; i++) {
+                memcpy(&glyph->bitmap[i * pitch],
+                       &slot->bitmap.buffer[(glyph->rows - 1 - i) * pitch],
+                       pitch);
+            }
+        }
+        else {
+            memcpy(glyph->bitmap, slot->bitmap.buffer, size);
+        }
+    }
+
+    return glyph;
+}
+
+static void evict_glyph(GrxFont *font, GrxGlyph *glyph)
+{
+    if (!glyph) {
+        return;
+    }
+    if (font->pinned) {
+        glyph->next = font->retired;
+        font->retired = glyph;
+        return;
+    }
+    g_free(glyph);
+}
+
+/*
+ * grx_font_lookup_glyph:
+ * @font: the font
+ * @c: the code point
+ *
+ * Gets the glyph for @c, loading it with freetype on a cache miss.
+ *
+ * The caller must hold the lock of @font while it uses the glyph.
+ *
+ * Returns: the glyph or %NULL if freetype could not load it. The glyph is
+ * owned by the font and is only valid until the next lookup, unless the
+ * glyphs of the font are pinned with grx_font_pin_glyphs().
+ */
+const GrxGlyph *grx_font_lookup_glyph(GrxFont *font, gunichar c)
+{
+    GrxGlyph **set = &font->glyphs[GLYPH_SET(c) * GLYPH_WAYS];
+    GrxGlyph *glyph = set[0];
+
+    if (G_UNLIKELY(!glyph || glyph->c != c)) {
+        glyph = set[1];
+        if (!glyph || glyph->c != c) {
+            evict_glyph(font, glyph);
+            glyph = load_glyph(font, c);
+        }
+        set[1] = set[0];
+        set[0] = glyph;
+    }
+
+    return glyph->loaded ? glyph : NULL;
+}
+
+/*
+ * grx_font_pin_glyphs:
+ * @font: the font
+ *
+ * Keeps all of the glyphs returned by grx_font_lookup_glyph() valid until
+ * grx_font_unpin_glyphs() is called, even if they are evicted from the cache
+ * in the meantime. The caller must hold the lock of @font.
+ */
+void grx_font_pin_glyphs(GrxFont *font)
+{
+    font->pinned = TRUE;
+}
+
+/*
+ * grx_font_unpin_glyphs:
+ * @font: the font
+ *
+ * Frees the glyphs that were evicted since grx_font_pin_glyphs().
+ */
+void grx_font_unpin_glyphs(GrxFont *font)
+{
+    font->pinned = FALSE;
+    while (font->retired) {
+        GrxGlyph *glyph = font->retired;
+
+        font->retired = glyph->next;
+        g_free(glyph);
+    }
+}
+
+/*
+ * grx_font_clear_glyph_cache:
+ * @font: the font
+ *
+ * Frees all cached glyphs, e.g. when the font is destroyed.
+ */
+void grx_font_clear_glyph_cache(GrxFont *font)
+{
+    for (gint i = 0; i < GRX_GLYPH_CACHE_SIZE; i++) {
+        g_free(font->glyphs[i]);
+        font->glyphs[i] = NULL;
+    }
+}
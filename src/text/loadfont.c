@@ -22,6 +22,7 @@
 #include FT_FREETYPE_H
 #include FT_TYPES_H
 
+#include <grx/color.h>
 #include <grx/error.h>
 #include <grx/mode.h>
 #include <grx/text.h>
@@ -45,6 +46,44 @@ FT_Library grx_get_global_freetype_library(GError **err)
     return library;
 }
 
+/* point size used for scalable fonts when no size is requested */
+#define DEFAULT_POINT_SIZE 12
+
+static FT_Error set_font_size(FT_Face face, gint size, gint dpi)
+{
+    gint best, i;
+
+    if (dpi < 0) {
+        dpi = grx_get_dpi();
+    }
+
+    if (face->num_fixed_sizes == 0) {
+        // scalable font, glyphs are rendered at exactly the requested size
+        if (size < 0) {
+            size = DEFAULT_POINT_SIZE;
+        }
+        return FT_Set_Char_Size(face, 0, size << 6, dpi, dpi);
+    }
+
+    // bitmap font (or scalable font with embedded bitmaps), pick the strike
+    // that is closest to the requested size
+    best = 0;
+    if (size >= 0) {
+        gint ppem = size * dpi / 72;
+
+        for (i = 1; i < face->num_fixed_sizes; i++) {
+            if (ABS((face->available_sizes[i].y_ppem >> 6) - ppem) <
+                ABS((face->available_sizes[best].y_ppem >> 6) - ppem))
+            {
+                best = i;
+            }
+        }
+    }
+
+    return FT_Set_Pixel_Sizes(face, face->available_sizes[best].x_ppem >> 6,
+        face->available_sizes[best].y_ppem >> 6);
+}
+
 /**
  * grx_font_load_from_file:
  * @filename: (type filename): the file path
@@ -52,10 +91,35 @@ FT_Library grx_get_global_freetype_library(GError **err)
  *
  * Loads a font from a file. Only loads the first font face in the file.
  *
+ * Bitmap fonts are loaded at their first available size and scalable fonts
+ * at the default size. Use grx_font_load_from_file_full() to pick a size.
+ *
  * Returns: (transfer full) (nullable): the font or %NULL if there was an error
  * such as the font was not found.
  */
 GrxFont *grx_font_load_from_file(const gchar *name, GError **err)
+{
+    return grx_font_load_from_file_full(name, -1, -1, err);
+}
+
+/**
+ * grx_font_load_from_file_full:
+ * @filename: (type filename): the file path
+ * @size: the preferred size in points or -1 for the default size
+ * @dpi: the screen resolution or -1 to use grx_get_dpi()
+ * @err: Pointer to hold an error
+ *
+ * Loads a font from a file. Only loads the first font face in the file.
+ *
+ * Scalable fonts (e.g. TrueType) are rendered at exactly @size and are drawn
+ * anti-aliased. For bitmap fonts, the available size that is closest to @size
+ * is used.
+ *
+ * Returns: (transfer full) (nullable): the font or %NULL if there was an error
+ * such as the font was not found.
+ */
+GrxFont *grx_font_load_from_file_full(const gchar *name, gint size, gint dpi,
+                                      GError **err)
 {
     FT_Library library;
     GrxFont *font;
@@ -77,15 +141,7 @@ GrxFont *grx_font_load_from_file(const gchar *name, GError **err)
         g_free(font);
         return NULL;
     }
-    if (font->face->num_fixed_sizes == 0) {
-        g_set_error_literal(err, GRX_ERROR, GRX_ERROR_FONT_ERROR,
-            "Only bitmap fonts are supported");
-        g_free(font);
-        return NULL;
-    }
-    // TODO: are there fonts with more than one available_sizes?
-    ret = FT_Set_Pixel_Sizes(font->face, font->face->available_sizes[0].x_ppem >> 6,
-        font->face->available_sizes[0].y_ppem >> 6);
+    ret = set_font_size(font->face, size, dpi);
     if (ret) {
         g_set_error(err, GRX_ERROR, GRX_ERROR_FONT_ERROR,
             "Error setting size: %s", get_ft_error_msg(ret));
@@ -159,6 +215,8 @@ GrxFont *grx_font_load_from_file(const gchar *name, GError **err)
         font->face->size->metrics.max_advance >> 6,
         font->face->size->metrics.max_advance & 0x3f);
 
+    g_mutex_init(&font->lock);
+
     return grx_font_ref(font);
 }
 
@@ -166,7 +224,7 @@ GrxFont *grx_font_load_from_file(const gchar *name, GError **err)
  * grx_font_load_full:
  * @family: (nullable): the font family name or %NULL
  * @size: the preferred size in points or -1 for any size
- * @dpi: the screen resolution or -1 to ignore dpi
+ * @dpi: the screen resolution or -1 to use grx_get_dpi()
  * @weight: the font weight (e.g. bold) or -1 for any weight
  * @slant: the font slant (e.g. italic) or -1 for any slant
  * @width: the font width (e.g. narrow) or -1 for any width
@@ -177,7 +235,14 @@ GrxFont *grx_font_load_from_file(const gchar *name, GError **err)
  *
  * Loads the font that best matches the parameters.
  *
- * Uses fontconfig for font matching.
+ * Uses fontconfig for font matching. Scalable (outline) fonts are only
+ * considered when the current video mode has more than 256 colors, since
+ * their anti-aliased glyphs need a true color frame to look right; otherwise
+ * bitmap (PCF) fonts are preferred. This is decided by the video mode that is
+ * set when the font is loaded, so fonts loaded before a graphics mode is set
+ * (or in a 256 color mode) keep preferring bitmap fonts after switching to a
+ * true color mode. Load the font again after setting the mode to get a
+ * scalable font.
  *
  * Returns: (transfer full) (nullable): the font or %NULL if there was an error
  */
@@ -200,18 +265,21 @@ GrxFont *grx_font_load_full(const gchar *family, gint size, gint dpi,
     }
 
     pattern = FcPatternCreate();
-    FcPatternAddBool(pattern, FC_SCALABLE, FcFalse);
-    FcPatternAddBool(pattern, FC_OUTLINE, FcFalse);
-    FcPatternAddString(pattern, FC_FONTFORMAT, (FcChar8 *)"PCF");
+    if (grx_color_info_n_colors() <= 256) {
+        FcPatternAddBool(pattern, FC_SCALABLE, FcFalse);
+        FcPatternAddBool(pattern, FC_OUTLINE, FcFalse);
+        FcPatternAddString(pattern, FC_FONTFORMAT, (FcChar8 *)"PCF");
+    }
     if (family) {
         FcPatternAddString(pattern, FC_FAMILY, (FcChar8 *)family);
     }
     if (size >= 0) {
         FcPatternAddDouble(pattern, FC_SIZE, size);
     }
-    if (dpi >= 0) {
-        FcPatternAddDouble(pattern, FC_DPI, dpi);
+    if (dpi < 0) {
+        dpi = grx_get_dpi();
     }
+    FcPatternAddDouble(pattern, FC_DPI, dpi);
     switch (weight) {
     case GRX_FONT_WEIGHT_REGULAR:
         FcPatternAddInteger(pattern, FC_WEIGHT, 80);
@@ -276,7 +344,7 @@ GrxFont *grx_font_load_full(const gchar *family, gint size, gint dpi,
         return NULL;
     }
 
-    font = grx_font_load_from_file((gchar *)file, err);
+    font = grx_font_load_from_file_full((gchar *)file, size, dpi, err);
 
     FcPatternDestroy(match);
     FcPatternDestroy(pattern);
@@ -35,18 +35,17 @@
  */
 gint grx_font_get_char_width(GrxFont *font, gunichar c)
 {
-    FT_UInt index;
-    FT_Error ret;
+    const GrxGlyph *glyph;
+    gint size;
 
     g_return_val_if_fail(font != NULL, 0);
 
-    index = FT_Get_Char_Index(font->face, c);
-    ret = FT_Load_Glyph(font->face, index, FT_LOAD_DEFAULT);
-    if (ret) {
-        return 0;
-    }
+    g_mutex_lock(&font->lock);
+    glyph = grx_font_lookup_glyph(font, c);
+    size = glyph ? glyph->width : 0;
+    g_mutex_unlock(&font->lock);
 
-    return font->face->glyph->bitmap.width;
+    return size;
 }
 
 /**
@@ -60,18 +59,17 @@ gint grx_font_get_char_width(GrxFont *font, gunichar c)
  */
 gint grx_font_get_char_height(GrxFont *font, gunichar c)
 {
-    FT_UInt index;
-    FT_Error ret;
+    const GrxGlyph *glyph;
+    gint size;
 
     g_return_val_if_fail(font != NULL, 0);
 
-    index = FT_Get_Char_Index(font->face, c);
-    ret = FT_Load_Glyph(font->face, index, FT_LOAD_DEFAULT);
-    if (ret) {
-        return 0;
-    }
+    g_mutex_lock(&font->lock);
+    glyph = grx_font_lookup_glyph(font, c);
+    size = glyph ? glyph->rows : 0;
+    g_mutex_unlock(&font->lock);
 
-    return font->face->glyph->bitmap.rows;
+    return size;
 }
 
 /**
@@ -88,8 +86,7 @@ gint grx_font_get_char_height(GrxFont *font, gunichar c)
  */
 gint grx_font_get_text_width(GrxFont *font, const gchar *text)
 {
-    FT_UInt index;
-    FT_Error ret;
+    const GrxGlyph *glyph;
     gunichar c;
     gint width = 0;
 
@@ -103,14 +100,15 @@ gint grx_font_get_text_width(GrxFont *font, const gchar *text)
         return strlen(text) * (font->face->size->metrics.max_advance >> 6);
     }
 
+    g_mutex_lock(&font->lock);
     for (; (c = g_utf8_get_char(text)) != '\0'; text = g_utf8_next_char(text)) {
-        index = FT_Get_Char_Index(font->face, c);
-        ret = FT_Load_Glyph(font->face, index, FT_LOAD_DEFAULT);
-        if (ret) {
+        glyph = grx_font_lookup_glyph(font, c);
+        if (!glyph) {
             continue;
         }
-        width += font->face->glyph->advance.x >> 6;
+        width += glyph->advance_x;
     }
+    g_mutex_unlock(&font->lock);
 
     return width;
 }
@@ -138,18 +136,16 @@ gint grx_font_get_text_height(GrxFont *font, const gchar *text)
     return font->face->size->metrics.height >> 6;
 
 #if 0 // TODO: Handle vertical layout
-    FT_UInt index;
-    FT_Error ret;
+    const GrxGlyph *glyph;
     gunichar c;
     gint height = 0;
 
     for (; (c = g_utf8_get_char(text)) != '\0'; text = g_utf8_next_char(text)) {
-        index = FT_Get_Char_Index(font->face, c);
-        ret = FT_Load_Glyph(font->face, index, FT_LOAD_DEFAULT);
-        if (ret) {
+        glyph = grx_font_lookup_glyph(font, c);
+        if (!glyph) {
             continue;
         }
-        height += slot->advance.y >> 6;
+        height += glyph->advance_y;
     }
 
     return height;
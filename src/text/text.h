@@ -27,9 +27,37 @@
 #include <grx/pixmap.h>
 #include <grx/text.h>
 
+/* number of slots in the per-font glyph cache (must be a power of 2, the
+ * cache is 2-way set associative) */
+#define GRX_GLYPH_CACHE_SIZE 256
+
+/*
+ * A glyph as rendered by freetype. The bitmap is a private copy, so it stays
+ * valid after the face glyph slot is reused for another glyph.
+ */
+typedef struct _GrxGlyph GrxGlyph;
+struct _GrxGlyph {
+    gunichar c;             /* the code point (cache key) */
+    gboolean loaded;        /* FALSE if freetype failed to load the glyph */
+    guint8   pixel_mode;    /* FT_PIXEL_MODE_* of bitmap */
+    gint     left;          /* bitmap left bearing */
+    gint     top;           /* bitmap top bearing (positive is up) */
+    gint     advance_x;     /* pen advance in pixels */
+    gint     advance_y;
+    gint     width;         /* bitmap size in pixels */
+    gint     rows;
+    gint     pitch;         /* bitmap bytes per row */
+    guint8  *bitmap;        /* NULL if format was not FT_GLYPH_FORMAT_BITMAP */
+    GrxGlyph *next;         /* link in the retired list of the font */
+};
+
 struct _GrxFont {
     FT_Face face;
     guint ref_count;
+    GMutex lock;            /* held while the glyph cache is used */
+    GrxGlyph *glyphs[GRX_GLYPH_CACHE_SIZE];  /* 2 ways per set, MRU first */
+    gboolean pinned;        /* evicted glyphs are retired instead of freed */
+    GrxGlyph *retired;      /* evicted while pinned, freed on unpin */
 };
 
 struct _GrxTextOptions {
@@ -48,5 +76,9 @@ typedef void (*TextDrawBitmapFunc)(int x,int y,int w,int h,int ox, int oy,
 G_GNUC_INTERNAL FT_Library grx_get_global_freetype_library(GError **err);
 G_GNUC_INTERNAL FcCharSet *script_to_charset(const gchar *script);
 G_GNUC_INTERNAL const gchar *get_ft_error_msg(gint code);
+G_GNUC_INTERNAL const GrxGlyph *grx_font_lookup_glyph(GrxFont *font, gunichar c);
+G_GNUC_INTERNAL void grx_font_pin_glyphs(GrxFont *font);
+G_GNUC_INTERNAL void grx_font_unpin_glyphs(GrxFont *font);
+G_GNUC_INTERNAL void grx_font_clear_glyph_cache(GrxFont *font);
 
 #endif /* __GRX_TEXT_TEXT_H */
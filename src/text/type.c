@@ -58,8 +58,10 @@ void grx_font_unref(GrxFont *font)
 
     font->ref_count--;
     if (font->ref_count == 0) {
+        grx_font_clear_glyph_cache(font);
         // TODO: check error here?
         FT_Done_Face(font->face);
+        g_mutex_clear(&font->lock);
         g_free(font);
     }
 }
@@ -0,0 +1,105 @@
+/*
+ * rgbconv.c ---- converting rows of 8 bit RGB samples to frame colors
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ */
+
+#include <string.h>
+
+#include "globals.h"
+#include "libgrx.h"
+#include "rgbconv.h"
+
+/* same rounding as grx_color_get() */
+#define ROUNDCOLORCOMP(x,n) (                                   \
+    ((unsigned int)(x) >= CLRINFO->mask[n]) ?                   \
+        CLRINFO->mask[n] :                                      \
+        (((x) + CLRINFO->round[n]) & CLRINFO->mask[n])          \
+)
+
+static const guint gray_weight[3] = { 19595, 38470, 7471 };
+
+/*
+ * Sets up a converter for the current color layout. It is only valid until
+ * the color mode or the palette type changes.
+ */
+_GR_rgbConv *_GrRgbConvNew(void)
+{
+    _GR_rgbConv *cv;
+    guint i, v;
+
+    cv = g_new(_GR_rgbConv, 1);
+    cv->type = CLRINFO->palette_type;
+    cv->gray_shift = 8 - g_bit_nth_lsf(CLRINFO->ncolors, 0);
+    for (v = 0; v < 256; v++) {
+        for (i = 0; i < 3; i++) {
+            guint c = ROUNDCOLORCOMP(v, i);
+            if (cv->type == GRX_COLOR_PALETTE_TYPE_GRAYSCALE) {
+                cv->lut[i][v] = c * gray_weight[i];
+            }
+            else {
+                cv->lut[i][v] = ((GrxColor)c << CLRINFO->shift[i]) >> CLRINFO->norm;
+            }
+        }
+    }
+    memset(cv->key, 0, sizeof(cv->key));
+
+    return cv;
+}
+
+void _GrRgbConvFree(_GR_rgbConv *cv)
+{
+    g_free(cv);
+}
+
+/* color table modes: remembers the result of grx_color_get() */
+GrxColor _GrRgbConvLookup(_GR_rgbConv *cv, guint r, guint g, guint b)
+{
+    guint32 key = 0x1000000 | (r << 16) | (g << 8) | b;
+    guint h = ((key * 0x9E3779B1u) >> 20) & (RGBCONV_CACHE_SIZE - 1);
+
+    if (cv->key[h] != key) {
+        cv->key[h] = key;
+        cv->val[h] = grx_color_get(r, g, b);
+    }
+    return cv->val[h];
+}
+
+/*
+ * Converts w pixels of rgb, which are step bytes apart so that RGBA rows
+ * can be converted without copying, to colors in dst.
+ */
+void _GrRgbConvRow(_GR_rgbConv *cv, const guint8 *rgb, gint step,
+                   gint w, GrxColor *dst)
+{
+    GrxColor *end = dst + w;
+
+    switch (cv->type) {
+    case GRX_COLOR_PALETTE_TYPE_RGB:
+        for ( ; dst < end; dst++, rgb += step) {
+            *dst = cv->lut[0][rgb[0]] | cv->lut[1][rgb[1]] | cv->lut[2][rgb[2]];
+        }
+        break;
+    case GRX_COLOR_PALETTE_TYPE_GRAYSCALE:
+        for ( ; dst < end; dst++, rgb += step) {
+            *dst = ((cv->lut[0][rgb[0]] + cv->lut[1][rgb[1]] +
+                     cv->lut[2][rgb[2]]) >> 16) >> cv->gray_shift;
+        }
+        break;
+    default:
+        for ( ; dst < end; dst++, rgb += step) {
+            *dst = _GrRgbConvLookup(cv, rgb[0], rgb[1], rgb[2]);
+        }
+        break;
+    }
+}
@@ -0,0 +1,210 @@
+/*
+ * spanblnd.c ---- SIMD kernels for compositing premultiplied ARGB rows
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * The blend blits call these for every row. Like the span fills in
+ * spanfill.c the kernel set is chosen on the first call and GRX_NO_SIMD
+ * selects the plain C loops. Groups of pixels that are all transparent are
+ * skipped and groups that are all opaque are copied, which is most of an
+ * icon or an overlay.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "colors.h"
+#include "globals.h"
+#include "libgrx.h"
+#include "blend.h"
+
+/* define NO_SIMD_BLEND to build only the plain C loops */
+#if defined(NO_SIMD_BLEND)
+#elif defined(__x86_64__)
+#define SIMD_BLEND_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define SIMD_BLEND_NEON
+#include <arm_neon.h>
+#endif
+
+/* destinations with the color in the upper 24 bits are rotated to ARGB */
+#define ROT_IN_h(d)     (((d) >> 8) | ((d) << 24))
+#define ROT_OUT_h(d)    (((d) << 8) | ((d) >> 24))
+#define ROT_IN_(d)      (d)
+#define ROT_OUT_(d)     (d)
+
+/* one pixel, also the tail of the SIMD loops */
+#define PIX_BLEND(ROT,dp,sp) do {                                             \
+    GR_int32u _s_ = *(sp), _a_ = _s_ >> 24;                                   \
+    if (_a_ == 0) break;                                                      \
+    if (_a_ != 255) _s_ = blend_over_argb(_s_, ROT_IN##ROT(*(dp)));           \
+    *(dp) = ROT_OUT##ROT(_s_);                                                \
+} while (0)
+
+#define SPAN_BLEND(NAME,ATTR,ROT,VPX,BODY)                                    \
+static ATTR void NAME(void *dp, const void *sp, size_t n)                     \
+{                                                                             \
+    GR_int32u *d = dp;                                                        \
+    const GR_int32u *s = sp;                                                  \
+    size_t i = 0;                                                             \
+                                                                              \
+    for (; i + VPX <= n; i += VPX) {                                          \
+        BODY(ROT, d + i, s + i);                                              \
+    }                                                                         \
+    for (; i < n; i++) {                                                      \
+        PIX_BLEND(ROT, d + i, s + i);                                         \
+    }                                                                         \
+}
+
+/* portable fallback */
+SPAN_BLEND(blend_argb_c,,_,1,PIX_BLEND)
+SPAN_BLEND(blend_argb_h_c,,_h,1,PIX_BLEND)
+
+#if defined(SIMD_BLEND_X86)
+
+/*
+ * The pixels are widened to 16 bit lanes, multiplied by 255 - alpha and
+ * divided by 255 with rounding as (t + (t >> 8)) >> 8 where t = x * y + 128.
+ */
+#define SSE2_ROT_IN_h(v)    _mm_or_si128(_mm_srli_epi32(v,8),_mm_slli_epi32(v,24))
+#define SSE2_ROT_OUT_h(v)   _mm_or_si128(_mm_slli_epi32(v,8),_mm_srli_epi32(v,24))
+#define SSE2_ROT_IN_(v)     (v)
+#define SSE2_ROT_OUT_(v)    (v)
+#define SSE2_MUL255(x,ia) ({                                                  \
+    __m128i _t_ = _mm_add_epi16(_mm_mullo_epi16(x,ia),_mm_set1_epi16(128));   \
+    _mm_srli_epi16(_mm_add_epi16(_t_,_mm_srli_epi16(_t_,8)),8);               \
+})
+#define SSE2_BLEND(ROT,dp,sp) do {                                            \
+    __m128i vs = _mm_loadu_si128((const __m128i *)(sp));                      \
+    __m128i a = _mm_srli_epi32(vs,24);                                        \
+    __m128i z = _mm_setzero_si128();                                          \
+    int m = _mm_movemask_epi8(_mm_cmpeq_epi32(a,z));                          \
+    if (m == 0xffff) break;                                                   \
+    m = _mm_movemask_epi8(_mm_cmpeq_epi32(a,_mm_set1_epi32(255)));            \
+    if (m != 0xffff) {                                                        \
+        __m128i vd  = SSE2_ROT_IN##ROT(_mm_loadu_si128((const __m128i *)(dp))); \
+        __m128i ia = _mm_sub_epi16(_mm_set1_epi16(255),                       \
+                                   _mm_or_si128(a,_mm_slli_epi32(a,16)));     \
+        __m128i lo = SSE2_MUL255(_mm_unpacklo_epi8(vd,z),                     \
+                                 _mm_unpacklo_epi32(ia,ia));                  \
+        __m128i hi = SSE2_MUL255(_mm_unpackhi_epi8(vd,z),                     \
+                                 _mm_unpackhi_epi32(ia,ia));                  \
+        vs = _mm_add_epi8(vs,_mm_packus_epi16(lo,hi));                        \
+    }                                                                         \
+    _mm_storeu_si128((__m128i *)(dp),SSE2_ROT_OUT##ROT(vs));                  \
+} while (0)
+SPAN_BLEND(blend_argb_sse2,,_,4,SSE2_BLEND)
+SPAN_BLEND(blend_argb_h_sse2,,_h,4,SSE2_BLEND)
+
+#define AVX2            __attribute__((target("avx2")))
+#define AVX2_ROT_IN_h(v)    _mm256_or_si256(_mm256_srli_epi32(v,8),_mm256_slli_epi32(v,24))
+#define AVX2_ROT_OUT_h(v)   _mm256_or_si256(_mm256_slli_epi32(v,8),_mm256_srli_epi32(v,24))
+#define AVX2_ROT_IN_(v)     (v)
+#define AVX2_ROT_OUT_(v)    (v)
+#define AVX2_MUL255(x,ia) ({                                                  \
+    __m256i _t_ = _mm256_add_epi16(_mm256_mullo_epi16(x,ia),                  \
+                                   _mm256_set1_epi16(128));                   \
+    _mm256_srli_epi16(_mm256_add_epi16(_t_,_mm256_srli_epi16(_t_,8)),8);      \
+})
+#define AVX2_BLEND(ROT,dp,sp) do {                                            \
+    __m256i vs = _mm256_loadu_si256((const __m256i *)(sp));                   \
+    __m256i a = _mm256_srli_epi32(vs,24);                                     \
+    __m256i z = _mm256_setzero_si256();                                       \
+    int m = _mm256_movemask_epi8(_mm256_cmpeq_epi32(a,z));                    \
+    if (m == -1) break;                                                       \
+    m = _mm256_movemask_epi8(_mm256_cmpeq_epi32(a,_mm256_set1_epi32(255)));   \
+    if (m != -1) {                                                            \
+        __m256i vd  = AVX2_ROT_IN##ROT(                                       \
+                         _mm256_loadu_si256((const __m256i *)(dp)));          \
+        __m256i ia = _mm256_sub_epi16(_mm256_set1_epi16(255),                 \
+                                      _mm256_or_si256(a,_mm256_slli_epi32(a,16))); \
+        __m256i lo = AVX2_MUL255(_mm256_unpacklo_epi8(vd,z),                  \
+                                 _mm256_unpacklo_epi32(ia,ia));               \
+        __m256i hi = AVX2_MUL255(_mm256_unpackhi_epi8(vd,z),                  \
+                                 _mm256_unpackhi_epi32(ia,ia));               \
+        vs = _mm256_add_epi8(vs,_mm256_packus_epi16(lo,hi));                  \
+    }                                                                         \
+    _mm256_storeu_si256((__m256i *)(dp),AVX2_ROT_OUT##ROT(vs));               \
+} while (0)
+SPAN_BLEND(blend_argb_avx2,AVX2,_,8,AVX2_BLEND)
+SPAN_BLEND(blend_argb_h_avx2,AVX2,_h,8,AVX2_BLEND)
+
+#elif defined(SIMD_BLEND_NEON)
+
+/* vraddhn(t, vrshr(t, 8)) is the rounded division of t by 255 */
+#define NEON_ROT_IN_h(v)    vorrq_u32(vshrq_n_u32(v,8),vshlq_n_u32(v,24))
+#define NEON_ROT_OUT_h(v)   vorrq_u32(vshlq_n_u32(v,8),vshrq_n_u32(v,24))
+#define NEON_ROT_IN_(v)     (v)
+#define NEON_ROT_OUT_(v)    (v)
+#define NEON_MUL255(x,ia) ({                                                  \
+    uint16x8_t _t_ = vmull_u8(x,ia);                                          \
+    vraddhn_u16(_t_,vrshrq_n_u16(_t_,8));                                     \
+})
+#define NEON_BLEND(ROT,dp,sp) do {                                            \
+    uint32x4_t vs = vld1q_u32(sp);                                            \
+    uint32x4_t a = vshrq_n_u32(vs,24);                                        \
+    if (vmaxvq_u32(a) == 0) break;                                            \
+    if (vminvq_u32(a) != 255) {                                               \
+        uint8x16_t vd  = vreinterpretq_u8_u32(NEON_ROT_IN##ROT(vld1q_u32(dp))); \
+        uint8x16_t ia = vmvnq_u8(vreinterpretq_u8_u32(vmulq_n_u32(a,0x01010101))); \
+        uint8x8_t lo = NEON_MUL255(vget_low_u8(vd),vget_low_u8(ia));          \
+        uint8x8_t hi = NEON_MUL255(vget_high_u8(vd),vget_high_u8(ia));        \
+        vs = vreinterpretq_u32_u8(vaddq_u8(vreinterpretq_u8_u32(vs),          \
+                                          vcombine_u8(lo,hi)));               \
+    }                                                                         \
+    vst1q_u32(dp,NEON_ROT_OUT##ROT(vs));                                      \
+} while (0)
+SPAN_BLEND(blend_argb_neon,,_,4,NEON_BLEND)
+SPAN_BLEND(blend_argb_h_neon,,_h,4,NEON_BLEND)
+
+#endif
+
+#define SET_BLENDS(ISA) do {                                                  \
+    _GrSpanBlend_argb   = blend_argb_##ISA;                                   \
+    _GrSpanBlend_argb_h = blend_argb_h_##ISA;                                 \
+} while (0)
+
+static void select_blends(void)
+{
+    if (getenv("GRX_NO_SIMD")) {
+        SET_BLENDS(c);
+        return;
+    }
+#if defined(SIMD_BLEND_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        SET_BLENDS(avx2);
+    }
+    else {
+        SET_BLENDS(sse2);
+    }
+#elif defined(SIMD_BLEND_NEON)
+    SET_BLENDS(neon);
+#else
+    SET_BLENDS(c);
+#endif
+}
+
+/* the pointers start out at these, which pick the kernels on first use */
+#define FIRST_BLEND(NAME)                                                     \
+static void first_##NAME(void *d, const void *s, size_t n)                    \
+{                                                                             \
+    select_blends();                                                          \
+    (*_Gr##NAME)(d, s, n);                                                    \
+}
+FIRST_BLEND(SpanBlend_argb)
+FIRST_BLEND(SpanBlend_argb_h)
+
+_GR_spanBlend _GrSpanBlend_argb   = first_SpanBlend_argb;
+_GR_spanBlend _GrSpanBlend_argb_h = first_SpanBlend_argb_h;
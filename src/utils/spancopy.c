@@ -0,0 +1,185 @@
+/*
+ * spancopy.c ---- SIMD kernels for long row copies
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * The fwdcopy_* and revcopy_* macros in memcopy.h call these for rows of
+ * SIMD_COPY_MIN bytes or more. Like the span fills in spanfill.c the kernel
+ * set is chosen on the first call and GRX_NO_SIMD selects the plain 64 bit
+ * word loops.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libgrx.h"
+#include "memcopy.h"
+
+#ifdef SIMD_COPY
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/* byte operations for the unaligned head and the tail of a row */
+#define BOP_set(d,s)    ((d)  = (s))
+#define BOP_xor(d,s)    ((d) ^= (s))
+#define BOP_or(d,s)     ((d) |= (s))
+#define BOP_and(d,s)    ((d) &= (s))
+
+/*
+ * The destination is aligned to VSZ bytes, the source may be misaligned.
+ * Each vector is loaded before it is stored, so copying towards lower
+ * addresses in the forward kernel and towards higher addresses in the
+ * reverse kernel never reads bytes that were already overwritten.
+ */
+#define SPAN_COPY(NAME,ATTR,OP,VSZ,BODY)                                      \
+static ATTR void NAME(void *dp, const void *sp, size_t n)                     \
+{                                                                             \
+    GR_int8u *d = dp;                                                         \
+    const GR_int8u *s = sp;                                                   \
+    size_t i, head = (-(GR_PtrInt)d) & (VSZ - 1);                             \
+                                                                              \
+    if (head > n) head = n;                                                   \
+    for (i = 0; i < head; i++) BOP##OP(d[i], s[i]);                           \
+    for (; i + VSZ <= n; i += VSZ) {                                          \
+        BODY(d + i, s + i);                                                   \
+    }                                                                         \
+    for (; i < n; i++) BOP##OP(d[i], s[i]);                                   \
+}                                                                             \
+static ATTR void NAME##_rev(void *dp, const void *sp, size_t n)               \
+{                                                                             \
+    GR_int8u *d = dp;                                                         \
+    const GR_int8u *s = sp;                                                   \
+    size_t i = n, tail = ((GR_PtrInt)(d + n)) & (VSZ - 1);                    \
+                                                                              \
+    if (tail > n) tail = n;                                                   \
+    while (tail-- > 0) { i--; BOP##OP(d[i], s[i]); }                          \
+    while (i >= VSZ) {                                                        \
+        i -= VSZ;                                                             \
+        BODY(d + i, s + i);                                                   \
+    }                                                                         \
+    while (i-- > 0) BOP##OP(d[i], s[i]);                                      \
+}
+
+/* portable fallback, the source is read bytewise into a word */
+#define W_LOAD(s)       ({ GR_int64u _w_; memcpy(&_w_, (s), 8); _w_; })
+#define W_SET(d,s)      (*(GR_int64u *)(d)  = W_LOAD(s))
+#define W_XOR(d,s)      (*(GR_int64u *)(d) ^= W_LOAD(s))
+#define W_OR(d,s)       (*(GR_int64u *)(d) |= W_LOAD(s))
+#define W_AND(d,s)      (*(GR_int64u *)(d) &= W_LOAD(s))
+SPAN_COPY(copy_set_word,,_set,8,W_SET)
+SPAN_COPY(copy_xor_word,,_xor,8,W_XOR)
+SPAN_COPY(copy_or_word, ,_or, 8,W_OR)
+SPAN_COPY(copy_and_word,,_and,8,W_AND)
+
+#if defined(__x86_64__)
+
+#define SSE2_LD(p)      _mm_load_si128((const __m128i *)(p))
+#define SSE2_LDU(p)     _mm_loadu_si128((const __m128i *)(p))
+#define SSE2_ST(p,v)    _mm_store_si128((__m128i *)(p),(v))
+#define SSE2_SET(d,s)   SSE2_ST(d,SSE2_LDU(s))
+#define SSE2_XOR(d,s)   SSE2_ST(d,_mm_xor_si128(SSE2_LD(d),SSE2_LDU(s)))
+#define SSE2_OR(d,s)    SSE2_ST(d,_mm_or_si128(SSE2_LD(d),SSE2_LDU(s)))
+#define SSE2_AND(d,s)   SSE2_ST(d,_mm_and_si128(SSE2_LD(d),SSE2_LDU(s)))
+SPAN_COPY(copy_set_sse2,,_set,16,SSE2_SET)
+SPAN_COPY(copy_xor_sse2,,_xor,16,SSE2_XOR)
+SPAN_COPY(copy_or_sse2, ,_or, 16,SSE2_OR)
+SPAN_COPY(copy_and_sse2,,_and,16,SSE2_AND)
+
+#define AVX2            __attribute__((target("avx2")))
+#define AVX2_LD(p)      _mm256_load_si256((const __m256i *)(p))
+#define AVX2_LDU(p)     _mm256_loadu_si256((const __m256i *)(p))
+#define AVX2_ST(p,v)    _mm256_store_si256((__m256i *)(p),(v))
+#define AVX2_SET(d,s)   AVX2_ST(d,AVX2_LDU(s))
+#define AVX2_XOR(d,s)   AVX2_ST(d,_mm256_xor_si256(AVX2_LD(d),AVX2_LDU(s)))
+#define AVX2_OR(d,s)    AVX2_ST(d,_mm256_or_si256(AVX2_LD(d),AVX2_LDU(s)))
+#define AVX2_AND(d,s)   AVX2_ST(d,_mm256_and_si256(AVX2_LD(d),AVX2_LDU(s)))
+SPAN_COPY(copy_set_avx2,AVX2,_set,32,AVX2_SET)
+SPAN_COPY(copy_xor_avx2,AVX2,_xor,32,AVX2_XOR)
+SPAN_COPY(copy_or_avx2, AVX2,_or, 32,AVX2_OR)
+SPAN_COPY(copy_and_avx2,AVX2,_and,32,AVX2_AND)
+
+#elif defined(__ARM_NEON)
+
+#define NEON_SET(d,s)   vst1q_u8((d),vld1q_u8(s))
+#define NEON_XOR(d,s)   vst1q_u8((d),veorq_u8(vld1q_u8(d),vld1q_u8(s)))
+#define NEON_OR(d,s)    vst1q_u8((d),vorrq_u8(vld1q_u8(d),vld1q_u8(s)))
+#define NEON_AND(d,s)   vst1q_u8((d),vandq_u8(vld1q_u8(d),vld1q_u8(s)))
+SPAN_COPY(copy_set_neon,,_set,16,NEON_SET)
+SPAN_COPY(copy_xor_neon,,_xor,16,NEON_XOR)
+SPAN_COPY(copy_or_neon, ,_or, 16,NEON_OR)
+SPAN_COPY(copy_and_neon,,_and,16,NEON_AND)
+
+#endif
+
+#define SET_COPIES(ISA) do {                    \
+    _GrSpanCopy_set    = copy_set_##ISA;        \
+    _GrSpanCopy_xor    = copy_xor_##ISA;        \
+    _GrSpanCopy_or     = copy_or_##ISA;         \
+    _GrSpanCopy_and    = copy_and_##ISA;        \
+    _GrSpanRevCopy_set = copy_set_##ISA##_rev;  \
+    _GrSpanRevCopy_xor = copy_xor_##ISA##_rev;  \
+    _GrSpanRevCopy_or  = copy_or_##ISA##_rev;   \
+    _GrSpanRevCopy_and = copy_and_##ISA##_rev;  \
+} while (0)
+
+static void select_copies(void)
+{
+    if (getenv("GRX_NO_SIMD")) {
+        SET_COPIES(word);
+        return;
+    }
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        SET_COPIES(avx2);
+    }
+    else {
+        SET_COPIES(sse2);
+    }
+#elif defined(__ARM_NEON)
+    SET_COPIES(neon);
+#else
+    SET_COPIES(word);
+#endif
+}
+
+/* the pointers start out at these, which pick the kernels on first use */
+#define FIRST_COPY(NAME)                                            \
+static void first_##NAME(void *d, const void *s, size_t n)          \
+{                                                                   \
+    select_copies();                                                \
+    (*_Gr##NAME)(d, s, n);                                          \
+}
+FIRST_COPY(SpanCopy_set)
+FIRST_COPY(SpanCopy_xor)
+FIRST_COPY(SpanCopy_or)
+FIRST_COPY(SpanCopy_and)
+FIRST_COPY(SpanRevCopy_set)
+FIRST_COPY(SpanRevCopy_xor)
+FIRST_COPY(SpanRevCopy_or)
+FIRST_COPY(SpanRevCopy_and)
+
+_GR_spanCopy _GrSpanCopy_set    = first_SpanCopy_set;
+_GR_spanCopy _GrSpanCopy_xor    = first_SpanCopy_xor;
+_GR_spanCopy _GrSpanCopy_or     = first_SpanCopy_or;
+_GR_spanCopy _GrSpanCopy_and    = first_SpanCopy_and;
+_GR_spanCopy _GrSpanRevCopy_set = first_SpanRevCopy_set;
+_GR_spanCopy _GrSpanRevCopy_xor = first_SpanRevCopy_xor;
+_GR_spanCopy _GrSpanRevCopy_or  = first_SpanRevCopy_or;
+_GR_spanCopy _GrSpanRevCopy_and = first_SpanRevCopy_and;
+
+#endif /* SIMD_COPY */
@@ -0,0 +1,155 @@
+/*
+ * spanfill.c ---- SIMD kernels for long row fills
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This file is part of the GRX graphics library.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * The repfill_* macros in memfill.h call these for rows of SIMD_FILL_MIN
+ * bytes or more. The kernel set is chosen on the first call; setting the
+ * GRX_NO_SIMD environment variable selects the plain 64 bit word loops.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libgrx.h"
+#include "memfill.h"
+
+#ifdef SIMD_FILL
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/* byte operations for the unaligned head and the tail of a row */
+#define BOP_n(d,s)      ((d)  = (s))
+#define BOP_xor(d,s)    ((d) ^= (s))
+#define BOP_or(d,s)     ((d) |= (s))
+#define BOP_and(d,s)    ((d) &= (s))
+
+/*
+ * Fills n bytes at p with op. The bulk is done with aligned vectors of VSZ
+ * bytes; the pattern is rotated so that every byte gets the value it would
+ * get from a plain 64 bit fill starting at p.
+ */
+#define SPAN_FILL(NAME,ATTR,OP,VTYPE,VSZ,SPLAT,BODY)                          \
+static ATTR void NAME(void *p, GR_int64u v, size_t n)                         \
+{                                                                             \
+    GR_int8u pat[16], *d = p;                                                 \
+    size_t i, head = (-(GR_PtrInt)d) & (VSZ - 1);                             \
+    GR_int64u r;                                                              \
+    VTYPE vv, *q;                                                             \
+                                                                              \
+    memcpy(pat, &v, 8);                                                       \
+    memcpy(pat + 8, &v, 8);                                                   \
+    if (head > n) head = n;                                                   \
+    for (i = 0; i < head; i++) BOP##OP(d[i], pat[i & 7]);                     \
+    memcpy(&r, &pat[head & 7], 8);                                            \
+    vv = SPLAT(r);                                                            \
+    for (q = (VTYPE *)(d + head); i + VSZ <= n; i += VSZ, q++) {              \
+        BODY;                                                                 \
+    }                                                                         \
+    for (; i < n; i++) BOP##OP(d[i], pat[i & 7]);                             \
+}
+
+/* portable fallback */
+#define W_SPLAT(r)      (r)
+SPAN_FILL(fill_n_word,  ,_n,  GR_int64u,8,W_SPLAT,*q  = vv)
+SPAN_FILL(fill_xor_word,,_xor,GR_int64u,8,W_SPLAT,*q ^= vv)
+SPAN_FILL(fill_or_word, ,_or, GR_int64u,8,W_SPLAT,*q |= vv)
+SPAN_FILL(fill_and_word,,_and,GR_int64u,8,W_SPLAT,*q &= vv)
+
+#if defined(__x86_64__)
+
+#define SSE2_SPLAT(r)   _mm_set1_epi64x((long long)(r))
+SPAN_FILL(fill_n_sse2,  ,_n,  __m128i,16,SSE2_SPLAT,
+          _mm_store_si128(q,vv))
+SPAN_FILL(fill_xor_sse2,,_xor,__m128i,16,SSE2_SPLAT,
+          _mm_store_si128(q,_mm_xor_si128(_mm_load_si128(q),vv)))
+SPAN_FILL(fill_or_sse2, ,_or, __m128i,16,SSE2_SPLAT,
+          _mm_store_si128(q,_mm_or_si128(_mm_load_si128(q),vv)))
+SPAN_FILL(fill_and_sse2,,_and,__m128i,16,SSE2_SPLAT,
+          _mm_store_si128(q,_mm_and_si128(_mm_load_si128(q),vv)))
+
+#define AVX2            __attribute__((target("avx2")))
+#define AVX2_SPLAT(r)   _mm256_set1_epi64x((long long)(r))
+SPAN_FILL(fill_n_avx2,  AVX2,_n,  __m256i,32,AVX2_SPLAT,
+          _mm256_store_si256(q,vv))
+SPAN_FILL(fill_xor_avx2,AVX2,_xor,__m256i,32,AVX2_SPLAT,
+          _mm256_store_si256(q,_mm256_xor_si256(_mm256_load_si256(q),vv)))
+SPAN_FILL(fill_or_avx2, AVX2,_or, __m256i,32,AVX2_SPLAT,
+          _mm256_store_si256(q,_mm256_or_si256(_mm256_load_si256(q),vv)))
+SPAN_FILL(fill_and_avx2,AVX2,_and,__m256i,32,AVX2_SPLAT,
+          _mm256_store_si256(q,_mm256_and_si256(_mm256_load_si256(q),vv)))
+
+#elif defined(__ARM_NEON)
+
+#define NEON_SPLAT(r)   vdupq_n_u64(r)
+SPAN_FILL(fill_n_neon,  ,_n,  uint64x2_t,16,NEON_SPLAT,
+          vst1q_u64((uint64_t *)q,vv))
+SPAN_FILL(fill_xor_neon,,_xor,uint64x2_t,16,NEON_SPLAT,
+          vst1q_u64((uint64_t *)q,veorq_u64(vld1q_u64((uint64_t *)q),vv)))
+SPAN_FILL(fill_or_neon, ,_or, uint64x2_t,16,NEON_SPLAT,
+          vst1q_u64((uint64_t *)q,vorrq_u64(vld1q_u64((uint64_t *)q),vv)))
+SPAN_FILL(fill_and_neon,,_and,uint64x2_t,16,NEON_SPLAT,
+          vst1q_u64((uint64_t *)q,vandq_u64(vld1q_u64((uint64_t *)q),vv)))
+
+#endif
+
+#define SET_FILLS(ISA) do {                 \
+    _GrSpanFill_n   = fill_n_##ISA;         \
+    _GrSpanFill_xor = fill_xor_##ISA;       \
+    _GrSpanFill_or  = fill_or_##ISA;        \
+    _GrSpanFill_and = fill_and_##ISA;       \
+} while (0)
+
+static void select_fills(void)
+{
+    if (getenv("GRX_NO_SIMD")) {
+        SET_FILLS(word);
+        return;
+    }
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        SET_FILLS(avx2);
+    }
+    else {
+        SET_FILLS(sse2);
+    }
+#elif defined(__ARM_NEON)
+    SET_FILLS(neon);
+#else
+    SET_FILLS(word);
+#endif
+}
+
+/* the pointers start out at these, which pick the kernels on first use */
+#define FIRST_FILL(OP)                                          \
+static void first_fill##OP(void *p, GR_int64u v, size_t n)      \
+{                                                               \
+    select_fills();                                             \
+    (*_GrSpanFill##OP)(p, v, n);                                \
+}
+FIRST_FILL(_n)
+FIRST_FILL(_xor)
+FIRST_FILL(_or)
+FIRST_FILL(_and)
+
+_GR_spanFill _GrSpanFill_n   = first_fill_n;
+_GR_spanFill _GrSpanFill_xor = first_fill_xor;
+_GR_spanFill _GrSpanFill_or  = first_fill_or;
+_GR_spanFill _GrSpanFill_and = first_fill_and;
+
+#endif /* SIMD_FILL */
@@ -17,8 +17,11 @@
 #include "libgrx.h"
 #include "allocate.h"
 
-void *_GrTempBuffer = NULL;
-unsigned  _GrTempBufferBytes = 0;
+GR_THREAD_LOCAL void *_GrTempBuffer = NULL;
+GR_THREAD_LOCAL unsigned  _GrTempBufferBytes = 0;
+
+/* frees the buffer of a thread when the thread exits */
+static GPrivate exit_free = G_PRIVATE_INIT(free);
 
 void *_GrTempBufferAlloc_(size_t bytes) {
   GRX_ENTER();
@@ -27,6 +30,7 @@ void *_GrTempBufferAlloc_(size_t bytes) {
     if (neu) {
       _GrTempBuffer = neu;
       _GrTempBufferBytes = bytes;
+      g_private_set(&exit_free, neu);
     }
   }
   GRX_RETURN( (bytes<=_GrTempBufferBytes && _GrTempBuffer)
@@ -37,4 +41,5 @@ void _GrTempBufferFree(void) {
   if (_GrTempBuffer) free(_GrTempBuffer);
   _GrTempBuffer = NULL;
   _GrTempBufferBytes = 0;
+  g_private_set(&exit_free, NULL);
 }
@@ -0,0 +1,572 @@
+/*
+ * grxbench.c ---- headless drawing benchmark for the RAM frame drivers
+ *
+ * Copyright (c) 2026 GRX contributors
+ *
+ * This is a test/demo file of the GRX graphics library.
+ * You can use GRX test/demo files as you want.
+ *
+ * The GRX graphics library is free software; you can redistribute it
+ * and/or modify it under some conditions; see the "copying.grx" file
+ * for details.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Unlike speedtst this does not need a display or a keyboard: it sets modes
+ * on the "memory" video driver and draws into RAM contexts of every frame
+ * mode. Results are written as JSON or CSV so that runs on different hosts
+ * and releases can be compared by scripts.
+ *
+ * Usage: grxbench [--format=json|csv] [--output=FILE] [--size=WxH]
+ *                 [--time=SECONDS] [--modes=LIST] [--tests=LIST]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+#include <grx-3.0.h>
+
+#ifndef BENCH_DATA_DIR
+#define BENCH_DATA_DIR "."
+#endif
+
+#define N_POINTS    4096
+#define N_LINES     256
+#define N_SHAPES    64
+#define N_BLOCKS    16
+#define N_POLY_PTS  6
+#define TEXT_LINE   "The quick brown fox jumps over the lazy dog 0123456789"
+
+typedef struct {
+    const gchar  *name;
+    GrxFrameMode  mode;
+    gint          screen_bpp;   /* bpp of the memory driver mode to set */
+} BenchMode;
+
+static const BenchMode bench_modes[] = {
+    { "1",   GRX_FRAME_MODE_RAM_1BPP,       1  },
+    { "2",   GRX_FRAME_MODE_RAM_2BPP,       2  },
+    { "4",   GRX_FRAME_MODE_RAM_4X1BPP,     4  },
+    { "8",   GRX_FRAME_MODE_RAM_8BPP,       8  },
+    { "16",  GRX_FRAME_MODE_RAM_16BPP,      16 },
+    { "24",  GRX_FRAME_MODE_RAM_24BPP,      24 },
+    { "32L", GRX_FRAME_MODE_RAM_32BPP_LOW,  32 },
+    { "32H", GRX_FRAME_MODE_RAM_32BPP_HIGH, 32 },
+    { "32A", GRX_FRAME_MODE_RAM_32BPP_ARGB, 32 },
+};
+
+typedef struct {
+    GrxContext     *ctx;        /* the context being measured */
+    GrxContext     *src;        /* blit source, same frame mode */
+    GrxPixmap      *src_pixmap; /* stretch source */
+    GrxFont        *font;       /* NULL if no font could be loaded */
+    GrxTextOptions *text;
+    gint            width;
+    gint            height;
+    GrxColor        fg;
+    GrxColor        bg;
+    gint            px[N_POINTS];
+    gint            py[N_POINTS];
+    gchar          *png_file;
+    gchar          *jpeg_file;
+} BenchState;
+
+typedef struct {
+    const gchar *name;
+    const gchar *unit;
+    /* runs one batch, returns the number of units done or -1 to skip */
+    gint64 (*run)(BenchState *st);
+} BenchTest;
+
+typedef struct {
+    const BenchMode *mode;
+    const BenchTest *test;
+    gint64           batches;
+    gint64           units;
+    gint64           usec;
+} BenchResult;
+
+static gint64 run_readpixel(BenchState *st)
+{
+    volatile GrxColor sum = 0;
+    int i;
+
+    for (i = 0; i < N_POINTS; i++) {
+        sum ^= grx_get_pixel_at(st->px[i], st->py[i]);
+    }
+    return N_POINTS;
+}
+
+static gint64 run_drawpixel(BenchState *st)
+{
+    int i;
+
+    for (i = 0; i < N_POINTS; i++) {
+        grx_draw_pixel(st->px[i], st->py[i], (i & 1) ? st->fg : st->bg);
+    }
+    return N_POINTS;
+}
+
+static gint64 run_hline(BenchState *st)
+{
+    gint64 n = 0;
+    int i, x1, x2;
+
+    for (i = 0; i < N_LINES; i++) {
+        x1 = st->px[2 * i];
+        x2 = st->px[2 * i + 1];
+        grx_draw_hline(x1, x2, st->py[i], (i & 1) ? st->fg : st->bg);
+        n += ABS(x2 - x1) + 1;
+    }
+    return n;
+}
+
+static gint64 run_vline(BenchState *st)
+{
+    gint64 n = 0;
+    int i, y1, y2;
+
+    for (i = 0; i < N_LINES; i++) {
+        y1 = st->py[2 * i];
+        y2 = st->py[2 * i + 1];
+        grx_draw_vline(st->px[i], y1, y2, (i & 1) ? st->fg : st->bg);
+        n += ABS(y2 - y1) + 1;
+    }
+    return n;
+}
+
+static gint64 run_line(BenchState *st)
+{
+    int i;
+
+    for (i = 0; i < N_LINES; i++) {
+        grx_draw_line(st->px[2 * i], st->py[2 * i],
+                      st->px[2 * i + 1], st->py[2 * i + 1],
+                      (i & 1) ? st->fg : st->bg);
+    }
+    return N_LINES;
+}
+
+static gint64 run_block(BenchState *st)
+{
+    gint64 n = 0;
+    int i, x1, y1, x2, y2;
+
+    for (i = 0; i < N_BLOCKS; i++) {
+        x1 = MIN(st->px[2 * i], st->px[2 * i + 1]);
+        x2 = MAX(st->px[2 * i], st->px[2 * i + 1]);
+        y1 = MIN(st->py[2 * i], st->py[2 * i + 1]);
+        y2 = MAX(st->py[2 * i], st->py[2 * i + 1]);
+        grx_draw_filled_box(x1, y1, x2, y2, (i & 1) ? st->fg : st->bg);
+        n += (gint64)(x2 - x1 + 1) * (y2 - y1 + 1);
+    }
+    return n;
+}
+
+static gint64 blit(BenchState *st, GrxColor op)
+{
+    gint w = grx_context_get_width(st->src);
+    gint h = grx_context_get_height(st->src);
+    int i;
+
+    for (i = 0; i < N_BLOCKS; i++) {
+        grx_context_bit_blt(st->ctx, st->px[i] % (st->width - w + 1),
+                            st->py[i] % (st->height - h + 1),
+                            st->src, 0, 0, w - 1, h - 1, op);
+    }
+    return (gint64)N_BLOCKS * w * h;
+}
+
+static gint64 run_blit(BenchState *st)
+{
+    return blit(st, GRX_COLOR_MODE_WRITE);
+}
+
+/* only composites in the 32A mode, a plain copy in the others */
+static gint64 run_blend(BenchState *st)
+{
+    return blit(st, GRX_COLOR_MODE_BLEND);
+}
+
+static gint64 run_stretch(BenchState *st)
+{
+    gint w = st->width * 3 / 4;
+    gint h = st->height * 3 / 4;
+    GrxPixmap *p;
+
+    p = grx_pixmap_stretch(st->src_pixmap, w, h);
+    if (!p) {
+        return -1;
+    }
+    grx_draw_pixmap(0, 0, p);
+    grx_pixmap_free(p);
+    return (gint64)w * h;
+}
+
+static gint64 run_polygon(BenchState *st)
+{
+    GrxPoint pts[N_POLY_PTS];
+    int i, j, k = 0;
+
+    for (i = 0; i < N_SHAPES; i++) {
+        for (j = 0; j < N_POLY_PTS; j++, k++) {
+            pts[j].x = st->px[k];
+            pts[j].y = st->py[k];
+        }
+        grx_draw_filled_polygon(N_POLY_PTS, pts, (i & 1) ? st->fg : st->bg);
+    }
+    return N_SHAPES;
+}
+
+static gint64 run_ellipse(BenchState *st)
+{
+    int i;
+
+    for (i = 0; i < N_SHAPES; i++) {
+        grx_draw_filled_ellipse(st->px[i], st->py[i],
+                                st->px[i + N_SHAPES] / 4 + 1,
+                                st->py[i + N_SHAPES] / 4 + 1,
+                                (i & 1) ? st->fg : st->bg);
+    }
+    return N_SHAPES;
+}
+
+static gint64 run_flood(BenchState *st)
+{
+    int i;
+
+    /* a frame with some obstacles, filled from the center */
+    grx_clear_context(st->bg);
+    grx_draw_box(0, 0, st->width - 1, st->height - 1, st->fg);
+    for (i = 0; i < 8; i++) {
+        grx_draw_ellipse(st->px[i], st->py[i], st->width / 16 + 1,
+                         st->height / 16 + 1, st->fg);
+    }
+    grx_draw_pixel(st->width / 2, st->height / 2, st->bg);
+    grx_flood_fill(st->width / 2, st->height / 2, st->fg, st->fg);
+    return 1;
+}
+
+static gint64 run_text(BenchState *st)
+{
+    gint64 n = 0;
+    int i;
+
+    if (!st->font) {
+        return -1;
+    }
+    for (i = 0; i < N_LINES; i++) {
+        grx_draw_text(TEXT_LINE, st->px[i] % (st->width / 2), st->py[i],
+                      st->text);
+        n += strlen(TEXT_LINE);
+    }
+    return n;
+}
+
+static gint64 run_png(BenchState *st)
+{
+    gint w, h;
+
+    if (!grx_query_png_file(st->png_file, &w, &h) ||
+        !grx_context_load_from_png(st->ctx, st->png_file, FALSE, NULL))
+    {
+        return -1;
+    }
+    return (gint64)MIN(w, st->width) * MIN(h, st->height);
+}
+
+static gint64 run_jpeg(BenchState *st)
+{
+    gint w, h;
+
+    if (!grx_query_jpeg_file(st->jpeg_file, &w, &h) ||
+        !grx_context_load_from_jpeg(st->ctx, st->jpeg_file, 1, NULL))
+    {
+        return -1;
+    }
+    return (gint64)MIN(w, st->width) * MIN(h, st->height);
+}
+
+static const BenchTest bench_tests[] = {
+    { "readpixel", "pixels", run_readpixel },
+    { "drawpixel", "pixels", run_drawpixel },
+    { "hline",     "pixels", run_hline     },
+    { "vline",     "pixels", run_vline     },
+    { "line",      "lines",  run_line      },
+    { "block",     "pixels", run_block     },
+    { "blit",      "pixels", run_blit      },
+    { "blend",     "pixels", run_blend     },
+    { "stretch",   "pixels", run_stretch   },
+    { "polygon",   "shapes", run_polygon   },
+    { "ellipse",   "shapes", run_ellipse   },
+    { "flood",     "fills",  run_flood     },
+    { "text",      "glyphs", run_text      },
+    { "png",       "pixels", run_png       },
+    { "jpeg",      "pixels", run_jpeg      },
+};
+
+static gchar   *opt_format = NULL;
+static gchar   *opt_output = NULL;
+static gchar   *opt_size = NULL;
+static gdouble  opt_time = 0.25;
+static gchar   *opt_modes = NULL;
+static gchar   *opt_tests = NULL;
+static gchar   *opt_data_dir = NULL;
+
+static GOptionEntry options[] = {
+    { "format", 'f', 0, G_OPTION_ARG_STRING, &opt_format,
+      "Output format: json (default) or csv", "FORMAT" },
+    { "output", 'o', 0, G_OPTION_ARG_FILENAME, &opt_output,
+      "Write results to FILE instead of stdout", "FILE" },
+    { "size", 's', 0, G_OPTION_ARG_STRING, &opt_size,
+      "Frame size, default 640x480", "WxH" },
+    { "time", 't', 0, G_OPTION_ARG_DOUBLE, &opt_time,
+      "Minimum run time of each test, default 0.25", "SECONDS" },
+    { "modes", 'm', 0, G_OPTION_ARG_STRING, &opt_modes,
+      "Comma separated frame modes (1,2,4,8,16,24,32L,32H,32A), default all",
+      "LIST" },
+    { "tests", 0, 0, G_OPTION_ARG_STRING, &opt_tests,
+      "Comma separated tests, default all", "LIST" },
+    { "data-dir", 'd', 0, G_OPTION_ARG_FILENAME, &opt_data_dir,
+      "Directory with the PNG/JPEG test images", "DIR" },
+    { NULL }
+};
+
+static gboolean in_list(const gchar *list, const gchar *name)
+{
+    gchar **items;
+    gboolean found;
+
+    if (!list) {
+        return TRUE;
+    }
+    items = g_strsplit(list, ",", -1);
+    found = g_strv_contains((const gchar * const *)items, name);
+    g_strfreev(items);
+
+    return found;
+}
+
+static void measure(BenchState *st, const BenchTest *t, BenchResult *r)
+{
+    gint64 start, n;
+
+    r->batches = r->units = r->usec = 0;
+    grx_set_current_context(st->ctx);
+    grx_clear_context(st->bg);
+    start = g_get_monotonic_time();
+    do {
+        n = t->run(st);
+        if (n < 0) {
+            r->batches = 0;
+            return;
+        }
+        r->units += n;
+        r->batches++;
+        r->usec = g_get_monotonic_time() - start;
+    } while (r->usec < (gint64)(opt_time * G_USEC_PER_SEC));
+}
+
+static gboolean run_mode(BenchState *st, const BenchMode *m, GArray *results)
+{
+    GError *error = NULL;
+    BenchResult r;
+    int i;
+
+    if (!grx_set_mode(GRX_GRAPHICS_MODE_GRAPHICS_WIDTH_HEIGHT_BPP, &error,
+                      st->width, st->height, m->screen_bpp))
+    {
+        g_printerr("%s: %s\n", m->name, error->message);
+        g_clear_error(&error);
+        return FALSE;
+    }
+
+    st->ctx = grx_context_new_full(m->mode, st->width, st->height, NULL, NULL);
+    st->src = grx_context_new_full(m->mode, st->width / 2, st->height / 2,
+                                   NULL, NULL);
+    if (!st->ctx || !st->src) {
+        g_printerr("%s: cannot create context\n", m->name);
+        g_clear_pointer(&st->ctx, grx_context_unref);
+        g_clear_pointer(&st->src, grx_context_unref);
+        return FALSE;
+    }
+
+    st->fg = grx_color_get(255, 255, 255);
+    st->bg = grx_color_get(0, 0, 128);
+    if (st->font) {
+        st->text = grx_text_options_new(st->font, st->fg);
+    }
+
+    // something to copy around
+    grx_set_current_context(st->src);
+    grx_clear_context(st->bg);
+    for (i = 0; i < N_SHAPES; i++) {
+        grx_draw_line(0, i * st->height / (2 * N_SHAPES), st->width / 2 - 1,
+                      st->height / 2 - 1, (i & 1) ? st->fg : st->bg);
+    }
+    st->src_pixmap = grx_pixmap_new_from_context(st->src);
+
+    for (i = 0; i < G_N_ELEMENTS(bench_tests); i++) {
+        if (!in_list(opt_tests, bench_tests[i].name)) {
+            continue;
+        }
+        measure(st, &bench_tests[i], &r);
+        if (r.batches == 0) {
+            g_printerr("%s: %s skipped\n", m->name, bench_tests[i].name);
+            continue;
+        }
+        r.mode = m;
+        r.test = &bench_tests[i];
+        g_array_append_val(results, r);
+    }
+
+    if (st->text) {
+        grx_text_options_unref(st->text);
+        st->text = NULL;
+    }
+    grx_pixmap_free(st->src_pixmap);
+    grx_context_unref(st->src);
+    grx_context_unref(st->ctx);
+    st->src_pixmap = NULL;
+    st->src = st->ctx = NULL;
+
+    return TRUE;
+}
+
+static gdouble rate(const BenchResult *r)
+{
+    return r->usec ? (gdouble)r->units * G_USEC_PER_SEC / r->usec : 0.0;
+}
+
+static void write_csv(FILE *f, BenchState *st, GArray *results)
+{
+    int i;
+
+    fprintf(f, "mode,bpp,width,height,test,unit,batches,units,usec,units_per_sec\n");
+    for (i = 0; i < results->len; i++) {
+        BenchResult *r = &g_array_index(results, BenchResult, i);
+        fprintf(f, "%s,%d,%d,%d,%s,%s,%" G_GINT64_FORMAT ",%" G_GINT64_FORMAT
+                ",%" G_GINT64_FORMAT ",%.1f\n",
+                r->mode->name, grx_frame_mode_get_bpp(r->mode->mode),
+                st->width, st->height, r->test->name, r->test->unit,
+                r->batches, r->units, r->usec, rate(r));
+    }
+}
+
+static void write_json(FILE *f, BenchState *st, GArray *results)
+{
+    int i;
+
+    fprintf(f, "{\n  \"width\": %d,\n  \"height\": %d,\n  \"results\": [",
+            st->width, st->height);
+    for (i = 0; i < results->len; i++) {
+        BenchResult *r = &g_array_index(results, BenchResult, i);
+        fprintf(f, "%s\n    { \"mode\": \"%s\", \"bpp\": %d, \"test\": \"%s\", "
+                "\"unit\": \"%s\", \"batches\": %" G_GINT64_FORMAT ", "
+                "\"units\": %" G_GINT64_FORMAT ", \"usec\": %" G_GINT64_FORMAT
+                ", \"units_per_sec\": %.1f }",
+                i ? "," : "", r->mode->name,
+                grx_frame_mode_get_bpp(r->mode->mode), r->test->name,
+                r->test->unit, r->batches, r->units, r->usec, rate(r));
+    }
+    fprintf(f, "\n  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+    GOptionContext *octx;
+    GError *error = NULL;
+    BenchState st = { 0 };
+    GArray *results;
+    GRand *rand;
+    FILE *f = stdout;
+    gboolean csv = FALSE;
+    int i, status = 0;
+
+    octx = g_option_context_new("- GRX drawing benchmark");
+    g_option_context_add_main_entries(octx, options, NULL);
+    if (!g_option_context_parse(octx, &argc, &argv, &error)) {
+        g_printerr("%s\n", error->message);
+        return 2;
+    }
+    g_option_context_free(octx);
+
+    st.width = 640;
+    st.height = 480;
+    if (opt_size && (sscanf(opt_size, "%dx%d", &st.width, &st.height) != 2 ||
+                     st.width < 64 || st.height < 64))
+    {
+        g_printerr("invalid size '%s'\n", opt_size);
+        return 2;
+    }
+    if (opt_format) {
+        if (g_strcmp0(opt_format, "csv") == 0) {
+            csv = TRUE;
+        }
+        else if (g_strcmp0(opt_format, "json") != 0) {
+            g_printerr("unknown format '%s'\n", opt_format);
+            return 2;
+        }
+    }
+
+    if (!grx_set_driver("memory", &error)) {
+        g_printerr("%s\n", error->message);
+        return 1;
+    }
+
+    // same coordinates for every mode so the runs are comparable
+    rand = g_rand_new_with_seed(1);
+    for (i = 0; i < N_POINTS; i++) {
+        st.px[i] = g_rand_int_range(rand, 0, st.width);
+        st.py[i] = g_rand_int_range(rand, 0, st.height);
+    }
+    g_rand_free(rand);
+
+    st.font = grx_font_load(NULL, -1, &error);
+    if (!st.font) {
+        g_printerr("text tests disabled: %s\n", error->message);
+        g_clear_error(&error);
+    }
+
+    st.png_file = g_build_filename(opt_data_dir ? opt_data_dir : BENCH_DATA_DIR,
+                                   "pngowl.png", NULL);
+    st.jpeg_file = g_build_filename(opt_data_dir ? opt_data_dir : BENCH_DATA_DIR,
+                                    "jpeg1.jpg", NULL);
+
+    results = g_array_new(FALSE, FALSE, sizeof(BenchResult));
+    for (i = 0; i < G_N_ELEMENTS(bench_modes); i++) {
+        if (in_list(opt_modes, bench_modes[i].name) &&
+            !run_mode(&st, &bench_modes[i], results))
+        {
+            status = 1;
+        }
+    }
+    grx_set_mode(GRX_GRAPHICS_MODE_TEXT_DEFAULT, NULL);
+
+    if (opt_output && !(f = fopen(opt_output, "w"))) {
+        g_printerr("cannot open '%s'\n", opt_output);
+        return 1;
+    }
+    if (csv) {
+        write_csv(f, &st, results);
+    }
+    else {
+        write_json(f, &st, results);
+    }
+    if (f != stdout) {
+        fclose(f);
+    }
+
+    g_array_free(results, TRUE);
+    g_free(st.png_file);
+    g_free(st.jpeg_file);
+    if (st.font) {
+        grx_font_unref(st.font);
+    }
+
+    return status;
+}
@@ -175,6 +175,7 @@ char *FrameDriverName(GrxFrameMode m) {
     case GRX_FRAME_MODE_RAM_32BPP_LOW: return "RAM32L";
     case GRX_FRAME_MODE_RAM_32BPP_HIGH: return "RAM32H";
     case GRX_FRAME_MODE_RAM_3X8BPP: return "RAM3x8";
+    case GRX_FRAME_MODE_RAM_32BPP_ARGB: return "RAM32A";
     default: return "UNKNOWN";
   }
   return "UNKNOWN";